@@ -1,7 +1,7 @@
-#ifndef APP_H_
-#define APP_H_
-
-/* Function Prototype */
-void appStart(void);
-
+#ifndef APP_H_
+#define APP_H_
+
+/* Function Prototype */
+void appStart(void);
+
 #endif /* APP_H_ */
\ No newline at end of file
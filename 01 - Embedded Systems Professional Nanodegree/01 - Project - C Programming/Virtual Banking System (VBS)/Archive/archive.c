@@ -0,0 +1,808 @@
+/* Standard Library */
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Archive Module */
+#include "archive.h"
+
+/*
+ Name: archiveChecksum
+ Input: Pointer to Bytes, uint32_t Number of bytes
+ Output: uint32_t Checksum
+ Description: Static Function to compute the FNV-1a checksum of the columns of a block, used to find a torn block
+              after a crash.
+*/
+static uint32_t archiveChecksum(uint8_t *bytes, uint32_t size)
+{
+    uint32_t Loc_Checksum = 2166136261U;
+
+    /* Loop: Until all bytes are summed */
+    for (uint32_t Loc_Index = 0; Loc_Index < size; Loc_Index++)
+    {
+        Loc_Checksum = (Loc_Checksum ^ bytes[Loc_Index]) * 16777619U;
+    }
+
+    return Loc_Checksum;
+}
+
+/*
+ Name: archivePutVarint
+ Input: Pointer to Cursor, uint64_t Value
+ Output: Pointer to Cursor after the value
+ Description: Static Function to write a value 7 bits per byte, low bits first, the high bit of a byte is set if
+              another byte follows. Small values take one byte.
+*/
+static uint8_t *archivePutVarint(uint8_t *cursor, uint64_t value)
+{
+    /* Loop: Until the last 7 bits are left */
+    while (value >= 0x80)
+    {
+        *cursor++ = (uint8_t)(value | 0x80);
+        value   >>= 7;
+    }
+
+    *cursor++ = (uint8_t)value;
+
+    return cursor;
+}
+
+/*
+ Name: archiveGetVarint
+ Input: Pointer to Pointer to Cursor
+ Output: uint64_t Value
+ Description: Static Function to read a value written by archivePutVarint and move the cursor after it.
+*/
+static uint64_t archiveGetVarint(uint8_t **cursor)
+{
+    uint64_t Loc_Value = 0;
+    uint32_t Loc_Shift = 0;
+
+    /* Loop: Until the byte without the high bit */
+    while (**cursor & 0x80)
+    {
+        Loc_Value |= (uint64_t)(**cursor & 0x7F) << Loc_Shift;
+        Loc_Shift += 7;
+        (*cursor)++;
+    }
+
+    Loc_Value |= (uint64_t)**cursor << Loc_Shift;
+    (*cursor)++;
+
+    return Loc_Value;
+}
+
+/*
+ Name: archivePutString
+ Input: Pointer to Cursor, Pointer to String, uint32_t Size of the string field
+ Output: Pointer to Cursor after the string
+ Description: Static Function to write the length of a string field up to its terminator, then its characters.
+*/
+static uint8_t *archivePutString(uint8_t *cursor, uint8_t *string, uint32_t size)
+{
+    uint32_t Loc_Length = strnlen(string, size);
+
+    *cursor++ = (uint8_t)Loc_Length;
+    memcpy(cursor, string, Loc_Length);
+
+    return cursor + Loc_Length;
+}
+
+/*
+ Name: archiveGetString
+ Input: Pointer to Pointer to Cursor, Pointer to String, uint32_t Size of the string field
+ Output: void
+ Description: Static Function to read a string written by archivePutString into a zeroed field and move the cursor
+              after it.
+*/
+static void archiveGetString(uint8_t **cursor, uint8_t *string, uint32_t size)
+{
+    uint32_t Loc_Length = **cursor;
+
+    Loc_Length = (Loc_Length < size) ? Loc_Length : size;
+    memset(string, 0, size);
+    memcpy(string, *cursor + 1, Loc_Length);
+    *cursor += 1 + **cursor;
+}
+
+/*
+ Name: archivePutPAN
+ Input: Pointer to Cursor, Pointer to PAN string
+ Output: Pointer to Cursor after the PAN
+ Description: Static Function to write a PAN of 1 to 19 digits as its number of digits with the high bit set, then
+              the digits as one varint number, 8 bytes for 16 digits. Any other PAN is written as a string.
+*/
+static uint8_t *archivePutPAN(uint8_t *cursor, uint8_t *primaryAccountNumber)
+{
+    uint32_t Loc_Length = strnlen(primaryAccountNumber, 20);
+    uint32_t Loc_Digits = 0;
+    uint64_t Loc_Number = 0;
+
+    /* Loop: Until the first character that is not a digit */
+    while (Loc_Digits < Loc_Length && primaryAccountNumber[Loc_Digits] >= '0' && primaryAccountNumber[Loc_Digits] <= '9')
+    {
+        Loc_Number = Loc_Number * 10 + (primaryAccountNumber[Loc_Digits] - '0');
+        Loc_Digits++;
+    }
+
+    /* Check: PAN is all digits and fits in the number, else it is a string */
+    if (Loc_Length != 0 && Loc_Digits == Loc_Length && Loc_Length < 20)
+    {
+        *cursor++ = (uint8_t)(0x80 | Loc_Length);
+        cursor    = archivePutVarint(cursor, Loc_Number);
+    }
+    else
+    {
+        cursor = archivePutString(cursor, primaryAccountNumber, 20);
+    }
+
+    return cursor;
+}
+
+/*
+ Name: archiveGetPAN
+ Input: Pointer to Pointer to Cursor, Pointer to PAN string
+ Output: void
+ Description: Static Function to read a PAN written by archivePutPAN into a zeroed field and move the cursor after it.
+*/
+static void archiveGetPAN(uint8_t **cursor, uint8_t *primaryAccountNumber)
+{
+    uint32_t Loc_Length = **cursor & 0x7F;
+    uint64_t Loc_Number;
+
+    /* Check: PAN is a number of digits, else a string */
+    if (**cursor & 0x80)
+    {
+        (*cursor)++;
+        Loc_Number = archiveGetVarint(cursor);
+        memset(primaryAccountNumber, 0, 20);
+
+        /* Loop: Until every digit is written, last digit first */
+        while (Loc_Length > 0)
+        {
+            Loc_Length--;
+            primaryAccountNumber[Loc_Length] = '0' + (uint8_t)(Loc_Number % 10);
+            Loc_Number /= 10;
+        }
+    }
+    else
+    {
+        archiveGetString(cursor, primaryAccountNumber, 20);
+    }
+}
+
+/*
+ Name: archiveEntryHash
+ Input: Pointer to Transaction structure, EN_archiveColumn_t Dictionary column
+ Output: uint32_t Hash of the dictionary entry of the transaction
+ Description: Static Function to hash the card of a transaction, its PAN, name and expiry date, or its terminal,
+              its terminal id, max amount and date, only the characters up to the terminators count.
+*/
+static uint32_t archiveEntryHash(ST_transaction_t *transData, EN_archiveColumn_t column)
+{
+    uint32_t Loc_Hash;
+
+    /* Check: Card dictionary, else terminal dictionary */
+    if (column == ARCHIVE_CARDS)
+    {
+        Loc_Hash = archiveChecksum(transData->cardHolderData.primaryAccountNumber, strnlen(transData->cardHolderData.primaryAccountNumber, 20)) ^
+                   archiveChecksum(transData->cardHolderData.cardHolderName, strnlen(transData->cardHolderData.cardHolderName, 25)) * 31U ^
+                   archiveChecksum(transData->cardHolderData.cardExpirationDate, strnlen(transData->cardHolderData.cardExpirationDate, 6)) * 961U;
+    }
+    else
+    {
+        Loc_Hash = archiveChecksum((uint8_t *)&transData->terminalData.terminalId, sizeof(uint32_t)) ^
+                   archiveChecksum((uint8_t *)&transData->terminalData.maxTransAmount, sizeof(sint64_t)) * 31U ^
+                   archiveChecksum(transData->terminalData.transactionDate, strnlen(transData->terminalData.transactionDate, 11)) * 961U;
+    }
+
+    return Loc_Hash;
+}
+
+/*
+ Name: archiveSameEntry
+ Input: Pointer to Transaction structure, Pointer to Transaction structure, EN_archiveColumn_t Dictionary column
+ Output: EN_flagState_t Flag Up if both transactions have the same dictionary entry
+ Description: Static Function to compare the cards, or the terminals, of two transactions.
+*/
+static EN_flagState_t archiveSameEntry(ST_transaction_t *first, ST_transaction_t *second, EN_archiveColumn_t column)
+{
+    /* Define local variable to set the flag state, Flag Down */
+    EN_flagState_t Loc_SameFlag = FLAG_DOWN;
+
+    /* Check 1: Same card */
+    if (column == ARCHIVE_CARDS &&
+        strncmp(first->cardHolderData.primaryAccountNumber, second->cardHolderData.primaryAccountNumber, 20) == 0 &&
+        strncmp(first->cardHolderData.cardHolderName, second->cardHolderData.cardHolderName, 25) == 0 &&
+        strncmp(first->cardHolderData.cardExpirationDate, second->cardHolderData.cardExpirationDate, 6) == 0)
+    {
+        Loc_SameFlag = FLAG_UP;
+    }
+    /* Check 2: Same terminal */
+    else if (column == ARCHIVE_TERMINALS && first->terminalData.terminalId == second->terminalData.terminalId &&
+             first->terminalData.maxTransAmount == second->terminalData.maxTransAmount &&
+             strncmp(first->terminalData.transactionDate, second->terminalData.transactionDate, 11) == 0)
+    {
+        Loc_SameFlag = FLAG_UP;
+    }
+
+    return Loc_SameFlag;
+}
+
+/*
+ Name: archivePutEntry
+ Input: Pointer to Cursor, Pointer to Transaction structure, EN_archiveColumn_t Dictionary column
+ Output: Pointer to Cursor after the entry
+ Description: Static Function to write the card, or the terminal, of a transaction as a dictionary entry. PANs are
+              packed, signed amounts are zigzag encoded, so small amounts of either sign take few bytes.
+*/
+static uint8_t *archivePutEntry(uint8_t *cursor, ST_transaction_t *transData, EN_archiveColumn_t column)
+{
+    sint64_t Loc_Amount = transData->terminalData.maxTransAmount;
+
+    /* Check: Card dictionary, else terminal dictionary */
+    if (column == ARCHIVE_CARDS)
+    {
+        cursor = archivePutPAN(cursor, transData->cardHolderData.primaryAccountNumber);
+        cursor = archivePutString(cursor, transData->cardHolderData.cardHolderName, 25);
+        cursor = archivePutString(cursor, transData->cardHolderData.cardExpirationDate, 6);
+    }
+    else
+    {
+        cursor = archivePutVarint(cursor, transData->terminalData.terminalId);
+        cursor = archivePutVarint(cursor, ((uint64_t)Loc_Amount << 1) ^ (uint64_t)(Loc_Amount >> 63));
+        cursor = archivePutString(cursor, transData->terminalData.transactionDate, 11);
+    }
+
+    return cursor;
+}
+
+/*
+ Name: archiveGetEntry
+ Input: Pointer to Pointer to Cursor, Pointer to Transaction structure, EN_archiveColumn_t Dictionary column
+ Output: void
+ Description: Static Function to read a dictionary entry written by archivePutEntry into a transaction and move
+              the cursor after it.
+*/
+static void archiveGetEntry(uint8_t **cursor, ST_transaction_t *transData, EN_archiveColumn_t column)
+{
+    uint64_t Loc_Amount;
+
+    /* Check: Card dictionary, else terminal dictionary */
+    if (column == ARCHIVE_CARDS)
+    {
+        archiveGetPAN(cursor, transData->cardHolderData.primaryAccountNumber);
+        archiveGetString(cursor, transData->cardHolderData.cardHolderName, 25);
+        archiveGetString(cursor, transData->cardHolderData.cardExpirationDate, 6);
+    }
+    else
+    {
+        transData->terminalData.terminalId     = (uint32_t)archiveGetVarint(cursor);
+        Loc_Amount                             = archiveGetVarint(cursor);
+        transData->terminalData.maxTransAmount = (sint64_t)((Loc_Amount >> 1) ^ (0 - (Loc_Amount & 1)));
+        archiveGetString(cursor, transData->terminalData.transactionDate, 11);
+    }
+}
+
+/*
+ Name: archiveEncodeDictionary
+ Input: Pointer to Cursor, Pointer to Transactions, EN_archiveColumn_t Dictionary column, Pointer to uint32_t Codes
+ Output: Pointer to Cursor after the dictionary
+ Description: Static Function to write every distinct card, or terminal, of a block once, in order of first use,
+              and give every transaction the code of its entry. Entries are found in a hash table of twice the
+              block size, holding the position + 1 of the first transaction of every entry.
+*/
+static uint8_t *archiveEncodeDictionary(uint8_t *cursor, ST_transaction_t *transData, EN_archiveColumn_t column, uint32_t *codes)
+{
+    uint32_t Loc_Slots[2 * ARCHIVE_BLOCK_TRANSACTIONS] = {0};
+    uint32_t Loc_Slot, Loc_Count = 0;
+
+    /* Loop: Until every transaction has the code of its entry */
+    for (uint32_t Loc_Index = 0; Loc_Index < ARCHIVE_BLOCK_TRANSACTIONS; Loc_Index++)
+    {
+        Loc_Slot = archiveEntryHash(&transData[Loc_Index], column) & (2 * ARCHIVE_BLOCK_TRANSACTIONS - 1);
+
+        /* Loop: Until a free slot, or the slot of the same entry */
+        while (Loc_Slots[Loc_Slot] != 0 && archiveSameEntry(&transData[Loc_Slots[Loc_Slot] - 1], &transData[Loc_Index], column) == FLAG_DOWN)
+        {
+            Loc_Slot = (Loc_Slot + 1) & (2 * ARCHIVE_BLOCK_TRANSACTIONS - 1);
+        }
+
+        /* Check: New entry */
+        if (Loc_Slots[Loc_Slot] == 0)
+        {
+            Loc_Slots[Loc_Slot] = Loc_Index + 1;
+            codes[Loc_Index]    = Loc_Count++;
+            cursor = archivePutEntry(cursor, &transData[Loc_Index], column);
+        }
+        else
+        {
+            codes[Loc_Index] = codes[Loc_Slots[Loc_Slot] - 1];
+        }
+    }
+
+    return cursor;
+}
+
+/*
+ Name: archiveEncode
+ Input: Pointer to Block, Pointer to Transactions, Pointer to uint32_t Previous sequence numbers, uint32_t First sequence number
+ Output: uint32_t Size of the block
+ Description: Static Function to encode ARCHIVE_BLOCK_TRANSACTIONS transactions column by column after the block
+              header:
+              1. The cards and the terminals of the block, with their dates, are kept once in two dictionaries,
+                 every transaction keeps the varint codes of its entries.
+              2. States are run length encoded, as a varint run length and a state byte.
+              3. Amounts are zigzag varints, request ids are varints.
+              4. The previous transaction of the account is delta encoded, as the varint distance back from the
+                 transaction, 0 if there is none.
+              5. Sequence numbers are consecutive, the block keeps the first one only.
+*/
+static uint32_t archiveEncode(uint8_t *block, ST_transaction_t *transData, uint32_t *previousSequenceNumbers, uint32_t firstSequenceNumber)
+{
+    ST_archiveBlockHeader_t *Loc_Header = (ST_archiveBlockHeader_t *)block;
+    uint8_t *Loc_Columns = block + sizeof(ST_archiveBlockHeader_t);
+    uint8_t *Loc_Cursor  = Loc_Columns;
+    uint32_t Loc_CardCodes[ARCHIVE_BLOCK_TRANSACTIONS], Loc_TerminalCodes[ARCHIVE_BLOCK_TRANSACTIONS];
+    uint32_t Loc_Run = 0, Loc_Sequence;
+    sint64_t Loc_Amount;
+
+    Loc_Header->columns[ARCHIVE_CARDS] = 0;
+    Loc_Cursor = archiveEncodeDictionary(Loc_Cursor, transData, ARCHIVE_CARDS, Loc_CardCodes);
+
+    Loc_Header->columns[ARCHIVE_TERMINALS] = Loc_Cursor - Loc_Columns;
+    Loc_Cursor = archiveEncodeDictionary(Loc_Cursor, transData, ARCHIVE_TERMINALS, Loc_TerminalCodes);
+
+    Loc_Header->columns[ARCHIVE_STATES] = Loc_Cursor - Loc_Columns;
+
+    /* Loop: Until every run of the same state is written */
+    for (uint32_t Loc_Index = 0; Loc_Index < ARCHIVE_BLOCK_TRANSACTIONS; Loc_Index++)
+    {
+        Loc_Run++;
+
+        /* Check: Last transaction of the run */
+        if (Loc_Index == ARCHIVE_BLOCK_TRANSACTIONS - 1 || transData[Loc_Index + 1].transState != transData[Loc_Index].transState)
+        {
+            Loc_Cursor    = archivePutVarint(Loc_Cursor, Loc_Run);
+            *Loc_Cursor++ = (uint8_t)transData[Loc_Index].transState;
+            Loc_Run       = 0;
+        }
+    }
+
+    Loc_Header->columns[ARCHIVE_AMOUNTS] = Loc_Cursor - Loc_Columns;
+
+    /* Loop: Until every amount is written */
+    for (uint32_t Loc_Index = 0; Loc_Index < ARCHIVE_BLOCK_TRANSACTIONS; Loc_Index++)
+    {
+        Loc_Amount = transData[Loc_Index].terminalData.transAmount;
+        Loc_Cursor = archivePutVarint(Loc_Cursor, ((uint64_t)Loc_Amount << 1) ^ (uint64_t)(Loc_Amount >> 63));
+    }
+
+    Loc_Header->columns[ARCHIVE_CARD_CODES] = Loc_Cursor - Loc_Columns;
+
+    /* Loop: Until every card code is written */
+    for (uint32_t Loc_Index = 0; Loc_Index < ARCHIVE_BLOCK_TRANSACTIONS; Loc_Index++)
+    {
+        Loc_Cursor = archivePutVarint(Loc_Cursor, Loc_CardCodes[Loc_Index]);
+    }
+
+    Loc_Header->columns[ARCHIVE_TERMINAL_CODES] = Loc_Cursor - Loc_Columns;
+
+    /* Loop: Until every terminal code is written */
+    for (uint32_t Loc_Index = 0; Loc_Index < ARCHIVE_BLOCK_TRANSACTIONS; Loc_Index++)
+    {
+        Loc_Cursor = archivePutVarint(Loc_Cursor, Loc_TerminalCodes[Loc_Index]);
+    }
+
+    Loc_Header->columns[ARCHIVE_REQUEST_IDS] = Loc_Cursor - Loc_Columns;
+
+    /* Loop: Until every request id is written */
+    for (uint32_t Loc_Index = 0; Loc_Index < ARCHIVE_BLOCK_TRANSACTIONS; Loc_Index++)
+    {
+        Loc_Cursor = archivePutVarint(Loc_Cursor, transData[Loc_Index].terminalData.requestId);
+    }
+
+    Loc_Header->columns[ARCHIVE_PREVIOUS] = Loc_Cursor - Loc_Columns;
+
+    /* Loop: Until every previous transaction is written */
+    for (uint32_t Loc_Index = 0; Loc_Index < ARCHIVE_BLOCK_TRANSACTIONS; Loc_Index++)
+    {
+        Loc_Sequence = firstSequenceNumber + Loc_Index;
+        Loc_Cursor   = archivePutVarint(Loc_Cursor, (previousSequenceNumbers[Loc_Index] == 0) ? 0 : Loc_Sequence - previousSequenceNumbers[Loc_Index]);
+    }
+
+    Loc_Header->firstSequenceNumber = firstSequenceNumber;
+    Loc_Header->count               = ARCHIVE_BLOCK_TRANSACTIONS;
+    Loc_Header->size                = Loc_Cursor - Loc_Columns;
+    Loc_Header->checksum            = archiveChecksum(Loc_Columns, Loc_Header->size);
+
+    return sizeof(ST_archiveBlockHeader_t) + Loc_Header->size;
+}
+
+/*
+ Name: archiveDecode
+ Input: Pointer to Block, uint32_t Position in the block, Pointer to Transaction structure, Pointer to uint32_t Previous sequence number
+ Output: void
+ Description: Static Function to decode one transaction of a block. Every column is walked from its offset up to
+              the position, no other transaction is copied out.
+*/
+static void archiveDecode(uint8_t *block, uint32_t position, ST_transaction_t *transData, uint32_t *previousSequenceNumber)
+{
+    ST_archiveBlockHeader_t *Loc_Header = (ST_archiveBlockHeader_t *)block;
+    uint8_t *Loc_Columns = block + sizeof(ST_archiveBlockHeader_t);
+    uint8_t *Loc_Cursor;
+    uint32_t Loc_Code, Loc_Run = 0, Loc_Distance = 0;
+    uint64_t Loc_Amount = 0;
+    ST_transaction_t Loc_Skipped;
+
+    memset(transData, 0, sizeof(ST_transaction_t));
+    transData->transactionSequenceNumber = Loc_Header->firstSequenceNumber + position;
+
+    /* Card of the transaction, earlier entries are skipped */
+    Loc_Cursor = Loc_Columns + Loc_Header->columns[ARCHIVE_CARD_CODES];
+    for (uint32_t Loc_Index = 0; Loc_Index < position; Loc_Index++)
+    {
+        archiveGetVarint(&Loc_Cursor);
+    }
+    Loc_Code   = (uint32_t)archiveGetVarint(&Loc_Cursor);
+    Loc_Cursor = Loc_Columns + Loc_Header->columns[ARCHIVE_CARDS];
+    for (uint32_t Loc_Index = 0; Loc_Index < Loc_Code; Loc_Index++)
+    {
+        archiveGetEntry(&Loc_Cursor, &Loc_Skipped, ARCHIVE_CARDS);
+    }
+    archiveGetEntry(&Loc_Cursor, transData, ARCHIVE_CARDS);
+
+    /* Terminal of the transaction, earlier entries are skipped */
+    Loc_Cursor = Loc_Columns + Loc_Header->columns[ARCHIVE_TERMINAL_CODES];
+    for (uint32_t Loc_Index = 0; Loc_Index < position; Loc_Index++)
+    {
+        archiveGetVarint(&Loc_Cursor);
+    }
+    Loc_Code   = (uint32_t)archiveGetVarint(&Loc_Cursor);
+    Loc_Cursor = Loc_Columns + Loc_Header->columns[ARCHIVE_TERMINALS];
+    for (uint32_t Loc_Index = 0; Loc_Index < Loc_Code; Loc_Index++)
+    {
+        archiveGetEntry(&Loc_Cursor, &Loc_Skipped, ARCHIVE_TERMINALS);
+    }
+    archiveGetEntry(&Loc_Cursor, transData, ARCHIVE_TERMINALS);
+
+    /* State of the run holding the position */
+    Loc_Cursor = Loc_Columns + Loc_Header->columns[ARCHIVE_STATES];
+    while (Loc_Run <= position)
+    {
+        Loc_Run              += (uint32_t)archiveGetVarint(&Loc_Cursor);
+        transData->transState = (EN_transState_t)*Loc_Cursor++;
+    }
+
+    /* Amount, request id and previous transaction at the position */
+    Loc_Cursor = Loc_Columns + Loc_Header->columns[ARCHIVE_AMOUNTS];
+    for (uint32_t Loc_Index = 0; Loc_Index <= position; Loc_Index++)
+    {
+        Loc_Amount = archiveGetVarint(&Loc_Cursor);
+    }
+    transData->terminalData.transAmount = (sint64_t)((Loc_Amount >> 1) ^ (0 - (Loc_Amount & 1)));
+
+    Loc_Cursor = Loc_Columns + Loc_Header->columns[ARCHIVE_REQUEST_IDS];
+    for (uint32_t Loc_Index = 0; Loc_Index <= position; Loc_Index++)
+    {
+        transData->terminalData.requestId = (uint32_t)archiveGetVarint(&Loc_Cursor);
+    }
+
+    Loc_Cursor = Loc_Columns + Loc_Header->columns[ARCHIVE_PREVIOUS];
+    for (uint32_t Loc_Index = 0; Loc_Index <= position; Loc_Index++)
+    {
+        Loc_Distance = (uint32_t)archiveGetVarint(&Loc_Cursor);
+    }
+    *previousSequenceNumber = (Loc_Distance == 0) ? 0 : transData->transactionSequenceNumber - Loc_Distance;
+}
+
+/*
+ Name: archiveReadBlock
+ Input: Pointer to Archive structure, uint64_t File offset, uint64_t Size, uint32_t First sequence number,
+        EN_flagState_t Checksum flag
+ Output: Pointer to Block, or NULL
+ Description: Static Function to read a block into a new buffer, the caller frees it. Only the last block may be
+              torn by a crash, archiveOpen checks its checksum, lookups don't sum the blocks they read.
+              If the block can't be read, is not the block of the first sequence number, or its checksum is wrong
+              will return NULL.
+*/
+static uint8_t *archiveReadBlock(ST_archive_t *archive, uint64_t offset, uint64_t size, uint32_t firstSequenceNumber,
+                                 EN_flagState_t checksumFlag)
+{
+    uint8_t *Loc_Block = (size >= sizeof(ST_archiveBlockHeader_t)) ? malloc(size) : NULL;
+    ST_archiveBlockHeader_t *Loc_Header = (ST_archiveBlockHeader_t *)Loc_Block;
+
+    /* Check: Block can't be read, or is damaged */
+    if (Loc_Block != NULL &&
+        (pread(archive->fileDescriptor, Loc_Block, size, offset) != (sint64_t)size ||
+         Loc_Header->firstSequenceNumber != firstSequenceNumber || Loc_Header->count != ARCHIVE_BLOCK_TRANSACTIONS ||
+         sizeof(ST_archiveBlockHeader_t) + Loc_Header->size != size ||
+         (checksumFlag == FLAG_UP && Loc_Header->checksum != archiveChecksum(Loc_Block + sizeof(ST_archiveBlockHeader_t), Loc_Header->size))))
+    {
+        free(Loc_Block);
+        Loc_Block = NULL;
+    }
+
+    return Loc_Block;
+}
+
+/*
+ Name: archiveGrowIndex
+ Input: Pointer to Archive structure
+ Output: EN_archiveError_t Error or No Error
+ Description: Static Function to make room in the index for one more block, doubling it when full, ARCHIVE_MIN_INDEX
+              for a new one.
+*/
+static EN_archiveError_t archiveGrowIndex(ST_archive_t *archive)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_archiveError_t Loc_ErrorState = ARCHIVE_OK;
+    uint32_t Loc_Capacity = (archive->capacity == 0) ? ARCHIVE_MIN_INDEX : archive->capacity * 2;
+    uint64_t *Loc_Offsets;
+
+    /* Check: Index is full, the end offset of a new block needs one more entry */
+    if (archive->blockCount + 2 > archive->capacity)
+    {
+        Loc_Offsets = realloc(archive->offsets, Loc_Capacity * sizeof(uint64_t));
+
+        /* Check 1: No memory, the old index is kept */
+        if (Loc_Offsets == NULL)
+        {
+            /* Update error state, Write Failed! */
+            Loc_ErrorState = ARCHIVE_WRITE_FAILED;
+        }
+        /* Check 2: Index is grown */
+        else
+        {
+            archive->offsets  = Loc_Offsets;
+            archive->capacity = Loc_Capacity;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: archiveOpen
+ Input: Pointer to Archive structure, Pointer to file path, uint32_t First sequence number of a new archive
+ Output: EN_archiveError_t Error or No Error
+ Description: 1. This function opens the archive file, or creates it with the given first sequence number.
+              2. The index is rebuilt from the block headers only, the columns of a block are not read, except for
+                 the last block, which is cut off with anything after it if it is torn.
+              3. If the file can't be opened will return ARCHIVE_OPEN_FAILED, if it is not an archive of this build
+                 will return ARCHIVE_BAD_FORMAT, else return ARCHIVE_OK.
+*/
+EN_archiveError_t archiveOpen(ST_archive_t *archive, uint8_t *path, uint32_t firstSequenceNumber)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_archiveError_t Loc_ErrorState = ARCHIVE_OK;
+    ST_archiveHeader_t Loc_Header = {ARCHIVE_MAGIC};
+    ST_archiveBlockHeader_t Loc_BlockHeader;
+    struct stat Loc_Status;
+    uint64_t Loc_Offset = sizeof(ST_archiveHeader_t);
+    uint8_t *Loc_Block = NULL;
+
+    Loc_Header.version             = ARCHIVE_VERSION;
+    Loc_Header.firstSequenceNumber = firstSequenceNumber;
+
+    archive->offsets    = NULL;
+    archive->blockCount = 0;
+    archive->capacity   = 0;
+    archive->fileDescriptor = open(path, O_RDWR | O_CREAT, 0644);
+
+    /* Check 1: File can't be opened, or no memory for the index */
+    if (archive->fileDescriptor < 0 || fstat(archive->fileDescriptor, &Loc_Status) != 0 || archiveGrowIndex(archive) != ARCHIVE_OK)
+    {
+        /* Update error state, Open Failed! */
+        Loc_ErrorState = ARCHIVE_OPEN_FAILED;
+    }
+    /* Check 2: File is new, write header */
+    else if (Loc_Status.st_size == 0)
+    {
+        /* Check 2.1: Header can't be written */
+        if (pwrite(archive->fileDescriptor, &Loc_Header, sizeof(Loc_Header), 0) != sizeof(Loc_Header) || fdatasync(archive->fileDescriptor) != 0)
+        {
+            /* Update error state, Open Failed! */
+            Loc_ErrorState = ARCHIVE_OPEN_FAILED;
+        }
+    }
+    /* Check 3: File exists, check header */
+    else if (pread(archive->fileDescriptor, &Loc_Header, sizeof(Loc_Header), 0) != sizeof(Loc_Header) ||
+             memcmp(Loc_Header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0 || Loc_Header.version != ARCHIVE_VERSION)
+    {
+        /* Update error state, Bad Format! */
+        Loc_ErrorState = ARCHIVE_BAD_FORMAT;
+    }
+    /* Check 4: Archive is valid, index its blocks */
+    else
+    {
+        /* Loop: Until the end of the file, or a block header that doesn't follow the previous block */
+        while (Loc_ErrorState == ARCHIVE_OK && Loc_Offset + sizeof(Loc_BlockHeader) <= (uint64_t)Loc_Status.st_size &&
+               pread(archive->fileDescriptor, &Loc_BlockHeader, sizeof(Loc_BlockHeader), Loc_Offset) == sizeof(Loc_BlockHeader) &&
+               Loc_BlockHeader.firstSequenceNumber == Loc_Header.firstSequenceNumber + archive->blockCount * ARCHIVE_BLOCK_TRANSACTIONS &&
+               Loc_BlockHeader.count == ARCHIVE_BLOCK_TRANSACTIONS &&
+               Loc_Offset + sizeof(Loc_BlockHeader) + Loc_BlockHeader.size <= (uint64_t)Loc_Status.st_size)
+        {
+            Loc_ErrorState = archiveGrowIndex(archive);
+
+            /* Check: Index has room for the block */
+            if (Loc_ErrorState == ARCHIVE_OK)
+            {
+                archive->offsets[archive->blockCount] = Loc_Offset;
+                archive->blockCount++;
+                Loc_Offset += sizeof(Loc_BlockHeader) + Loc_BlockHeader.size;
+            }
+        }
+
+        /* Check 4.1: Last block is torn */
+        if (archive->blockCount != 0 &&
+            (Loc_Block = archiveReadBlock(archive, archive->offsets[archive->blockCount - 1], Loc_Offset - archive->offsets[archive->blockCount - 1],
+                                          Loc_Header.firstSequenceNumber + (archive->blockCount - 1) * ARCHIVE_BLOCK_TRANSACTIONS, FLAG_UP)) == NULL)
+        {
+            archive->blockCount--;
+            Loc_Offset = archive->offsets[archive->blockCount];
+        }
+        else
+        {
+            free(Loc_Block);
+        }
+
+        /* Check 4.2: Index can't be kept */
+        if (Loc_ErrorState != ARCHIVE_OK)
+        {
+            /* Update error state, Open Failed! */
+            Loc_ErrorState = ARCHIVE_OPEN_FAILED;
+        }
+
+        ftruncate(archive->fileDescriptor, Loc_Offset);
+    }
+
+    /* Check 5: Archive is open */
+    if (Loc_ErrorState == ARCHIVE_OK)
+    {
+        archive->offsets[archive->blockCount] = Loc_Offset;
+        archive->firstSequenceNumber = Loc_Header.firstSequenceNumber;
+        archive->nextSequenceNumber  = Loc_Header.firstSequenceNumber + archive->blockCount * ARCHIVE_BLOCK_TRANSACTIONS;
+
+        pthread_mutex_init(&archive->lock, NULL);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: archiveAppend
+ Input: Pointer to Archive structure, Pointer to Transactions, Pointer to uint32_t Previous sequence numbers
+ Output: EN_archiveError_t Error or No Error
+ Description: 1. This function encodes ARCHIVE_BLOCK_TRANSACTIONS transactions as the next block of the archive, see
+                 archiveEncode. They are the next sequence numbers of the archive, in order, with the previous
+                 transaction of the same account of each.
+              2. The block is synced before it is added to the index, so a transaction found in the archive is
+                 durable in it and may be dropped from the log.
+              3. Only one thread may append, lookups go on while it does.
+              4. If there is no memory or the block can't be written will return ARCHIVE_WRITE_FAILED and the block
+                 is not added, else return ARCHIVE_OK.
+*/
+EN_archiveError_t archiveAppend(ST_archive_t *archive, ST_transaction_t *transData, uint32_t *previousSequenceNumbers)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_archiveError_t Loc_ErrorState = ARCHIVE_OK;
+    uint8_t *Loc_Block = malloc(sizeof(ST_archiveBlockHeader_t) + ARCHIVE_BLOCK_TRANSACTIONS * ARCHIVE_MAX_TRANSACTION_BYTES);
+    uint64_t Loc_Offset = archive->offsets[archive->blockCount];
+    uint32_t Loc_Size = 0;
+
+    /* Check 1: No memory for the block */
+    if (Loc_Block == NULL)
+    {
+        /* Update error state, Write Failed! */
+        Loc_ErrorState = ARCHIVE_WRITE_FAILED;
+    }
+    /* Check 2: Block can't be written and synced */
+    else if ((Loc_Size = archiveEncode(Loc_Block, transData, previousSequenceNumbers, archive->nextSequenceNumber),
+              pwrite(archive->fileDescriptor, Loc_Block, Loc_Size, Loc_Offset)) != (sint64_t)Loc_Size ||
+             fdatasync(archive->fileDescriptor) != 0)
+    {
+        /* Update error state, Write Failed! */
+        Loc_ErrorState = ARCHIVE_WRITE_FAILED;
+    }
+    /* Check 3: Block is durable, add it to the index */
+    else
+    {
+        pthread_mutex_lock(&archive->lock);
+
+        /* Check 3.1: Index can't grow */
+        if (archiveGrowIndex(archive) != ARCHIVE_OK)
+        {
+            /* Update error state, Write Failed! */
+            Loc_ErrorState = ARCHIVE_WRITE_FAILED;
+        }
+        else
+        {
+            archive->blockCount++;
+            archive->offsets[archive->blockCount] = Loc_Offset + Loc_Size;
+            archive->nextSequenceNumber += ARCHIVE_BLOCK_TRANSACTIONS;
+        }
+
+        pthread_mutex_unlock(&archive->lock);
+    }
+
+    free(Loc_Block);
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: archiveGet
+ Input: Pointer to Archive structure, uint32_t Transaction sequence number, Pointer to Transaction structure,
+        Pointer to uint32_t Previous sequence number
+ Output: EN_archiveError_t Error or No Error
+ Description: 1. This function finds an archived transaction by its sequence number.
+              2. Every block holds ARCHIVE_BLOCK_TRANSACTIONS consecutive sequence numbers, so the block is computed
+                 and its file offset taken from the index, only that block is read and only the transaction is
+                 decoded.
+              3. If the transaction is not archived or its block can't be read will return ARCHIVE_NOT_FOUND, else
+                 return ARCHIVE_OK, the transaction and the previous transaction of its account, 0 if there is none.
+*/
+EN_archiveError_t archiveGet(ST_archive_t *archive, uint32_t transactionSequenceNumber, ST_transaction_t *transData,
+                             uint32_t *previousSequenceNumber)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_archiveError_t Loc_ErrorState = ARCHIVE_OK;
+    uint32_t Loc_Block = (transactionSequenceNumber - archive->firstSequenceNumber) / ARCHIVE_BLOCK_TRANSACTIONS;
+    uint64_t Loc_Offset = 0, Loc_End = 0;
+    uint8_t *Loc_Bytes = NULL;
+
+    pthread_mutex_lock(&archive->lock);
+
+    /* Check: Transaction is archived */
+    if (transactionSequenceNumber >= archive->firstSequenceNumber && transactionSequenceNumber < archive->nextSequenceNumber)
+    {
+        Loc_Offset = archive->offsets[Loc_Block];
+        Loc_End    = archive->offsets[Loc_Block + 1];
+    }
+
+    pthread_mutex_unlock(&archive->lock);
+
+    /* Check 1: Transaction not archived, or block damaged */
+    if (Loc_End == 0 ||
+        (Loc_Bytes = archiveReadBlock(archive, Loc_Offset, Loc_End - Loc_Offset, archive->firstSequenceNumber + Loc_Block * ARCHIVE_BLOCK_TRANSACTIONS, FLAG_DOWN)) == NULL)
+    {
+        /* Update error state, Not Found! */
+        Loc_ErrorState = ARCHIVE_NOT_FOUND;
+    }
+    /* Check 2: Block is read */
+    else
+    {
+        archiveDecode(Loc_Bytes, (transactionSequenceNumber - archive->firstSequenceNumber) % ARCHIVE_BLOCK_TRANSACTIONS,
+                      transData, previousSequenceNumber);
+    }
+
+    free(Loc_Bytes);
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: archiveClose
+ Input: Pointer to Archive structure
+ Output: void
+ Description: This function closes the archive file and releases its index.
+*/
+void archiveClose(ST_archive_t *archive)
+{
+    close(archive->fileDescriptor);
+    free(archive->offsets);
+
+    archive->offsets    = NULL;
+    archive->blockCount = 0;
+
+    pthread_mutex_destroy(&archive->lock);
+}
\ No newline at end of file
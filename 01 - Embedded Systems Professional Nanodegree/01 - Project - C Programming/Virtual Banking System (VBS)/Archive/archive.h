@@ -0,0 +1,62 @@
+#ifndef ARCHIVE_H_
+#define ARCHIVE_H_
+
+/* Standard Library */
+#include <pthread.h>
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define ARCHIVE_MAGIC					"VBSARCH"
+#define ARCHIVE_VERSION					1
+#define ARCHIVE_BLOCK_TRANSACTIONS		1024		/* Consecutive transactions of a block, every block is full */
+#define ARCHIVE_BLOCKS_PER_PASS			16			/* Blocks archived by one compactor pass at most */
+#define ARCHIVE_MAX_TRANSACTION_BYTES	128			/* Bytes a transaction takes in all columns at most */
+#define ARCHIVE_MIN_INDEX				64			/* Block offsets of the index at first, doubled when full */
+
+typedef enum EN_archiveColumn_t
+{
+	ARCHIVE_CARDS, ARCHIVE_TERMINALS, ARCHIVE_STATES, ARCHIVE_AMOUNTS, ARCHIVE_CARD_CODES, ARCHIVE_TERMINAL_CODES,
+	ARCHIVE_REQUEST_IDS, ARCHIVE_PREVIOUS, ARCHIVE_COLUMNS
+}EN_archiveColumn_t;
+
+typedef struct ST_archiveHeader_t
+{
+	uint8_t magic[8];
+	uint32_t version;
+	uint32_t firstSequenceNumber;
+}ST_archiveHeader_t;
+
+typedef struct ST_archiveBlockHeader_t
+{
+	uint32_t firstSequenceNumber;
+	uint32_t count;
+	uint32_t size;							/* Bytes of the columns after the block header */
+	uint32_t checksum;						/* FNV-1a of the columns */
+	uint32_t columns[ARCHIVE_COLUMNS];		/* Offset of every column after the block header */
+}ST_archiveBlockHeader_t;
+
+typedef struct ST_archive_t
+{
+	sint32_t fileDescriptor;
+	pthread_mutex_t lock;					/* Guards the index, a block is added while lookups read it */
+	uint64_t *offsets;						/* Index, file offset of every block, then the end of the last one */
+	uint32_t blockCount;
+	uint32_t capacity;
+	uint32_t firstSequenceNumber;
+	uint32_t nextSequenceNumber;			/* First sequence number not archived yet */
+}ST_archive_t;
+
+typedef enum EN_archiveError_t
+{
+	ARCHIVE_OK, ARCHIVE_OPEN_FAILED, ARCHIVE_BAD_FORMAT, ARCHIVE_WRITE_FAILED, ARCHIVE_NOT_FOUND
+}EN_archiveError_t;
+
+/* Functions' Prototypes */
+EN_archiveError_t archiveOpen(ST_archive_t *archive, uint8_t *path, uint32_t firstSequenceNumber);
+EN_archiveError_t archiveAppend(ST_archive_t *archive, ST_transaction_t *transData, uint32_t *previousSequenceNumbers);
+EN_archiveError_t archiveGet(ST_archive_t *archive, uint32_t transactionSequenceNumber, ST_transaction_t *transData,
+                             uint32_t *previousSequenceNumber);
+void archiveClose(ST_archive_t *archive);
+
+#endif /* ARCHIVE_H_ */
\ No newline at end of file
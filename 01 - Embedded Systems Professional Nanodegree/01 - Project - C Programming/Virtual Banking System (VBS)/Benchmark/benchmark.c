@@ -0,0 +1,640 @@
+/* Standard Library */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Index Module */
+#include "../Index/index.h"
+/* Filter Module */
+#include "../Filter/filter.h"
+/* Store Module */
+#include "../Store/store.h"
+/* Database Module */
+#include "../Database/database.h"
+/* Log Module */
+#include "../Log/log.h"
+/* Archive Module */
+#include "../Archive/archive.h"
+/* Velocity Module */
+#include "../Velocity/velocity.h"
+
+#define BENCHMARK_INDEX_LOOKUPS		1000000		/* Lookups timed per index run */
+#define BENCHMARK_SCAN_BUDGET		200000000	/* Account comparisons allowed per scan run */
+#define BENCHMARK_BOOK_SCANS		20			/* Whole book scans timed per layout */
+#define BENCHMARK_DATE_QUERIES		20			/* Date range queries timed per method */
+#define BENCHMARK_DAYS				336			/* Days of transactions, 12 months of 28 days */
+#define BENCHMARK_TERMINALS			100			/* Terminals the archived transactions come from */
+#define BENCHMARK_ARCHIVE_LOOKUPS	10000		/* Archived transactions looked up per run */
+#define BENCHMARK_VELOCITY_CHECKS	100000		/* Velocity checks timed per method */
+
+/*
+ Name: generatePAN
+ Input: uint64_t Account number, Pointer to PAN string
+ Output: void
+ Description: Static Function to build a 16 digits Luhn PAN "4" + 14 digits account number + check digit.
+*/
+static void generatePAN(uint64_t number, uint8_t *primaryAccountNumber)
+{
+    uint8_t Loc_Sum = 0, Loc_Digit;
+
+    sprintf(primaryAccountNumber, "4%014" PRIu64, number);
+
+    /* Loop: Over the 15 digits from right to left, doubling every first, third, ... digit */
+    for (uint8_t Loc_Index = 0; Loc_Index < 15; Loc_Index++)
+    {
+        Loc_Digit = primaryAccountNumber[14 - Loc_Index] - '0';
+
+        /* Check: Digit is doubled */
+        if (Loc_Index % 2 == 0)
+        {
+            Loc_Digit *= 2;
+            Loc_Digit  = (Loc_Digit > 9) ? Loc_Digit - 9 : Loc_Digit;
+        }
+
+        Loc_Sum += Loc_Digit;
+    }
+
+    primaryAccountNumber[15] = '0' + ((10 - (Loc_Sum % 10)) % 10);
+    primaryAccountNumber[16] = '\0';
+}
+
+/*
+ Name: scanFind
+ Input: Pointer to PAN strings, uint32_t Number of accounts, Pointer to PAN string
+ Output: uint32_t Record, or count if not found
+ Description: Static Function to search the accounts the way isValidAccount used to, one strcmp per slot.
+*/
+static uint32_t scanFind(uint8_t (*primaryAccountNumbers)[20], uint32_t count, uint8_t *primaryAccountNumber)
+{
+    /* Loop: Until Account is found or until the end of accounts */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+    {
+        /* Check: Account is found */
+        if (!strcmp(primaryAccountNumber, primaryAccountNumbers[Loc_Index]))
+        {
+            return Loc_Index;
+        }
+    }
+
+    return count;
+}
+
+/*
+ Name: elapsedNanoseconds
+ Input: Pointer to start time, Pointer to end time
+ Output: float64_t Nanoseconds
+ Description: Static Function to get the time between two clock_gettime samples.
+*/
+static float64_t elapsedNanoseconds(struct timespec *start, struct timespec *end)
+{
+    return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ Name: benchmarkLookup
+ Input: uint32_t Number of accounts
+ Output: void
+ Description: Static Function to time PAN lookups, half hits and half misses, with the linear scan and with the
+              PAN index over the same accounts packed in a key column, then print the average time per lookup.
+              Index lookups include packing the PAN.
+*/
+static void benchmarkLookup(uint32_t count)
+{
+    uint8_t (*Loc_PANs)[20] = calloc(count, 20);
+    ST_panKey_t *Loc_Keys = calloc(count, sizeof(ST_panKey_t));
+    ST_panKey_t Loc_Key;
+    ST_panIndex_t Loc_Index;
+    struct timespec Loc_Start, Loc_End;
+    uint8_t Loc_PAN[20];
+    uint32_t Loc_Record, Loc_Found = 0;
+    uint32_t Loc_ScanLookups = BENCHMARK_SCAN_BUDGET / count;
+    float64_t Loc_ScanTime, Loc_IndexTime;
+
+    /* Check: No memory */
+    if (Loc_PANs == NULL || Loc_Keys == NULL)
+    {
+        printf(" %10u accounts: not enough memory\n", count);
+        free(Loc_PANs);
+        free(Loc_Keys);
+        return;
+    }
+
+    /* Fill accounts PAN strings and key column */
+    for (uint32_t Loc_Account = 0; Loc_Account < count; Loc_Account++)
+    {
+        generatePAN(Loc_Account * 2, Loc_PANs[Loc_Account]);
+        packCardPAN(Loc_PANs[Loc_Account], &Loc_Keys[Loc_Account]);
+    }
+
+    /* Build index, starting small so the online growth is part of the build */
+    indexInit(&Loc_Index, Loc_Keys, 0);
+
+    for (uint32_t Loc_Account = 0; Loc_Account < count; Loc_Account++)
+    {
+        indexInsert(&Loc_Index, Loc_Account);
+    }
+
+    /* Time linear scan, even account numbers exist and odd ones don't */
+    Loc_ScanLookups = (Loc_ScanLookups > BENCHMARK_INDEX_LOOKUPS) ? BENCHMARK_INDEX_LOOKUPS : Loc_ScanLookups;
+    Loc_ScanLookups = (Loc_ScanLookups < 10) ? 10 : Loc_ScanLookups;
+
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Lookup = 0; Loc_Lookup < Loc_ScanLookups; Loc_Lookup++)
+    {
+        generatePAN((Loc_Lookup * 7919ULL) % (count * 2ULL), Loc_PAN);
+        Loc_Found += (scanFind(Loc_PANs, count, Loc_PAN) != count);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_ScanTime = elapsedNanoseconds(&Loc_Start, &Loc_End) / Loc_ScanLookups;
+
+    /* Time PAN index */
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Lookup = 0; Loc_Lookup < BENCHMARK_INDEX_LOOKUPS; Loc_Lookup++)
+    {
+        generatePAN((Loc_Lookup * 7919ULL) % (count * 2ULL), Loc_PAN);
+        packCardPAN(Loc_PAN, &Loc_Key);
+        Loc_Found += (indexFind(&Loc_Index, &Loc_Key, &Loc_Record) == INDEX_OK);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_IndexTime = elapsedNanoseconds(&Loc_Start, &Loc_End) / BENCHMARK_INDEX_LOOKUPS;
+
+    printf(" %10u accounts: scan %12.1f ns/lookup, index %8.1f ns/lookup, speedup %10.1fx (%u hits)\n",
+           count, Loc_ScanTime, Loc_IndexTime, Loc_ScanTime / Loc_IndexTime, Loc_Found);
+
+    indexFree(&Loc_Index);
+    free(Loc_PANs);
+    free(Loc_Keys);
+}
+
+/*
+ Name: benchmarkUnknown
+ Input: uint32_t Number of accounts
+ Output: void
+ Description: Static Function to time lookups of unknown PANs, as sent by card testing, with the PAN index alone and
+              with the PAN filter in front of it. PANs are packed before timing, so only the lookups are timed.
+*/
+static void benchmarkUnknown(uint32_t count)
+{
+    uint8_t Loc_PAN[20];
+    ST_panKey_t *Loc_Keys   = calloc(count, sizeof(ST_panKey_t));
+    ST_panKey_t *Loc_Probes = calloc(BENCHMARK_INDEX_LOOKUPS, sizeof(ST_panKey_t));
+    ST_panIndex_t Loc_Index;
+    ST_panFilter_t Loc_Filter;
+    struct timespec Loc_Start, Loc_End;
+    uint32_t Loc_Record, Loc_IndexFound = 0, Loc_FilterPassed = 0, Loc_FilterFound = 0;
+    float64_t Loc_IndexTime, Loc_FilterTime;
+
+    /* Check: No memory */
+    if (Loc_Keys == NULL || Loc_Probes == NULL || indexInit(&Loc_Index, Loc_Keys, count * 2) != INDEX_OK ||
+        filterInit(&Loc_Filter, count) != FILTER_OK)
+    {
+        printf(" %10u accounts: not enough memory\n", count);
+        free(Loc_Keys);
+        free(Loc_Probes);
+        return;
+    }
+
+    /* Fill the key column, index and filter with even account numbers */
+    for (uint32_t Loc_Account = 0; Loc_Account < count; Loc_Account++)
+    {
+        generatePAN(Loc_Account * 2, Loc_PAN);
+        packCardPAN(Loc_PAN, &Loc_Keys[Loc_Account]);
+        indexInsert(&Loc_Index, Loc_Account);
+        filterAdd(&Loc_Filter, &Loc_Keys[Loc_Account]);
+    }
+
+    /* Unknown PANs, odd account numbers spread over the whole range */
+    for (uint32_t Loc_Lookup = 0; Loc_Lookup < BENCHMARK_INDEX_LOOKUPS; Loc_Lookup++)
+    {
+        generatePAN(((Loc_Lookup * 7919ULL) % count) * 2 + 1, Loc_PAN);
+        packCardPAN(Loc_PAN, &Loc_Probes[Loc_Lookup]);
+    }
+
+    /* Time PAN index alone */
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Lookup = 0; Loc_Lookup < BENCHMARK_INDEX_LOOKUPS; Loc_Lookup++)
+    {
+        Loc_IndexFound += (indexFind(&Loc_Index, &Loc_Probes[Loc_Lookup], &Loc_Record) == INDEX_OK);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_IndexTime = elapsedNanoseconds(&Loc_Start, &Loc_End) / BENCHMARK_INDEX_LOOKUPS;
+
+    /* Time PAN filter, then PAN index for the false positives */
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Lookup = 0; Loc_Lookup < BENCHMARK_INDEX_LOOKUPS; Loc_Lookup++)
+    {
+        /* Check: PAN passes the filter */
+        if (filterFind(&Loc_Filter, &Loc_Probes[Loc_Lookup]) == FILTER_OK)
+        {
+            Loc_FilterPassed++;
+            Loc_FilterFound += (indexFind(&Loc_Index, &Loc_Probes[Loc_Lookup], &Loc_Record) == INDEX_OK);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_FilterTime = elapsedNanoseconds(&Loc_Start, &Loc_End) / BENCHMARK_INDEX_LOOKUPS;
+
+    printf(" %10u accounts: index %6.1f ns/lookup, filter + index %6.1f ns/lookup, speedup %4.1fx (%.3f%% false positives, %s)\n",
+           count, Loc_IndexTime, Loc_FilterTime, Loc_IndexTime / Loc_FilterTime, Loc_FilterPassed * 100.0 / BENCHMARK_INDEX_LOOKUPS,
+           (Loc_IndexFound == 0 && Loc_FilterFound == 0) ? "none found" : "UNKNOWN PAN FOUND");
+
+    indexFree(&Loc_Index);
+    filterFree(&Loc_Filter);
+    free(Loc_Keys);
+    free(Loc_Probes);
+}
+
+/*
+ Name: benchmarkBook
+ Input: uint32_t Number of accounts
+ Output: void
+ Description: Static Function to time whole book scans, total balance and blocked accounts count, over an array of
+              ST_accountsDB_t records and over the balances and states columns of the accounts database.
+*/
+static void benchmarkBook(uint32_t count)
+{
+    ST_accountsDB_t *Loc_Accounts = calloc(count, sizeof(ST_accountsDB_t));
+    ST_databaseHeader_t Loc_Header = {DATABASE_MAGIC};
+    ST_database_t Loc_Database = {0};
+    struct timespec Loc_Start, Loc_End;
+    sint64_t Loc_RecordsTotal = 0, Loc_ColumnsTotal = 0;
+    uint32_t Loc_RecordsBlocked = 0, Loc_ColumnsBlocked = 0;
+    float64_t Loc_RecordsTime, Loc_ColumnsTime;
+
+    Loc_Header.count      = count;
+    Loc_Database.header   = &Loc_Header;
+    Loc_Database.balances = calloc(count, sizeof(sint64_t));
+    Loc_Database.states   = calloc(count, sizeof(uint8_t));
+
+    /* Check: No memory */
+    if (Loc_Accounts == NULL || Loc_Database.balances == NULL || Loc_Database.states == NULL)
+    {
+        printf(" %10u accounts: not enough memory\n", count);
+        free(Loc_Accounts);
+        free(Loc_Database.balances);
+        free(Loc_Database.states);
+        return;
+    }
+
+    /* Fill both layouts with the same accounts, one in 16 blocked */
+    for (uint32_t Loc_Account = 0; Loc_Account < count; Loc_Account++)
+    {
+        Loc_Accounts[Loc_Account].balance = Loc_Database.balances[Loc_Account] = (Loc_Account * 7919ULL) % 100000000;
+        Loc_Accounts[Loc_Account].state   = Loc_Database.states[Loc_Account]   = (Loc_Account % 16 == 0) ? BLOCKED : RUNNING;
+        generatePAN(Loc_Account * 2, Loc_Accounts[Loc_Account].primaryAccountNumber);
+    }
+
+    /* Time records, every balance and state drags its PAN through the cache */
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Scan = 0; Loc_Scan < BENCHMARK_BOOK_SCANS; Loc_Scan++)
+    {
+        for (uint32_t Loc_Account = 0; Loc_Account < count; Loc_Account++)
+        {
+            Loc_RecordsTotal   += Loc_Accounts[Loc_Account].balance;
+            Loc_RecordsBlocked += (Loc_Accounts[Loc_Account].state == BLOCKED);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_RecordsTime = elapsedNanoseconds(&Loc_Start, &Loc_End) / BENCHMARK_BOOK_SCANS / 1e6;
+
+    /* Time columns */
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Scan = 0; Loc_Scan < BENCHMARK_BOOK_SCANS; Loc_Scan++)
+    {
+        Loc_ColumnsTotal   += databaseTotalBalance(&Loc_Database);
+        Loc_ColumnsBlocked += databaseBlockedAccounts(&Loc_Database);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_ColumnsTime = elapsedNanoseconds(&Loc_Start, &Loc_End) / BENCHMARK_BOOK_SCANS / 1e6;
+
+    printf(" %10u accounts: records %8.2f ms/scan, columns %8.2f ms/scan, speedup %5.1fx (%s)\n",
+           count, Loc_RecordsTime, Loc_ColumnsTime, Loc_RecordsTime / Loc_ColumnsTime,
+           (Loc_RecordsTotal == Loc_ColumnsTotal && Loc_RecordsBlocked == Loc_ColumnsBlocked) ? "same totals" : "TOTALS DIFFER");
+
+    free(Loc_Accounts);
+    free(Loc_Database.balances);
+    free(Loc_Database.states);
+}
+
+/*
+ Name: benchmarkDates
+ Input: uint32_t Number of transactions
+ Output: void
+ Description: Static Function to time "declined transactions of one week" over the transactions of
+              BENCHMARK_DAYS days in date order, one in 20 declined, by parsing the date string of every transaction
+              of an array of transactions and by the zone maps and packed date column of a transactions store, and
+              to compare the bytes each keeps per transaction.
+*/
+static void benchmarkDates(uint32_t count)
+{
+    ST_transactionStore_t Loc_Store;
+    ST_transaction_t Loc_Transaction = {0};
+    ST_transaction_t *Loc_Found = malloc(count * sizeof(ST_transaction_t));
+    ST_transaction_t *Loc_Rows  = malloc(count * sizeof(ST_transaction_t));
+    struct timespec Loc_Start, Loc_End;
+    uint32_t Loc_FromDay, Loc_ToDay, Loc_Day, Loc_ScanCount = 0, Loc_ZoneCount = 0;
+    uint32_t Loc_Wanted = STORE_STATE_BIT(DECLINED_INSUFFECIENT_FUND) | STORE_STATE_BIT(DECLINED_STOLEN_CARD);
+    float64_t Loc_ScanTime, Loc_ZoneTime;
+
+    /* Check: No memory */
+    if (Loc_Found == NULL || Loc_Rows == NULL || storeInit(&Loc_Store, 1, 0) != STORE_OK)
+    {
+        printf(" %10u transactions: not enough memory\n", count);
+        free(Loc_Found);
+        free(Loc_Rows);
+        return;
+    }
+
+    /* Fill the store in date order, 12 months of 28 days */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+    {
+        Loc_Day = (uint32_t)((uint64_t)Loc_Index * BENCHMARK_DAYS / count);
+        sprintf(Loc_Transaction.terminalData.transactionDate, "%02u/%02u/2026", Loc_Day % 28 + 1, Loc_Day / 28 + 1);
+        Loc_Transaction.transState = (Loc_Index % 20 == 0) ? DECLINED_INSUFFECIENT_FUND : APPROVED;
+        storeAppend(&Loc_Store, &Loc_Transaction, 0);
+        Loc_Rows[Loc_Index] = Loc_Transaction;
+    }
+
+    /* One week in the middle of the year */
+    packTransactionDate("10/06/2026", &Loc_FromDay);
+    packTransactionDate("16/06/2026", &Loc_ToDay);
+
+    /* Time parsing the date string of every transaction */
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Query = 0; Loc_Query < BENCHMARK_DATE_QUERIES; Loc_Query++)
+    {
+        Loc_ScanCount = 0;
+
+        for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+        {
+            packTransactionDate(Loc_Rows[Loc_Index].terminalData.transactionDate, &Loc_Day);
+
+            /* Check: Day in range and state wanted */
+            if (Loc_Day >= Loc_FromDay && Loc_Day <= Loc_ToDay && (STORE_STATE_BIT(Loc_Rows[Loc_Index].transState) & Loc_Wanted) != 0)
+            {
+                Loc_Found[Loc_ScanCount] = Loc_Rows[Loc_Index];
+                Loc_ScanCount++;
+            }
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_ScanTime = elapsedNanoseconds(&Loc_Start, &Loc_End) / BENCHMARK_DATE_QUERIES / 1e6;
+
+    /* Time zone maps */
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Query = 0; Loc_Query < BENCHMARK_DATE_QUERIES; Loc_Query++)
+    {
+        Loc_ZoneCount = storeFindByDate(&Loc_Store, Loc_FromDay, Loc_ToDay, Loc_Wanted, Loc_Found, count);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_ZoneTime = elapsedNanoseconds(&Loc_Start, &Loc_End) / BENCHMARK_DATE_QUERIES / 1e6;
+
+    printf(" %10u transactions: date strings %8.3f ms/query, zone maps %8.3f ms/query, speedup %6.1fx (%u found, %s)\n",
+           count, Loc_ScanTime, Loc_ZoneTime, Loc_ScanTime / Loc_ZoneTime, Loc_ZoneCount,
+           (Loc_ScanCount == Loc_ZoneCount) ? "same results" : "RESULTS DIFFER");
+    printf(" %10s bytes per transaction: %u in the array, %.1f in the store\n", "",
+           (uint32_t)sizeof(ST_transaction_t), (float64_t)sizeof(ST_transactionSegment_t) / STORE_SEGMENT_SIZE);
+
+    storeFree(&Loc_Store);
+    free(Loc_Found);
+    free(Loc_Rows);
+}
+
+/*
+ Name: benchmarkArchive
+ Input: uint32_t Number of transactions, a multiple of ARCHIVE_BLOCK_TRANSACTIONS, uint32_t Number of accounts
+ Output: void
+ Description: Static Function to archive the transactions of BENCHMARK_DAYS days in date order, of the given number
+              of accounts and BENCHMARK_TERMINALS terminals, one in 20 declined, then compare the bytes a transaction
+              takes in the log and in the archive, and time looking up archived transactions, each one checked
+              against the transaction archived.
+*/
+static void benchmarkArchive(uint32_t count, uint32_t accounts)
+{
+    ST_archive_t Loc_Archive;
+    ST_transaction_t *Loc_Transactions = calloc(count, sizeof(ST_transaction_t));
+    uint32_t *Loc_PreviousSequences = calloc(count, sizeof(uint32_t));
+    uint32_t *Loc_LastSequences = calloc(accounts, sizeof(uint32_t));
+    uint8_t Loc_Directory[] = "/tmp/vbs-benchmark-XXXXXX";
+    uint8_t Loc_Path[64];
+    ST_transaction_t Loc_Found;
+    uint32_t Loc_Account, Loc_Day, Loc_Sequence, Loc_PreviousSequence, Loc_Wrong = 0;
+    struct timespec Loc_Start, Loc_End;
+    struct stat Loc_Status;
+    float64_t Loc_LookupTime;
+
+    /* Check: No memory, or archive can't be created */
+    if (Loc_Transactions == NULL || Loc_PreviousSequences == NULL || Loc_LastSequences == NULL || mkdtemp(Loc_Directory) == NULL ||
+        (snprintf(Loc_Path, sizeof(Loc_Path), "%s/%s", Loc_Directory, SERVER_ARCHIVE_FILE), archiveOpen(&Loc_Archive, Loc_Path, 1)) != ARCHIVE_OK)
+    {
+        printf(" %10u transactions: not enough memory, or archive can't be created\n", count);
+        free(Loc_Transactions);
+        free(Loc_PreviousSequences);
+        free(Loc_LastSequences);
+        return;
+    }
+
+    /* Fill transactions in date order, each of an account picked by a multiplicative hash */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+    {
+        Loc_Account = (Loc_Index * 2654435761U) % accounts;
+        Loc_Day     = (uint32_t)((uint64_t)Loc_Index * BENCHMARK_DAYS / count);
+
+        generatePAN(Loc_Account * 2, Loc_Transactions[Loc_Index].cardHolderData.primaryAccountNumber);
+        sprintf(Loc_Transactions[Loc_Index].cardHolderData.cardHolderName, "Card Holder %u", Loc_Account);
+        strcpy(Loc_Transactions[Loc_Index].cardHolderData.cardExpirationDate, "05/30");
+        sprintf(Loc_Transactions[Loc_Index].terminalData.transactionDate, "%02u/%02u/2026", Loc_Day % 28 + 1, Loc_Day / 28 + 1);
+        Loc_Transactions[Loc_Index].terminalData.transAmount    = 100 + (Loc_Index * 7919U) % 50000;
+        Loc_Transactions[Loc_Index].terminalData.maxTransAmount = TERMINAL_MAX_AMOUNT;
+        Loc_Transactions[Loc_Index].terminalData.terminalId     = Loc_Account % BENCHMARK_TERMINALS;
+        Loc_Transactions[Loc_Index].terminalData.requestId      = Loc_Index + 1;
+        Loc_Transactions[Loc_Index].transState                  = (Loc_Index % 20 == 0) ? DECLINED_INSUFFECIENT_FUND : APPROVED;
+        Loc_Transactions[Loc_Index].transactionSequenceNumber   = Loc_Index + 1;
+
+        Loc_PreviousSequences[Loc_Index] = Loc_LastSequences[Loc_Account];
+        Loc_LastSequences[Loc_Account]   = Loc_Index + 1;
+    }
+
+    /* Archive block by block */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index += ARCHIVE_BLOCK_TRANSACTIONS)
+    {
+        archiveAppend(&Loc_Archive, &Loc_Transactions[Loc_Index], &Loc_PreviousSequences[Loc_Index]);
+    }
+
+    fstat(Loc_Archive.fileDescriptor, &Loc_Status);
+
+    /* Time archived lookups */
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Lookup = 0; Loc_Lookup < BENCHMARK_ARCHIVE_LOOKUPS; Loc_Lookup++)
+    {
+        Loc_Sequence = 1 + (uint32_t)((Loc_Lookup * 7919ULL) % count);
+
+        /* Check: Transaction not found, or not the one archived */
+        if (archiveGet(&Loc_Archive, Loc_Sequence, &Loc_Found, &Loc_PreviousSequence) != ARCHIVE_OK ||
+            memcmp(&Loc_Found, &Loc_Transactions[Loc_Sequence - 1], sizeof(ST_transaction_t)) != 0 ||
+            Loc_PreviousSequence != Loc_PreviousSequences[Loc_Sequence - 1])
+        {
+            Loc_Wrong++;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_LookupTime = elapsedNanoseconds(&Loc_Start, &Loc_End) / BENCHMARK_ARCHIVE_LOOKUPS / 1e3;
+
+    printf(" %10u transactions, %7u accounts: log %u B, archive %6.1f B per transaction, %5.1fx smaller, lookup %7.1f us (%s)\n",
+           count, accounts, (uint32_t)sizeof(ST_logRecord_t), (float64_t)Loc_Status.st_size / count,
+           sizeof(ST_logRecord_t) * (float64_t)count / Loc_Status.st_size, Loc_LookupTime,
+           (Loc_Wrong == 0) ? "same transactions" : "TRANSACTIONS DIFFER");
+
+    archiveClose(&Loc_Archive);
+    unlink(Loc_Path);
+    rmdir(Loc_Directory);
+    free(Loc_Transactions);
+    free(Loc_PreviousSequences);
+    free(Loc_LastSequences);
+}
+
+/*
+ Name: benchmarkVelocity
+ Input: uint32_t Number of approved transactions of the account in its last day
+ Output: void
+ Description: Static Function to time the velocity check of a transaction of an account with the given number of
+              approved transactions spread over its last day, by walking its history back one day and summing the
+              count and amount of every window, and by the bucketed rings of the account, and to compare the bytes
+              each keeps per account. The day count limit is the number of transactions, so both decline every check.
+*/
+static void benchmarkVelocity(uint32_t count)
+{
+    ST_velocityAccount_t *Loc_Account = calloc(1, sizeof(ST_velocityAccount_t));
+    uint32_t *Loc_Times = malloc(count * sizeof(uint32_t));
+    sint64_t *Loc_Amounts = malloc(count * sizeof(sint64_t));
+    const uint32_t Loc_WindowSeconds[VELOCITY_WINDOWS] = {VELOCITY_MINUTE_SECONDS, VELOCITY_HOUR_SECONDS, VELOCITY_DAY_SECONDS};
+    ST_velocityLimits_t Loc_Limits = {{0, 0, count}, {0, 0, 0}};
+    uint32_t Loc_Now = 100 * VELOCITY_DAY_SECONDS, Loc_Counts[VELOCITY_WINDOWS];
+    sint64_t Loc_Sums[VELOCITY_WINDOWS];
+    uint32_t Loc_WalkDeclined = 0, Loc_RingDeclined = 0, Loc_Declined;
+    struct timespec Loc_Start, Loc_End;
+    float64_t Loc_WalkTime, Loc_RingTime;
+
+    /* Check: No memory */
+    if (Loc_Account == NULL || Loc_Times == NULL || Loc_Amounts == NULL)
+    {
+        printf(" %10u transactions: not enough memory\n", count);
+        free(Loc_Account);
+        free(Loc_Times);
+        free(Loc_Amounts);
+        return;
+    }
+
+    /* Fill the history oldest first, within the day less one bucket so both methods count all of it in the day */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+    {
+        Loc_Times[Loc_Index]   = Loc_Now - (uint32_t)((uint64_t)(count - 1 - Loc_Index) *
+                                 (VELOCITY_DAY_SECONDS - VELOCITY_DAY_SECONDS / VELOCITY_BUCKETS) / count);
+        Loc_Amounts[Loc_Index] = 100 + (Loc_Index * 7919U) % 50000;
+        velocityAdd(Loc_Account, Loc_Times[Loc_Index], Loc_Amounts[Loc_Index]);
+    }
+
+    /* Time walking the history back one day */
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Check = 0; Loc_Check < BENCHMARK_VELOCITY_CHECKS; Loc_Check++)
+    {
+        memset(Loc_Counts, 0, sizeof(Loc_Counts));
+        memset(Loc_Sums, 0, sizeof(Loc_Sums));
+        Loc_Declined = 0;
+
+        for (uint32_t Loc_Index = count; Loc_Index > 0 && Loc_Now - Loc_Times[Loc_Index - 1] < VELOCITY_DAY_SECONDS; Loc_Index--)
+        {
+            for (uint32_t Loc_Window = 0; Loc_Window < VELOCITY_WINDOWS; Loc_Window++)
+            {
+                /* Check: Transaction is in the window */
+                if (Loc_Now - Loc_Times[Loc_Index - 1] < Loc_WindowSeconds[Loc_Window])
+                {
+                    Loc_Counts[Loc_Window]++;
+                    Loc_Sums[Loc_Window] += Loc_Amounts[Loc_Index - 1];
+                }
+            }
+        }
+
+        for (uint32_t Loc_Window = 0; Loc_Window < VELOCITY_WINDOWS; Loc_Window++)
+        {
+            /* Check: Window over its limit */
+            if ((Loc_Limits.maxCount[Loc_Window] != 0 && Loc_Counts[Loc_Window] + 1 > Loc_Limits.maxCount[Loc_Window]) ||
+                (Loc_Limits.maxAmount[Loc_Window] != 0 && Loc_Sums[Loc_Window] + 100 > Loc_Limits.maxAmount[Loc_Window]))
+            {
+                Loc_Declined = 1;
+            }
+        }
+
+        Loc_WalkDeclined += Loc_Declined;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_WalkTime = elapsedNanoseconds(&Loc_Start, &Loc_End) / BENCHMARK_VELOCITY_CHECKS;
+
+    /* Time the rings */
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Check = 0; Loc_Check < BENCHMARK_VELOCITY_CHECKS; Loc_Check++)
+    {
+        Loc_RingDeclined += (velocityCheck(Loc_Account, &Loc_Limits, Loc_Now, 100) == VELOCITY_EXCEEDED);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_RingTime = elapsedNanoseconds(&Loc_Start, &Loc_End) / BENCHMARK_VELOCITY_CHECKS;
+
+    printf(" %10u transactions: history walk %10.1f ns/check, rings %6.1f ns/check, speedup %8.1fx (%s)\n",
+           count, Loc_WalkTime, Loc_RingTime, Loc_WalkTime / Loc_RingTime,
+           (Loc_WalkDeclined == Loc_RingDeclined && Loc_RingDeclined == BENCHMARK_VELOCITY_CHECKS) ? "same decisions" : "DECISIONS DIFFER");
+    printf(" %10s bytes per account: %u in the history, %u in the rings\n", "",
+           (uint32_t)(count * (sizeof(uint32_t) + sizeof(sint64_t))), (uint32_t)sizeof(ST_velocityAccount_t));
+
+    free(Loc_Account);
+    free(Loc_Times);
+    free(Loc_Amounts);
+}
+
+int main(void)
+{
+    printf("\n PAN lookup: linear scan vs PAN index (PAN generation included in both)\n\n");
+
+    benchmarkLookup(255);
+    benchmarkLookup(10000);
+    benchmarkLookup(10000000);
+
+    printf("\n Unknown PAN lookup: PAN index vs PAN filter + PAN index\n\n");
+
+    benchmarkUnknown(10000);
+    benchmarkUnknown(1000000);
+    benchmarkUnknown(10000000);
+
+    printf("\n Total balance and blocked accounts: records vs columns\n\n");
+
+    benchmarkBook(10000);
+    benchmarkBook(10000000);
+
+    printf("\n Declined transactions of one week: date strings vs zone maps\n\n");
+
+    benchmarkDates(100000);
+    benchmarkDates(2000000);
+
+    printf("\n Archived transactions: log records vs archive blocks\n\n");
+
+    benchmarkArchive(100 * ARCHIVE_BLOCK_TRANSACTIONS, 1000);
+    benchmarkArchive(1000 * ARCHIVE_BLOCK_TRANSACTIONS, 1000000);
+
+    printf("\n Velocity check of one account: history walk vs bucketed rings\n\n");
+
+    benchmarkVelocity(10);
+    benchmarkVelocity(1000);
+    benchmarkVelocity(100000);
+
+    return 0;
+}
\ No newline at end of file
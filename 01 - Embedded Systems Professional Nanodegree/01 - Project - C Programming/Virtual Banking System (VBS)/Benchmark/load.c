@@ -0,0 +1,483 @@
+/* Standard Library */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+
+#define LOAD_MAX_THREADS			64
+#define LOAD_THREADS				4			/* Default worker threads, -t */
+#define LOAD_TRANSACTIONS			20000		/* Default transactions per worker, -n */
+#define LOAD_BATCH					1			/* Default transactions per call, 1 calls recieveTransactionData, -b */
+#define LOAD_ACCOUNTS				10000		/* Default accounts of each kind, -a */
+#define LOAD_ADD_ACCOUNTS			4096		/* Accounts per addAccounts call */
+#define LOAD_BALANCE				1000000000000000LL	/* Cents of approving and blocked accounts, never runs out */
+#define LOAD_MAX_AMOUNT				10000		/* Amounts are 1 to this many cents */
+#define LOAD_PAN_PREFIX				4			/* Synthetic PANs are 16 digits, this digit, 14 digits of number, Luhn digit */
+
+typedef enum EN_loadKind_t
+{
+	LOAD_APPROVE, LOAD_LOW_BALANCE, LOAD_BLOCKED, LOAD_UNKNOWN, LOAD_KINDS
+}EN_loadKind_t;
+
+typedef struct ST_loadWorker_t
+{
+	pthread_t thread;
+	uint64_t random;						/* xorshift state of the worker */
+	uint64_t *latencies;					/* Nanoseconds of every call */
+	uint32_t calls;
+	uint32_t states[DECLINED_VELOCITY_LIMIT + 1];
+	uint32_t wrong;							/* Transactions whose state is not the one of their card kind */
+	uint32_t terminal;						/* Terminal id of the worker, new on every run, its requests are numbered from 1 */
+	uint32_t retried;						/* Transactions submitted again after their call */
+	uint32_t retryWrong;					/* Retried transactions not answered with the first state and sequence number */
+}ST_loadWorker_t;
+
+/* Load, set from the command line */
+static uint32_t Glb_Threads = LOAD_THREADS;
+static uint32_t Glb_Transactions = LOAD_TRANSACTIONS;
+static uint32_t Glb_Batch = LOAD_BATCH;
+static uint32_t Glb_Accounts = LOAD_ACCOUNTS;
+static uint32_t Glb_Mix[LOAD_KINDS] = {85, 5, 5, 5};		/* Percent of transactions on each kind of card */
+static EN_flagState_t Glb_StagesFlag = FLAG_DOWN;			/* Time the server stages and print them after the run, -s */
+static uint32_t Glb_Shards = 0;								/* Shard workers of the server, 0 opens it unsharded, -w */
+static EN_flagState_t Glb_PipelineFlag = FLAG_DOWN;			/* Open the server pipelined, -p */
+static uint32_t Glb_Retries = 0;							/* Percent of calls submitted twice, as a terminal retrying, -r */
+/* State each kind of card must get */
+static const EN_transState_t Glb_ExpectedStates[LOAD_KINDS] = {APPROVED, DECLINED_INSUFFECIENT_FUND, DECLINED_STOLEN_CARD, FRAUD_CARD};
+static const uint8_t *Glb_StateNames[DECLINED_VELOCITY_LIMIT + 1] = {"approved", "low balance", "stolen", "fraud",
+                                                                    "server error", "velocity limit"};
+
+/*
+ Name: loadRandom
+ Input: Pointer to uint64_t Random state
+ Output: uint64_t Random number
+ Description: Static Function to draw the next number of a xorshift64* generator, one per worker.
+*/
+static uint64_t loadRandom(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+/*
+ Name: loadPAN
+ Input: EN_loadKind_t Kind of card, uint32_t Card number, Pointer to PAN string
+ Output: void
+ Description: Static Function to synthesize the Luhn valid PAN of a card: LOAD_PAN_PREFIX, the kind and the number
+              in 14 digits, then the check digit. Cards of the unknown kind never get an account.
+*/
+static void loadPAN(EN_loadKind_t kind, uint32_t number, uint8_t *primaryAccountNumber)
+{
+    uint32_t Loc_Sum = 0, Loc_Digit;
+
+    sprintf((char *)primaryAccountNumber, "%u%014llu", LOAD_PAN_PREFIX, (uint64_t)kind * 1000000000ULL + number);
+
+    /* Loop: Until all 15 digits are summed, right to left, doubling the rightmost one and every second one after it */
+    for (uint32_t Loc_Index = 0; Loc_Index < 15; Loc_Index++)
+    {
+        Loc_Digit = (primaryAccountNumber[14 - Loc_Index] - '0') * ((Loc_Index % 2 == 0) ? 2 : 1);
+        Loc_Sum  += (Loc_Digit > 9) ? Loc_Digit - 9 : Loc_Digit;
+    }
+
+    primaryAccountNumber[15] = '0' + (10 - Loc_Sum % 10) % 10;
+    primaryAccountNumber[16] = '\0';
+}
+
+/*
+ Name: loadAccounts
+ Input: void
+ Output: EN_serverError_t Error or No Error
+ Description: Static Function to add the accounts of the approving, low balance and blocked cards. Approving cards
+              never run out of balance, low balance cards have none, blocked cards have enough. Accounts left by a
+              previous run on the same files are kept.
+*/
+static EN_serverError_t loadAccounts(void)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    ST_accountsDB_t *Loc_Accounts = calloc(LOAD_ADD_ACCOUNTS, sizeof(ST_accountsDB_t));
+    uint32_t Loc_Count = 0, Loc_Added = 0, Loc_Total = 0;
+
+    /* Loop: Until all accounts of the three kinds are added */
+    for (uint32_t Loc_Index = 0; Loc_Index < LOAD_UNKNOWN * Glb_Accounts && Loc_Accounts != NULL && Loc_ErrorState == SERVER_OK; Loc_Index++)
+    {
+        loadPAN(Loc_Index / Glb_Accounts, Loc_Index % Glb_Accounts, Loc_Accounts[Loc_Count].primaryAccountNumber);
+        Loc_Accounts[Loc_Count].balance = (Loc_Index / Glb_Accounts == LOAD_LOW_BALANCE) ? 0 : LOAD_BALANCE;
+        Loc_Accounts[Loc_Count].state   = (Loc_Index / Glb_Accounts == LOAD_BLOCKED) ? BLOCKED : RUNNING;
+        Loc_Count++;
+
+        /* Check: Chunk is full, or last account */
+        if (Loc_Count == LOAD_ADD_ACCOUNTS || Loc_Index + 1 == LOAD_UNKNOWN * Glb_Accounts)
+        {
+            Loc_ErrorState = addAccounts(Loc_Accounts, Loc_Count, &Loc_Added);
+            Loc_Total     += Loc_Added;
+            Loc_Count      = 0;
+        }
+    }
+
+    printf(" %u accounts of each kind, %u added, the others were there\n", Glb_Accounts, Loc_Total);
+
+    free(Loc_Accounts);
+
+    return (Loc_Accounts == NULL) ? SAVING_FAILED : Loc_ErrorState;
+}
+
+/*
+ Name: loadWorker
+ Input: Pointer to Worker structure
+ Output: NULL
+ Description: Static Function to run the transactions of one worker. Each transaction draws the kind of its card
+              from the mix, a card of that kind and an amount, every call is timed. The worker is a terminal and
+              numbers its requests, Glb_Retries percent of the calls are submitted again untimed and must get the
+              same states and sequence numbers.
+*/
+static void *loadWorker(void *argument)
+{
+    ST_loadWorker_t *Loc_Worker = argument;
+    ST_transaction_t *Loc_Transactions = calloc(Glb_Batch, sizeof(ST_transaction_t));
+    EN_transState_t *Loc_States = calloc(Glb_Batch, sizeof(EN_transState_t));
+    EN_loadKind_t *Loc_Kinds = calloc(Glb_Batch, sizeof(EN_loadKind_t));
+    uint32_t *Loc_Sequences = calloc(Glb_Batch, sizeof(uint32_t));
+    struct timespec Loc_Start, Loc_End;
+    uint32_t Loc_Draw, Loc_Size, Loc_Request = 0;
+
+    /* Loop: Until all transactions of the worker are done, one call at a time */
+    for (uint32_t Loc_Count = 0; Loc_Count < Glb_Transactions && Loc_Sequences != NULL; Loc_Count += Loc_Size)
+    {
+        Loc_Size = (Glb_Transactions - Loc_Count < Glb_Batch) ? Glb_Transactions - Loc_Count : Glb_Batch;
+
+        /* Loop: Until the transactions of the call are built */
+        for (uint32_t Loc_Index = 0; Loc_Index < Loc_Size; Loc_Index++)
+        {
+            Loc_Draw = loadRandom(&Loc_Worker->random) % 100;
+            Loc_Kinds[Loc_Index] = LOAD_APPROVE;
+
+            /* Loop: Until the percent drawn falls in the mix of a kind */
+            while (Loc_Kinds[Loc_Index] + 1 < LOAD_KINDS && Loc_Draw >= Glb_Mix[Loc_Kinds[Loc_Index]])
+            {
+                Loc_Draw -= Glb_Mix[Loc_Kinds[Loc_Index]];
+                Loc_Kinds[Loc_Index]++;
+            }
+
+            strcpy(Loc_Transactions[Loc_Index].cardHolderData.cardHolderName, "Load Generator Card User");
+            strcpy(Loc_Transactions[Loc_Index].cardHolderData.cardExpirationDate, "12/30");
+            loadPAN(Loc_Kinds[Loc_Index], loadRandom(&Loc_Worker->random) % Glb_Accounts, Loc_Transactions[Loc_Index].cardHolderData.primaryAccountNumber);
+            strcpy(Loc_Transactions[Loc_Index].terminalData.transactionDate, "17/10/2026");
+            Loc_Transactions[Loc_Index].terminalData.maxTransAmount = TERMINAL_MAX_AMOUNT;
+            Loc_Transactions[Loc_Index].terminalData.transAmount    = 1 + loadRandom(&Loc_Worker->random) % LOAD_MAX_AMOUNT;
+            Loc_Transactions[Loc_Index].terminalData.terminalId     = Loc_Worker->terminal;
+            Loc_Transactions[Loc_Index].terminalData.requestId      = ++Loc_Request;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+
+        /* Check: Single transaction calls */
+        if (Glb_Batch == 1)
+        {
+            Loc_States[0] = recieveTransactionData(&Loc_Transactions[0]);
+        }
+        else
+        {
+            recieveTransactionBatch(Loc_Transactions, Loc_Size, Loc_States);
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+
+        Loc_Worker->latencies[Loc_Worker->calls++] = (Loc_End.tv_sec - Loc_Start.tv_sec) * 1000000000ULL + Loc_End.tv_nsec - Loc_Start.tv_nsec;
+
+        /* Loop: Until the results of the call are counted */
+        for (uint32_t Loc_Index = 0; Loc_Index < Loc_Size; Loc_Index++)
+        {
+            Loc_Worker->states[Loc_States[Loc_Index]]++;
+            Loc_Worker->wrong += (Loc_States[Loc_Index] != Glb_ExpectedStates[Loc_Kinds[Loc_Index]]);
+            Loc_Sequences[Loc_Index] = Loc_Transactions[Loc_Index].transactionSequenceNumber;
+        }
+
+        /* Check: Call is retried, as if its answer was lost */
+        if (loadRandom(&Loc_Worker->random) % 100 < Glb_Retries)
+        {
+            /* Check: Single transaction calls */
+            if (Glb_Batch == 1)
+            {
+                Loc_States[0] = recieveTransactionData(&Loc_Transactions[0]);
+            }
+            else
+            {
+                recieveTransactionBatch(Loc_Transactions, Loc_Size, Loc_States);
+            }
+
+            /* Loop: Until the answers of the retry are compared with the first ones */
+            for (uint32_t Loc_Index = 0; Loc_Index < Loc_Size; Loc_Index++)
+            {
+                Loc_Worker->retryWrong += (Loc_States[Loc_Index] != Glb_ExpectedStates[Loc_Kinds[Loc_Index]] ||
+                                           Loc_Transactions[Loc_Index].transactionSequenceNumber != Loc_Sequences[Loc_Index]);
+            }
+
+            Loc_Worker->retried += Loc_Size;
+        }
+    }
+
+    free(Loc_Transactions);
+    free(Loc_States);
+    free(Loc_Kinds);
+    free(Loc_Sequences);
+
+    return NULL;
+}
+
+/*
+ Name: loadCompare
+ Input: Pointer to first latency, Pointer to second latency
+ Output: int Order of the latencies
+ Description: Static Function to order latencies for qsort.
+*/
+static int loadCompare(const void *first, const void *second)
+{
+    uint64_t Loc_First  = *(const uint64_t *)first;
+    uint64_t Loc_Second = *(const uint64_t *)second;
+
+    return (Loc_First > Loc_Second) - (Loc_First < Loc_Second);
+}
+
+/*
+ Name: loadPercentile
+ Input: Pointer to sorted latencies, uint32_t Number of latencies, float64_t Fraction
+ Output: float64_t Latency in microseconds
+ Description: Static Function to give the smallest latency that at least the fraction of calls did not exceed.
+*/
+static float64_t loadPercentile(uint64_t *latencies, uint32_t count, float64_t fraction)
+{
+    uint32_t Loc_Rank = (uint32_t)(fraction * count + 0.999999);
+
+    return (count == 0) ? 0 : latencies[(Loc_Rank == 0) ? 0 : Loc_Rank - 1] / 1000.0;
+}
+
+/*
+ Name: loadRun
+ Input: void
+ Output: uint32_t Number of wrong or failed transactions
+ Description: Static Function to run all workers at once, then report the throughput, the latency percentiles of
+              the calls and the states of the transactions.
+*/
+static uint32_t loadRun(void)
+{
+    ST_loadWorker_t Loc_Workers[LOAD_MAX_THREADS];
+    struct timespec Loc_Start, Loc_End;
+    uint32_t Loc_Calls = (Glb_Transactions + Glb_Batch - 1) / Glb_Batch, Loc_Total = 0, Loc_Wrong = 0;
+    uint32_t Loc_Retried = 0, Loc_RetryWrong = 0;
+    uint32_t Loc_States[DECLINED_VELOCITY_LIMIT + 1] = {0};
+    uint64_t *Loc_Latencies = malloc((uint64_t)Glb_Threads * Loc_Calls * sizeof(uint64_t));
+    float64_t Loc_Seconds;
+
+    memset(Loc_Workers, 0, sizeof(Loc_Workers));
+
+    /* Check: No memory for the latencies */
+    if (Loc_Latencies == NULL)
+    {
+        printf(" Can't allocate the latencies of %u calls\n", Glb_Threads * Loc_Calls);
+        return 1;
+    }
+
+    /* Check: Server stages are timed, from the start of the run */
+    if (Glb_StagesFlag == FLAG_UP)
+    {
+        setStageHistograms(FLAG_UP);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+
+    /* Loop: Until all workers are started */
+    for (uint32_t Loc_Thread = 0; Loc_Thread < Glb_Threads; Loc_Thread++)
+    {
+        Loc_Workers[Loc_Thread].random    = 0x9E3779B97F4A7C15ULL * (Loc_Thread + 1);
+        Loc_Workers[Loc_Thread].latencies = &Loc_Latencies[(uint64_t)Loc_Thread * Loc_Calls];
+        Loc_Workers[Loc_Thread].terminal  = (uint32_t)getpid() * LOAD_MAX_THREADS + Loc_Thread;
+        pthread_create(&Loc_Workers[Loc_Thread].thread, NULL, loadWorker, &Loc_Workers[Loc_Thread]);
+    }
+
+    /* Loop: Until all workers are done, gather their latencies at the start of the array */
+    for (uint32_t Loc_Thread = 0; Loc_Thread < Glb_Threads; Loc_Thread++)
+    {
+        pthread_join(Loc_Workers[Loc_Thread].thread, NULL);
+
+        memmove(&Loc_Latencies[Loc_Total], Loc_Workers[Loc_Thread].latencies, Loc_Workers[Loc_Thread].calls * sizeof(uint64_t));
+        Loc_Total += Loc_Workers[Loc_Thread].calls;
+        Loc_Wrong += Loc_Workers[Loc_Thread].wrong;
+        Loc_Retried    += Loc_Workers[Loc_Thread].retried;
+        Loc_RetryWrong += Loc_Workers[Loc_Thread].retryWrong;
+
+        /* Loop: Over all states */
+        for (uint32_t Loc_State = 0; Loc_State <= DECLINED_VELOCITY_LIMIT; Loc_State++)
+        {
+            Loc_States[Loc_State] += Loc_Workers[Loc_Thread].states[Loc_State];
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_Seconds = (Loc_End.tv_sec - Loc_Start.tv_sec) + (Loc_End.tv_nsec - Loc_Start.tv_nsec) / 1e9;
+
+    qsort(Loc_Latencies, Loc_Total, sizeof(uint64_t), loadCompare);
+
+    printf(" %u threads, %u transactions, %u per call: %.0f transactions/s\n", Glb_Threads, Glb_Threads * Glb_Transactions,
+           Glb_Batch, Glb_Threads * Glb_Transactions / Loc_Seconds);
+    printf(" latency per call: p50 %.1f us, p99 %.1f us, p999 %.1f us, max %.1f us\n",
+           loadPercentile(Loc_Latencies, Loc_Total, 0.50), loadPercentile(Loc_Latencies, Loc_Total, 0.99),
+           loadPercentile(Loc_Latencies, Loc_Total, 0.999), (Loc_Total == 0) ? 0 : Loc_Latencies[Loc_Total - 1] / 1000.0);
+
+    /* Loop: Over all states */
+    for (uint32_t Loc_State = 0; Loc_State <= DECLINED_VELOCITY_LIMIT; Loc_State++)
+    {
+        printf("%s %s %u", (Loc_State == 0) ? " states:" : ",", Glb_StateNames[Loc_State], Loc_States[Loc_State]);
+    }
+    printf("\n %u transactions not in the state of their card kind, %s\n", Loc_Wrong, (Loc_Wrong == 0) ? "mix exact" : "MIX WRONG");
+
+    /* Check: Calls are retried */
+    if (Glb_Retries > 0)
+    {
+        printf(" %u transactions retried, %u not answered as the first time, %s\n", Loc_Retried, Loc_RetryWrong,
+               (Loc_RetryWrong == 0) ? "retries exact" : "RETRIES WRONG");
+    }
+
+    /* Check: Server stages are timed, a daemon prints them on its own output */
+    if (Glb_StagesFlag == FLAG_UP)
+    {
+        dumpStageHistograms();
+        setStageHistograms(FLAG_DOWN);
+    }
+
+    free(Loc_Latencies);
+
+    return Loc_Wrong + Loc_RetryWrong;
+}
+
+/*
+ Name: loadUsage
+ Input: Pointer to program name
+ Output: int Exit status
+ Description: Static Function to print the options.
+*/
+static int loadUsage(uint8_t *program)
+{
+    printf(" Usage: %s [-d directory] [-t threads] [-n transactions per thread] [-b transactions per call]\n"
+           "        [-a accounts of each kind] [-m approve,low balance,blocked,unknown percent] [-s]\n"
+           "        [-p | -w shard workers] [-r percent of calls retried]\n"
+           " Runs in a new directory under /tmp unless -d names one, a daemon build must name the daemon directory.\n"
+           " -s times the stages of the server and prints them after the run.\n"
+           " -w opens the server with this many shards, each authorized by a worker pinned to a core.\n"
+           " -p opens the server unsharded, authorizing in a pipeline of lookup, check, persist and apply stages.\n"
+           " -r submits this percent of the calls twice, the retry must get the answers of the first submission.\n",
+           program);
+
+    return 2;
+}
+
+int main(int argc, char *argv[])
+{
+    uint8_t Loc_Directory[] = "/tmp/vbs-load-XXXXXX";
+    uint8_t *Loc_Path = NULL;
+    uint32_t Loc_Sum;
+    int Loc_Option, Loc_Status = 0;
+
+    /* Loop: Until all options are read */
+    while (Loc_Status == 0 && (Loc_Option = getopt(argc, argv, "d:t:n:b:a:m:spw:r:")) != -1)
+    {
+        /* Check: Option and its value */
+        if (Loc_Option == 'd')
+        {
+            Loc_Path = optarg;
+        }
+        else if (Loc_Option == 't')
+        {
+            Glb_Threads = strtoul(optarg, NULL, 10);
+        }
+        else if (Loc_Option == 'n')
+        {
+            Glb_Transactions = strtoul(optarg, NULL, 10);
+        }
+        else if (Loc_Option == 'b')
+        {
+            Glb_Batch = strtoul(optarg, NULL, 10);
+        }
+        else if (Loc_Option == 'a')
+        {
+            Glb_Accounts = strtoul(optarg, NULL, 10);
+        }
+        else if (Loc_Option == 'w')
+        {
+            Glb_Shards = strtoul(optarg, NULL, 10);
+        }
+        else if (Loc_Option == 'r')
+        {
+            Glb_Retries = strtoul(optarg, NULL, 10);
+        }
+        else if (Loc_Option == 's')
+        {
+            Glb_StagesFlag = FLAG_UP;
+        }
+        else if (Loc_Option == 'p')
+        {
+            Glb_PipelineFlag = FLAG_UP;
+        }
+        else if (Loc_Option == 'm')
+        {
+            Loc_Status = (sscanf(optarg, "%u,%u,%u,%u", &Glb_Mix[LOAD_APPROVE], &Glb_Mix[LOAD_LOW_BALANCE],
+                                 &Glb_Mix[LOAD_BLOCKED], &Glb_Mix[LOAD_UNKNOWN]) == LOAD_KINDS) ? 0 : 2;
+        }
+        else
+        {
+            Loc_Status = 2;
+        }
+    }
+
+    Loc_Sum = Glb_Mix[LOAD_APPROVE] + Glb_Mix[LOAD_LOW_BALANCE] + Glb_Mix[LOAD_BLOCKED] + Glb_Mix[LOAD_UNKNOWN];
+
+    /* Check 1: Options are wrong */
+    if (Loc_Status != 0 || Loc_Sum != 100 || Glb_Threads == 0 || Glb_Threads > LOAD_MAX_THREADS || Glb_Batch == 0 ||
+        Glb_Retries > 100 || Glb_Accounts == 0 || Glb_Accounts > 1000000000 || (Glb_PipelineFlag == FLAG_UP && Glb_Shards != 0))
+    {
+        return loadUsage(argv[0]);
+    }
+
+    Loc_Path = (Loc_Path == NULL) ? (uint8_t *)mkdtemp((char *)Loc_Directory) : Loc_Path;
+
+    /* Check 2: Server can't be opened, or reached */
+    if (Loc_Path == NULL || chdir(Loc_Path) != 0 ||
+        ((Glb_PipelineFlag == FLAG_UP) ? initServerPipeline() : (Glb_Shards == 0) ? initServer() : initServerShards(Glb_Shards)) != SERVER_OK)
+    {
+        printf(" Can't open server in %s\n", (Loc_Path == NULL) ? Loc_Directory : (uint8_t *)Loc_Path);
+        return 1;
+    }
+
+    printf("\n Load in %s, mix %u%% approve, %u%% low balance, %u%% blocked, %u%% unknown\n", Loc_Path,
+           Glb_Mix[LOAD_APPROVE], Glb_Mix[LOAD_LOW_BALANCE], Glb_Mix[LOAD_BLOCKED], Glb_Mix[LOAD_UNKNOWN]);
+
+    /* Check 3: Accounts can't be added */
+    if (loadAccounts() != SERVER_OK)
+    {
+        printf(" Can't add the accounts\n");
+        Loc_Status = 1;
+    }
+    else
+    {
+        Loc_Status = (loadRun() == 0) ? 0 : 1;
+    }
+
+    closeServer();
+
+    return Loc_Status;
+}
@@ -0,0 +1,294 @@
+/* Standard Library */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+
+#define STRESS_ACCOUNTS					20			/* Default accounts of a new accounts file */
+#define STRESS_MAX_THREADS				8
+#define STRESS_TRANSACTIONS_PER_THREAD	2000
+#define STRESS_AMOUNT					100			/* Cents, amounts are equal so balances are order independent */
+#define STRESS_BATCH_SIZE				500			/* Transactions per recieveTransactionBatch call */
+
+typedef struct ST_stressWorker_t
+{
+	pthread_t thread;
+	uint32_t first;							/* First account of the worker */
+	uint32_t step;							/* Distance between accounts of the worker */
+	uint32_t batch;							/* Transactions per call, 1 calls recieveTransactionData */
+	uint32_t approved;
+	uint32_t failed;
+}ST_stressWorker_t;
+
+static ST_accountsDB_t Glb_Accounts[STRESS_ACCOUNTS];
+static sint64_t Glb_ExpectedBalances[STRESS_ACCOUNTS];
+static uint32_t Glb_ExpectedTransactions[STRESS_ACCOUNTS];
+static uint32_t Glb_ExpectedApproved;
+
+/*
+ Name: stressWorker
+ Input: Pointer to Worker structure
+ Output: NULL
+ Description: Static Function to run the transactions of one worker, cycling over the accounts
+              first, first + step, first + 2 * step, ... and wrapping around to first % step.
+*/
+static void *stressWorker(void *argument)
+{
+    ST_stressWorker_t *Loc_Worker = argument;
+    ST_transaction_t *Loc_Transactions = calloc(Loc_Worker->batch, sizeof(ST_transaction_t));
+    EN_transState_t *Loc_States = calloc(Loc_Worker->batch, sizeof(EN_transState_t));
+    uint32_t Loc_Account = Loc_Worker->first;
+
+    /* Loop: Until all transactions of the worker are done, one call at a time */
+    for (uint32_t Loc_Count = 0; Loc_Count < STRESS_TRANSACTIONS_PER_THREAD; Loc_Count += Loc_Worker->batch)
+    {
+        /* Loop: Until the transactions of the call are built */
+        for (uint32_t Loc_Index = 0; Loc_Index < Loc_Worker->batch; Loc_Index++)
+        {
+            strcpy(Loc_Transactions[Loc_Index].cardHolderData.primaryAccountNumber, Glb_Accounts[Loc_Account].primaryAccountNumber);
+            strcpy(Loc_Transactions[Loc_Index].terminalData.transactionDate, "17/10/2026");
+            Loc_Transactions[Loc_Index].terminalData.maxTransAmount = TERMINAL_MAX_AMOUNT;
+            Loc_Transactions[Loc_Index].terminalData.transAmount    = STRESS_AMOUNT;
+
+            Loc_Account += Loc_Worker->step;
+            Loc_Account  = (Loc_Account >= STRESS_ACCOUNTS) ? Loc_Worker->first % Loc_Worker->step : Loc_Account;
+        }
+
+        /* Check: Single transaction calls */
+        if (Loc_Worker->batch == 1)
+        {
+            Loc_States[0] = recieveTransactionData(&Loc_Transactions[0]);
+        }
+        else
+        {
+            recieveTransactionBatch(Loc_Transactions, Loc_Worker->batch, Loc_States);
+        }
+
+        /* Loop: Until the results of the call are counted */
+        for (uint32_t Loc_Index = 0; Loc_Index < Loc_Worker->batch; Loc_Index++)
+        {
+            Loc_Worker->approved += (Loc_States[Loc_Index] == APPROVED);
+            Loc_Worker->failed   += (Loc_States[Loc_Index] == INTERNAL_SERVER_ERROR);
+        }
+    }
+
+    free(Loc_Transactions);
+    free(Loc_States);
+
+    return NULL;
+}
+
+/*
+ Name: expectTransactions
+ Input: uint32_t First account, uint32_t Step between accounts
+ Output: void
+ Description: Static Function to replay the transactions of one worker on the expected balances. All amounts are
+              the same, so the final balance of an account does not depend on how workers interleave.
+*/
+static void expectTransactions(uint32_t first, uint32_t step)
+{
+    uint32_t Loc_Account = first;
+
+    /* Loop: Until all transactions of the worker are replayed */
+    for (uint32_t Loc_Count = 0; Loc_Count < STRESS_TRANSACTIONS_PER_THREAD; Loc_Count++)
+    {
+        /* Check: Account is running and Amount is available */
+        if (Glb_Accounts[Loc_Account].state == RUNNING && STRESS_AMOUNT <= Glb_ExpectedBalances[Loc_Account])
+        {
+            Glb_ExpectedBalances[Loc_Account] -= STRESS_AMOUNT;
+            Glb_ExpectedApproved++;
+        }
+        Glb_ExpectedTransactions[Loc_Account]++;
+
+        Loc_Account += step;
+        Loc_Account  = (Loc_Account >= STRESS_ACCOUNTS) ? first % step : Loc_Account;
+    }
+}
+
+/*
+ Name: stressRun
+ Input: uint32_t Number of threads, EN_flagState_t Shared accounts flag, uint32_t Transactions per call
+ Output: uint32_t Number of wrong balances or counts
+ Description: Static Function to run all workers at once and check every balance is exactly the expected one.
+              With shared accounts flag down worker i uses accounts i, i + threads, ..., so workers never touch
+              the same account, with the flag up every worker cycles over all accounts.
+*/
+static uint32_t stressRun(uint32_t threads, EN_flagState_t sharedFlag, uint32_t batch)
+{
+    ST_stressWorker_t Loc_Workers[STRESS_MAX_THREADS];
+    struct timespec Loc_Start, Loc_End;
+    uint32_t Loc_Approved = 0, Loc_Failed = 0, Loc_Errors = 0;
+    float64_t Loc_Seconds;
+    sint64_t Loc_ExpectedTotal = 0;
+    ST_accountsDB_t Loc_Account;
+
+    memset(Loc_Workers, 0, sizeof(Loc_Workers));
+
+    /* Loop: Until all workers are planned */
+    for (uint32_t Loc_Thread = 0; Loc_Thread < threads; Loc_Thread++)
+    {
+        Loc_Workers[Loc_Thread].first = (sharedFlag == FLAG_UP) ? (Loc_Thread * 7) % STRESS_ACCOUNTS : Loc_Thread;
+        Loc_Workers[Loc_Thread].step  = (sharedFlag == FLAG_UP) ? 1 : threads;
+        Loc_Workers[Loc_Thread].batch = batch;
+
+        expectTransactions(Loc_Workers[Loc_Thread].first, Loc_Workers[Loc_Thread].step);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+    for (uint32_t Loc_Thread = 0; Loc_Thread < threads; Loc_Thread++)
+    {
+        pthread_create(&Loc_Workers[Loc_Thread].thread, NULL, stressWorker, &Loc_Workers[Loc_Thread]);
+    }
+    for (uint32_t Loc_Thread = 0; Loc_Thread < threads; Loc_Thread++)
+    {
+        pthread_join(Loc_Workers[Loc_Thread].thread, NULL);
+
+        Loc_Approved += Loc_Workers[Loc_Thread].approved;
+        Loc_Failed   += Loc_Workers[Loc_Thread].failed;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+    Loc_Seconds = (Loc_End.tv_sec - Loc_Start.tv_sec) + (Loc_End.tv_nsec - Loc_Start.tv_nsec) / 1e9;
+
+    /* Loop: Until all balances are checked */
+    for (uint32_t Loc_Index = 0; Loc_Index < STRESS_ACCOUNTS; Loc_Index++)
+    {
+        getAccount(Loc_Index, &Loc_Account);
+        Loc_ExpectedTotal += Glb_ExpectedBalances[Loc_Index];
+
+        /* Check: Balance is not exactly the expected one */
+        if (Loc_Account.balance != Glb_ExpectedBalances[Loc_Index])
+        {
+            printf("   %s: balance %" PRId64 ", expected %" PRId64 "\n", Loc_Account.primaryAccountNumber,
+                   Loc_Account.balance, Glb_ExpectedBalances[Loc_Index]);
+            Loc_Errors++;
+        }
+    }
+
+    /* Check: Balances column scan does not add up to the expected balances */
+    if (getTotalBalance() != Loc_ExpectedTotal)
+    {
+        printf("   total balance %" PRId64 ", expected %" PRId64 "\n", getTotalBalance(), Loc_ExpectedTotal);
+        Loc_Errors++;
+    }
+
+    /* Check: Approved transactions are not exactly the expected ones */
+    if (Loc_Approved != Glb_ExpectedApproved || Loc_Failed != 0)
+    {
+        printf("   approved %u, expected %u, failed %u\n", Loc_Approved, Glb_ExpectedApproved, Loc_Failed);
+        Loc_Errors++;
+    }
+
+    Glb_ExpectedApproved = 0;
+
+    printf(" %u threads, %s accounts, %4u per call: %8.0f transactions/s, %s\n", threads, (sharedFlag == FLAG_UP) ? "shared  " : "disjoint",
+           batch, threads * STRESS_TRANSACTIONS_PER_THREAD / Loc_Seconds, (Loc_Errors == 0) ? "balances exact" : "BALANCES WRONG");
+
+    return Loc_Errors;
+}
+
+/*
+ Name: stressHistory
+ Input: void
+ Output: uint32_t Number of wrong account histories
+ Description: Static Function to list all transactions of every account through its history chain and check the
+              list holds every transaction of the account, newest first, and no transaction of another account.
+*/
+static uint32_t stressHistory(void)
+{
+    uint32_t Loc_Total = 0, Loc_Count, Loc_Errors = 0;
+    ST_transaction_t *Loc_History;
+    ST_cardData_t Loc_Card;
+
+    for (uint32_t Loc_Index = 0; Loc_Index < STRESS_ACCOUNTS; Loc_Index++)
+    {
+        Loc_Total += Glb_ExpectedTransactions[Loc_Index];
+    }
+    Loc_History = malloc((Loc_Total + 1) * sizeof(ST_transaction_t));
+
+    /* Loop: Until the history of every account is checked */
+    for (uint32_t Loc_Index = 0; Loc_Index < STRESS_ACCOUNTS; Loc_Index++)
+    {
+        strcpy(Loc_Card.primaryAccountNumber, Glb_Accounts[Loc_Index].primaryAccountNumber);
+        getAccountTransactions(&Loc_Card, Loc_History, Loc_Total + 1, &Loc_Count);
+
+        /* Check: Not every transaction of the account is listed */
+        if (Loc_Count != Glb_ExpectedTransactions[Loc_Index])
+        {
+            printf("   %s: %u transactions listed, expected %u\n", Loc_Card.primaryAccountNumber, Loc_Count,
+                   Glb_ExpectedTransactions[Loc_Index]);
+            Loc_Errors++;
+        }
+
+        /* Loop: Until every listed transaction is checked, or one is out of the chain */
+        for (uint32_t Loc_Item = 0; Loc_Item < Loc_Count; Loc_Item++)
+        {
+            /* Check: Transaction of another account, or not newest first */
+            if (strcmp(Loc_History[Loc_Item].cardHolderData.primaryAccountNumber, Loc_Card.primaryAccountNumber) != 0 ||
+                (Loc_Item > 0 && Loc_History[Loc_Item].transactionSequenceNumber >= Loc_History[Loc_Item - 1].transactionSequenceNumber))
+            {
+                printf("   %s: transaction %u out of chain\n", Loc_Card.primaryAccountNumber, Loc_History[Loc_Item].transactionSequenceNumber);
+                Loc_Errors++;
+                Loc_Item = Loc_Count;
+            }
+        }
+    }
+
+    free(Loc_History);
+
+    printf(" %u transactions listed by account history, %s\n", Loc_Total, (Loc_Errors == 0) ? "histories exact" : "HISTORIES WRONG");
+
+    return Loc_Errors;
+}
+
+int main(void)
+{
+    uint8_t Loc_Directory[] = "/tmp/vbs-stress-XXXXXX";
+    uint32_t Loc_Errors = 0;
+
+    /* Run on new accounts and log files, away from the ones of the application */
+    if (mkdtemp(Loc_Directory) == NULL || chdir(Loc_Directory) != 0 || initServer() != SERVER_OK)
+    {
+        printf(" Can't open server in %s\n", Loc_Directory);
+        return 1;
+    }
+
+    /* Loop: Over all default accounts */
+    for (uint32_t Loc_Index = 0; Loc_Index < STRESS_ACCOUNTS; Loc_Index++)
+    {
+        getAccount(Loc_Index, &Glb_Accounts[Loc_Index]);
+        Glb_ExpectedBalances[Loc_Index] = Glb_Accounts[Loc_Index].balance;
+    }
+
+    printf("\n recieveTransactionData: %u transactions per thread, log synced on every commit (%s)\n\n",
+           (uint32_t)STRESS_TRANSACTIONS_PER_THREAD, Loc_Directory);
+
+    /* Loop: 1, 2, 4, ... threads */
+    for (uint32_t Loc_Threads = 1; Loc_Threads <= STRESS_MAX_THREADS; Loc_Threads *= 2)
+    {
+        Loc_Errors += stressRun(Loc_Threads, FLAG_DOWN, 1);
+    }
+    Loc_Errors += stressRun(STRESS_MAX_THREADS, FLAG_UP, 1);
+
+    /* Same transactions through recieveTransactionBatch */
+    Loc_Errors += stressRun(1, FLAG_DOWN, STRESS_BATCH_SIZE);
+    Loc_Errors += stressRun(STRESS_MAX_THREADS, FLAG_UP, STRESS_BATCH_SIZE);
+
+    /* Every transaction above, listed account by account */
+    Loc_Errors += stressHistory();
+
+    closeServer();
+
+    return (Loc_Errors == 0) ? 0 : 1;
+}
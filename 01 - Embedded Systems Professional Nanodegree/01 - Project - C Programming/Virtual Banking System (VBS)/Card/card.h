@@ -1,24 +1,32 @@
-#ifndef CARD_H_
-#define CARD_H_
-
-/* Library Module */
-#include "../Library/standard_types.h"
-
-typedef struct ST_cardData_t
-{
-	uint8_t cardHolderName[25];
-	uint8_t primaryAccountNumber[20];
-	uint8_t cardExpirationDate[6];
-}ST_cardData_t;
-
-typedef enum EN_cardError_t
-{
-	CARD_OK, WRONG_NAME, WRONG_EXP_DATE, WRONG_PAN
-}EN_cardError_t;
-
-/* Functions' Prototypes */
-EN_cardError_t getCardHolderName(ST_cardData_t* cardData);
-EN_cardError_t getCardExpiryDate(ST_cardData_t* cardData);
-EN_cardError_t getCardPAN(ST_cardData_t* cardData);
-
+#ifndef CARD_H_
+#define CARD_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+typedef struct ST_cardData_t
+{
+	uint8_t cardHolderName[25];
+	uint8_t primaryAccountNumber[20];
+	uint8_t cardExpirationDate[6];
+}ST_cardData_t;
+
+typedef struct ST_panKey_t
+{
+	uint64_t number;						/* PAN digits as one number, 19 digits fit in 64 bits */
+	uint64_t length;						/* Number of digits, keeps leading zeros apart */
+}ST_panKey_t;
+
+typedef enum EN_cardError_t
+{
+	CARD_OK, WRONG_NAME, WRONG_EXP_DATE, WRONG_PAN
+}EN_cardError_t;
+
+/* Functions' Prototypes */
+EN_cardError_t getCardHolderName(ST_cardData_t* cardData);
+EN_cardError_t getCardExpiryDate(ST_cardData_t* cardData);
+EN_cardError_t getCardPAN(ST_cardData_t* cardData);
+EN_cardError_t packCardPAN(uint8_t* primaryAccountNumber, ST_panKey_t* panKey);
+void unpackCardPAN(ST_panKey_t* panKey, uint8_t* primaryAccountNumber);
+
 #endif /* CARD_H_ */
\ No newline at end of file
@@ -0,0 +1,614 @@
+/* Standard Library */
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Protocol Module */
+#include "../Protocol/protocol.h"
+
+/* Server Connection, one per thread, so terminals may call the server from many threads as when it is linked in */
+static __thread sint32_t Glb_ServerSocket = -1;
+static __thread uint8_t Glb_Request[PROTOCOL_REQUEST_SIZE];
+static __thread uint8_t *Glb_Answer;
+static __thread uint32_t Glb_AnswerCapacity;
+
+/*
+ Name: clientConnect
+ Input: void
+ Output: EN_flagState_t Connected flag
+ Description: Static Function to connect the calling thread to the server daemon, if it is not connected yet.
+*/
+static EN_flagState_t clientConnect(void)
+{
+    struct sockaddr_un Loc_Address = {0};
+
+    /* Check: Thread is not connected */
+    if (Glb_ServerSocket < 0)
+    {
+        Loc_Address.sun_family = AF_UNIX;
+        strncpy(Loc_Address.sun_path, PROTOCOL_SOCKET_FILE, sizeof(Loc_Address.sun_path) - 1);
+
+        Glb_ServerSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+        /* Check: Socket can't connect to the daemon */
+        if (Glb_ServerSocket >= 0 && connect(Glb_ServerSocket, (struct sockaddr *)&Loc_Address, sizeof(Loc_Address)) != 0)
+        {
+            close(Glb_ServerSocket);
+            Glb_ServerSocket = -1;
+        }
+    }
+
+    return (Glb_ServerSocket < 0) ? FLAG_DOWN : FLAG_UP;
+}
+
+/*
+ Name: clientTransfer
+ Input: Pointer to Buffer, uint32_t Number of bytes, EN_flagState_t Send flag
+ Output: EN_flagState_t Transferred flag
+ Description: Static Function to send, or receive, exactly size bytes on the server connection.
+*/
+static EN_flagState_t clientTransfer(uint8_t *buffer, uint32_t size, EN_flagState_t sendFlag)
+{
+    uint32_t Loc_Done = 0;
+    ssize_t Loc_Count = 1;
+
+    /* Loop: Until all bytes are transferred, or the connection fails */
+    while (Loc_Done < size && (Loc_Count > 0 || (Loc_Count < 0 && errno == EINTR)))
+    {
+        Loc_Count = (sendFlag == FLAG_UP) ? send(Glb_ServerSocket, &buffer[Loc_Done], size - Loc_Done, MSG_NOSIGNAL) :
+                                            recv(Glb_ServerSocket, &buffer[Loc_Done], size - Loc_Done, 0);
+        Loc_Done += (Loc_Count > 0) ? Loc_Count : 0;
+    }
+
+    return (Loc_Done == size) ? FLAG_UP : FLAG_DOWN;
+}
+
+/*
+ Name: clientCall
+ Input: uint8_t Request, uint32_t Request data size, Pointer to Answer data size, Pointer to Server error
+ Output: EN_flagState_t Answered flag
+ Description: Static Function to send the request whose data is in Glb_Request after the frame header and wait for
+              its answer, whose data is left in Glb_Answer. If the daemon can't be reached the connection is
+              closed, it is opened again by the next call.
+*/
+static EN_flagState_t clientCall(uint8_t request, uint32_t size, uint32_t *answerSize, EN_serverError_t *error)
+{
+    /* Define local variable to set the answered flag, Not Answered */
+    EN_flagState_t Loc_AnsweredFlag = FLAG_DOWN;
+    uint8_t Loc_Header[PROTOCOL_HEADER_SIZE];
+    uint8_t *Loc_Answer;
+    uint32_t Loc_Length = 0;
+
+    protocolPutNumber(Glb_Request, size + 1, 4);
+    Glb_Request[4] = request;
+
+    /* Check 1: Request is sent and the answer header is received */
+    if (clientConnect() == FLAG_UP &&
+        clientTransfer(Glb_Request, PROTOCOL_HEADER_SIZE + size, FLAG_UP) == FLAG_UP &&
+        clientTransfer(Loc_Header, PROTOCOL_HEADER_SIZE, FLAG_DOWN) == FLAG_UP &&
+        (Loc_Length = (uint32_t)protocolGetNumber(Loc_Header, 4)) > 0)
+    {
+        /* Check 1.1: Answer data is larger than the answer buffer, grow it */
+        if (Loc_Length - 1 > Glb_AnswerCapacity)
+        {
+            Loc_Answer = realloc(Glb_Answer, Loc_Length - 1);
+
+            /* Check 1.1.1: Answer buffer is grown */
+            if (Loc_Answer != NULL)
+            {
+                Glb_Answer         = Loc_Answer;
+                Glb_AnswerCapacity = Loc_Length - 1;
+            }
+        }
+
+        /* Check 1.2: Answer data fits and is received */
+        if (Loc_Length - 1 <= Glb_AnswerCapacity && clientTransfer(Glb_Answer, Loc_Length - 1, FLAG_DOWN) == FLAG_UP)
+        {
+            *answerSize = Loc_Length - 1;
+            *error      = Loc_Header[4];
+
+            Loc_AnsweredFlag = FLAG_UP;
+        }
+    }
+
+    /* Check 2: Daemon can't be reached, or the connection failed in the middle of the call */
+    if (Loc_AnsweredFlag == FLAG_DOWN && Glb_ServerSocket >= 0)
+    {
+        close(Glb_ServerSocket);
+        Glb_ServerSocket = -1;
+    }
+
+    return Loc_AnsweredFlag;
+}
+
+/*
+ Name: initServer
+ Input: void
+ Output: EN_serverError_t Error or No Error
+ Description: 1. This function connects the calling thread to the server daemon on PROTOCOL_SOCKET_FILE, the daemon
+                 owns the server databases. Other threads connect on their first call.
+              2. If the daemon can't be reached will return INIT_FAILED, else return SERVER_OK.
+*/
+EN_serverError_t initServer(void)
+{
+    return (clientConnect() == FLAG_UP) ? SERVER_OK : INIT_FAILED;
+}
+
+/*
+ Name: initServerShards
+ Input: uint32_t Number of shards
+ Output: EN_serverError_t Error or No Error
+ Description: This function connects like initServer and sends the number of shards to the daemon, which is
+              started with its own. If the daemon can't be reached, or runs another number of shards, will return
+              INIT_FAILED, else will return SERVER_OK.
+*/
+EN_serverError_t initServerShards(uint32_t shardCount)
+{
+    uint32_t Loc_Size = 0;
+    EN_serverError_t Loc_Error = INIT_FAILED;
+
+    protocolPutNumber(&Glb_Request[PROTOCOL_HEADER_SIZE], shardCount, 4);
+
+    return (clientCall(REQUEST_SHARD_COUNT, 4, &Loc_Size, &Loc_Error) == FLAG_UP && Loc_Error == SERVER_OK) ? SERVER_OK : INIT_FAILED;
+}
+
+/*
+ Name: initServerPipeline
+ Input: void
+ Output: EN_serverError_t Error or No Error
+ Description: This function connects like initServer, the daemon is started pipelined or not.
+*/
+EN_serverError_t initServerPipeline(void)
+{
+    return initServer();
+}
+
+/*
+ Name: closeServer
+ Input: void
+ Output: void
+ Description: This function closes the server connection of the calling thread, the daemon keeps running.
+*/
+void closeServer(void)
+{
+    /* Check: Thread is connected */
+    if (Glb_ServerSocket >= 0)
+    {
+        close(Glb_ServerSocket);
+        Glb_ServerSocket = -1;
+    }
+
+    free(Glb_Answer);
+    Glb_Answer         = NULL;
+    Glb_AnswerCapacity = 0;
+}
+
+/*
+ Name: recieveTransactionData
+ Input: Pointer to Transaction structure
+ Output: EN_transState_t Transaction State
+ Description: 1. This function sends a transaction to the server daemon to be authorized as by the linked in
+                 server, and sets its state and sequence number from the answer.
+              2. If the daemon can't be reached will return INTERNAL_SERVER_ERROR.
+*/
+EN_transState_t recieveTransactionData(ST_transaction_t *transData)
+{
+    uint32_t Loc_Size = 0;
+    EN_serverError_t Loc_Error;
+
+    transData->transState = INTERNAL_SERVER_ERROR;
+
+    /* Check: Daemon answered the state and sequence number */
+    if (clientCall(REQUEST_TRANSACTION, protocolPutTransaction(&Glb_Request[PROTOCOL_HEADER_SIZE], transData), &Loc_Size, &Loc_Error) == FLAG_UP &&
+        Loc_Size == 5)
+    {
+        transData->transState                = Glb_Answer[0];
+        transData->transactionSequenceNumber = (uint32_t)protocolGetNumber(&Glb_Answer[1], 4);
+    }
+
+    return transData->transState;
+}
+
+/*
+ Name: recieveTransactionBatch
+ Input: Pointer to Transactions, uint32_t Number of transactions, Pointer to Transaction States
+ Output: void
+ Description: 1. This function sends a batch of transactions to the server daemon, PROTOCOL_BATCH_TRANSACTIONS per
+                 request, and returns the state of every transaction.
+              2. Transactions the daemon didn't answer are INTERNAL_SERVER_ERROR.
+*/
+void recieveTransactionBatch(ST_transaction_t *transData, uint32_t count, EN_transState_t *transStates)
+{
+    uint32_t Loc_Chunk, Loc_Size = 0;
+    EN_serverError_t Loc_Error;
+
+    /* Loop: Until all chunks are sent */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index += Loc_Chunk)
+    {
+        Loc_Chunk = (count - Loc_Index < PROTOCOL_BATCH_TRANSACTIONS) ? count - Loc_Index : PROTOCOL_BATCH_TRANSACTIONS;
+        Loc_Size  = PROTOCOL_HEADER_SIZE + 2;
+        protocolPutNumber(&Glb_Request[PROTOCOL_HEADER_SIZE], Loc_Chunk, 2);
+
+        /* Loop: Until all transactions of the chunk are written */
+        for (uint32_t Loc_Item = 0; Loc_Item < Loc_Chunk; Loc_Item++)
+        {
+            transData[Loc_Index + Loc_Item].transState = INTERNAL_SERVER_ERROR;
+            transStates[Loc_Index + Loc_Item]          = INTERNAL_SERVER_ERROR;
+
+            Loc_Size += protocolPutTransaction(&Glb_Request[Loc_Size], &transData[Loc_Index + Loc_Item]);
+        }
+
+        /* Check: Daemon answered the state and sequence number of every transaction of the chunk */
+        if (clientCall(REQUEST_TRANSACTION_BATCH, Loc_Size - PROTOCOL_HEADER_SIZE, &Loc_Size, &Loc_Error) == FLAG_UP && Loc_Size == 5 * Loc_Chunk)
+        {
+            /* Loop: Until all answers of the chunk are read */
+            for (uint32_t Loc_Item = 0; Loc_Item < Loc_Chunk; Loc_Item++)
+            {
+                transData[Loc_Index + Loc_Item].transState                = Glb_Answer[5 * Loc_Item];
+                transData[Loc_Index + Loc_Item].transactionSequenceNumber = (uint32_t)protocolGetNumber(&Glb_Answer[5 * Loc_Item + 1], 4);
+                transStates[Loc_Index + Loc_Item] = transData[Loc_Index + Loc_Item].transState;
+            }
+        }
+    }
+}
+
+/*
+ Name: isValidAccount
+ Input: Pointer to Card Data structure, Pointer to Account
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function asks the server daemon for the account of a card.
+              2. If the PAN doesn't exist, or the daemon can't be reached, will return ACCOUNT_NOT_FOUND, else will
+                 return SERVER_OK and a copy of the account.
+*/
+EN_serverError_t isValidAccount(ST_cardData_t *cardData, ST_accountsDB_t *accountRefrence)
+{
+    /* Define local variable to set the error state, Account Not Found */
+    EN_serverError_t Loc_ErrorState = ACCOUNT_NOT_FOUND;
+    uint32_t Loc_Size = 0;
+
+    /* Check: Daemon answered the account */
+    if (clientCall(REQUEST_VALID_ACCOUNT, protocolPutCard(&Glb_Request[PROTOCOL_HEADER_SIZE], cardData), &Loc_Size, &Loc_ErrorState) == FLAG_UP &&
+        Loc_ErrorState == SERVER_OK && protocolGetAccount(Glb_Answer, Loc_Size, accountRefrence) != Loc_Size)
+    {
+        /* Update error state, Account Not Found! */
+        Loc_ErrorState = ACCOUNT_NOT_FOUND;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: isBlockedAccount
+ Input: Pointer to Account
+ Output: EN_sreverError_t Error or No Error
+ Description: This function checks the copy of an account, if the account is blocked will return BLOCKED_ACCOUNT,
+              else will return SERVER_OK.
+*/
+EN_serverError_t isBlockedAccount(ST_accountsDB_t *accountRefrence)
+{
+    return (accountRefrence->state == BLOCKED) ? BLOCKED_ACCOUNT : SERVER_OK;
+}
+
+/*
+ Name: isAmountAvailable
+ Input: Pointer to Terminal Data structure, Pointer to Account
+ Output: EN_sreverError_t Error or No Error
+ Description: This function checks the copy of an account, if the transaction amount is greater than its balance
+              will return LOW_BALANCE, else will return SERVER_OK.
+*/
+EN_serverError_t isAmountAvailable(ST_terminalData_t *termData, ST_accountsDB_t *accountRefrence)
+{
+    return (termData->transAmount > accountRefrence->balance) ? LOW_BALANCE : SERVER_OK;
+}
+
+/*
+ Name: saveTransaction
+ Input: Pointer to Transaction structure
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function sends a transaction to the server daemon to be saved as it is, and sets its sequence
+                 number from the answer.
+              2. If the transaction can't be saved, or the daemon can't be reached, will return SAVING_FAILED, else
+                 will return SERVER_OK.
+*/
+EN_serverError_t saveTransaction(ST_transaction_t *transData)
+{
+    /* Define local variable to set the error state, Saving Failed */
+    EN_serverError_t Loc_ErrorState = SAVING_FAILED;
+    uint32_t Loc_Size = 0;
+
+    /* Check 1: Daemon answered */
+    if (clientCall(REQUEST_SAVE_TRANSACTION, protocolPutTransaction(&Glb_Request[PROTOCOL_HEADER_SIZE], transData), &Loc_Size, &Loc_ErrorState) == FLAG_UP &&
+        Loc_Size == 4)
+    {
+        /* Check 1.1: Transaction is saved */
+        if (Loc_ErrorState == SERVER_OK)
+        {
+            transData->transactionSequenceNumber = (uint32_t)protocolGetNumber(Glb_Answer, 4);
+        }
+    }
+    else
+    {
+        /* Update error state, Saving Failed! */
+        Loc_ErrorState = SAVING_FAILED;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: getTransaction
+ Input: uint32_t Transaction Number, Pointer to Transaction structure
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function asks the server daemon for the transaction of a sequence number.
+              2. If the transaction is not found, or the daemon can't be reached, will return TRANSACTION_NOT_FOUND,
+                 else return transaction data as well as SERVER_OK.
+*/
+EN_serverError_t getTransaction(uint32_t transactionSequenceNumber, ST_transaction_t *transData)
+{
+    /* Define local variable to set the error state, Transaction Not Found */
+    EN_serverError_t Loc_ErrorState = TRANSACTION_NOT_FOUND;
+    uint32_t Loc_Size = 0;
+
+    protocolPutNumber(&Glb_Request[PROTOCOL_HEADER_SIZE], transactionSequenceNumber, 4);
+
+    /* Check: Daemon answered the transaction */
+    if (clientCall(REQUEST_GET_TRANSACTION, 4, &Loc_Size, &Loc_ErrorState) == FLAG_DOWN ||
+        (Loc_ErrorState == SERVER_OK && (Loc_Size == 0 || protocolGetTransaction(Glb_Answer, Loc_Size, transData) != Loc_Size)))
+    {
+        /* Update error state, Transaction Not Found! */
+        Loc_ErrorState = TRANSACTION_NOT_FOUND;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: clientList
+ Input: uint32_t Answer data size, Pointer to Transactions, uint32_t Maximum number of transactions,
+        Pointer to uint32_t Number of transactions
+ Output: EN_flagState_t Read flag
+ Description: Static Function to read the transactions of a history or dates answer, at most maxCount of them.
+*/
+static EN_flagState_t clientList(uint32_t size, ST_transaction_t *transData, uint32_t maxCount, uint32_t *count)
+{
+    uint32_t Loc_Read = 4, Loc_Field = 1;
+    uint32_t Loc_Count = (size >= 4) ? (uint32_t)protocolGetNumber(Glb_Answer, 4) : 0;
+
+    /* Loop: Until all transactions are read, or one is malformed */
+    while (*count < Loc_Count && *count < maxCount && Loc_Field > 0)
+    {
+        Loc_Field = protocolGetTransaction(&Glb_Answer[Loc_Read], size - Loc_Read, &transData[*count]);
+        Loc_Read += Loc_Field;
+        *count   += (Loc_Field > 0);
+    }
+
+    return (size >= 4 && Loc_Read == size) ? FLAG_UP : FLAG_DOWN;
+}
+
+/*
+ Name: getAccountTransactions
+ Input: Pointer to Card Data structure, Pointer to Transactions, uint32_t Maximum number of transactions,
+        Pointer to uint32_t Number of transactions
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function asks the server daemon for the last transactions of the account of a card, newest
+                 first, at most maxCount and at most PROTOCOL_LIST_TRANSACTIONS of them.
+              2. If the PAN doesn't exist, or the daemon can't be reached, will return ACCOUNT_NOT_FOUND, else will
+                 return SERVER_OK and the number of transactions returned.
+*/
+EN_serverError_t getAccountTransactions(ST_cardData_t *cardData, ST_transaction_t *transData, uint32_t maxCount, uint32_t *count)
+{
+    /* Define local variable to set the error state, Account Not Found */
+    EN_serverError_t Loc_ErrorState = ACCOUNT_NOT_FOUND;
+    uint32_t Loc_Size = protocolPutCard(&Glb_Request[PROTOCOL_HEADER_SIZE], cardData);
+
+    *count = 0;
+    protocolPutNumber(&Glb_Request[PROTOCOL_HEADER_SIZE + Loc_Size], maxCount, 4);
+
+    /* Check: Daemon answered the transactions */
+    if (clientCall(REQUEST_ACCOUNT_TRANSACTIONS, Loc_Size + 4, &Loc_Size, &Loc_ErrorState) == FLAG_DOWN ||
+        clientList(Loc_Size, transData, maxCount, count) == FLAG_DOWN)
+    {
+        /* Update error state, Account Not Found! */
+        Loc_ErrorState = ACCOUNT_NOT_FOUND;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: getTransactionsByDate
+ Input: Pointer to first date string, Pointer to last date string, uint32_t States wanted, Pointer to Transactions,
+        uint32_t Maximum number of transactions, Pointer to uint32_t Number of transactions
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function asks the server daemon for the transactions from the first date to the last date
+                 whose state is wanted, oldest first, at most maxCount and at most PROTOCOL_LIST_TRANSACTIONS of them.
+              2. If a date is wrong, or the daemon can't be reached, will return TRANSACTION_NOT_FOUND, else return
+                 SERVER_OK and the number of transactions returned.
+*/
+EN_serverError_t getTransactionsByDate(uint8_t *fromDate, uint8_t *toDate, uint32_t transStates, ST_transaction_t *transData,
+                                       uint32_t maxCount, uint32_t *count)
+{
+    /* Define local variable to set the error state, Transaction Not Found */
+    EN_serverError_t Loc_ErrorState = TRANSACTION_NOT_FOUND;
+    uint32_t Loc_Size = PROTOCOL_HEADER_SIZE;
+
+    *count = 0;
+
+    Loc_Size += protocolPutString(&Glb_Request[Loc_Size], fromDate, PROTOCOL_DATE_SIZE);
+    Loc_Size += protocolPutString(&Glb_Request[Loc_Size], toDate, PROTOCOL_DATE_SIZE);
+    protocolPutNumber(&Glb_Request[Loc_Size], transStates, 4);
+    protocolPutNumber(&Glb_Request[Loc_Size + 4], maxCount, 4);
+
+    /* Check: Daemon answered the transactions */
+    if (clientCall(REQUEST_TRANSACTIONS_BY_DATE, Loc_Size + 8 - PROTOCOL_HEADER_SIZE, &Loc_Size, &Loc_ErrorState) == FLAG_DOWN ||
+        clientList(Loc_Size, transData, maxCount, count) == FLAG_DOWN)
+    {
+        /* Update error state, Transaction Not Found! */
+        Loc_ErrorState = TRANSACTION_NOT_FOUND;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: getAccount
+ Input: uint32_t Account record, Pointer to Account
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function asks the server daemon for the account stored at a record number.
+              2. If there is no account at the record, or the daemon can't be reached, will return ACCOUNT_NOT_FOUND,
+                 else return SERVER_OK.
+*/
+EN_serverError_t getAccount(uint32_t record, ST_accountsDB_t *accountRefrence)
+{
+    /* Define local variable to set the error state, Account Not Found */
+    EN_serverError_t Loc_ErrorState = ACCOUNT_NOT_FOUND;
+    uint32_t Loc_Size = 0;
+
+    protocolPutNumber(&Glb_Request[PROTOCOL_HEADER_SIZE], record, 4);
+
+    /* Check: Daemon answered the account */
+    if (clientCall(REQUEST_GET_ACCOUNT, 4, &Loc_Size, &Loc_ErrorState) == FLAG_DOWN ||
+        (Loc_ErrorState == SERVER_OK && protocolGetAccount(Glb_Answer, Loc_Size, accountRefrence) != Loc_Size))
+    {
+        /* Update error state, Account Not Found! */
+        Loc_ErrorState = ACCOUNT_NOT_FOUND;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: addAccounts
+ Input: Pointer to Accounts, uint32_t Number of accounts, Pointer to uint32_t Number of accounts added
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function sends new accounts to the server daemon, PROTOCOL_BATCH_TRANSACTIONS per request, an
+                 account whose PAN already has an account is skipped.
+              2. If an account can't be added, or the daemon can't be reached, will return SAVING_FAILED, else
+                 return SERVER_OK, accounts before the failing request are added.
+*/
+EN_serverError_t addAccounts(ST_accountsDB_t *accountRefrence, uint32_t count, uint32_t *added)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    uint32_t Loc_Chunk, Loc_Size = 0;
+
+    *added = 0;
+
+    /* Loop: Until all chunks are added, or one fails */
+    for (uint32_t Loc_Index = 0; Loc_Index < count && Loc_ErrorState == SERVER_OK; Loc_Index += Loc_Chunk)
+    {
+        Loc_Chunk = (count - Loc_Index < PROTOCOL_BATCH_TRANSACTIONS) ? count - Loc_Index : PROTOCOL_BATCH_TRANSACTIONS;
+        Loc_Size  = PROTOCOL_HEADER_SIZE + 2;
+        protocolPutNumber(&Glb_Request[PROTOCOL_HEADER_SIZE], Loc_Chunk, 2);
+
+        /* Loop: Until all accounts of the chunk are written */
+        for (uint32_t Loc_Item = 0; Loc_Item < Loc_Chunk; Loc_Item++)
+        {
+            Loc_Size += protocolPutAccount(&Glb_Request[Loc_Size], &accountRefrence[Loc_Index + Loc_Item]);
+        }
+
+        /* Check: Daemon answered the number of accounts added */
+        if (clientCall(REQUEST_ADD_ACCOUNTS, Loc_Size - PROTOCOL_HEADER_SIZE, &Loc_Size, &Loc_ErrorState) == FLAG_UP && Loc_Size == 4)
+        {
+            *added += (uint32_t)protocolGetNumber(Glb_Answer, 4);
+        }
+        else
+        {
+            /* Update error state, Saving Failed! */
+            Loc_ErrorState = SAVING_FAILED;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: getTotalBalance
+ Input: void
+ Output: sint64_t Sum of all balances in cents
+ Description: This function asks the server daemon for the sum of all balances, 0 if it can't be reached.
+*/
+sint64_t getTotalBalance(void)
+{
+    uint32_t Loc_Size = 0;
+    EN_serverError_t Loc_Error;
+
+    return (clientCall(REQUEST_TOTAL_BALANCE, 0, &Loc_Size, &Loc_Error) == FLAG_UP && Loc_Size == 8) ?
+           (sint64_t)protocolGetNumber(Glb_Answer, 8) : 0;
+}
+
+/*
+ Name: getBlockedAccounts
+ Input: void
+ Output: uint32_t Number of blocked accounts
+ Description: This function asks the server daemon for the number of blocked accounts, 0 if it can't be reached.
+*/
+uint32_t getBlockedAccounts(void)
+{
+    uint32_t Loc_Size = 0;
+    EN_serverError_t Loc_Error;
+
+    return (clientCall(REQUEST_BLOCKED_ACCOUNTS, 0, &Loc_Size, &Loc_Error) == FLAG_UP && Loc_Size == 8) ?
+           (uint32_t)protocolGetNumber(Glb_Answer, 8) : 0;
+}
+
+
+/*
+ Name: setVelocityLimits
+ Input: Pointer to Velocity Limits
+ Output: void
+ Description: This function sends the velocity limits of every account to the server daemon, which sets them
+              between two rounds of transactions, as its -v option does when it starts.
+*/
+void setVelocityLimits(ST_velocityLimits_t *limits)
+{
+    uint32_t Loc_Size = 0;
+    EN_serverError_t Loc_Error;
+
+    /* Loop: Until the limits of all windows are written */
+    for (uint32_t Loc_Window = 0; Loc_Window < VELOCITY_WINDOWS; Loc_Window++)
+    {
+        protocolPutNumber(&Glb_Request[PROTOCOL_HEADER_SIZE + Loc_Window * 12], limits->maxCount[Loc_Window], 4);
+        protocolPutNumber(&Glb_Request[PROTOCOL_HEADER_SIZE + Loc_Window * 12 + 4], (uint64_t)limits->maxAmount[Loc_Window], 8);
+    }
+
+    clientCall(REQUEST_VELOCITY_LIMITS, PROTOCOL_LIMITS_SIZE, &Loc_Size, &Loc_Error);
+}
+
+/*
+ Name: setStageHistograms
+ Input: EN_flagState_t Enabled flag
+ Output: void
+ Description: This function asks the server daemon to turn timing of the stages of transactions on or off.
+*/
+void setStageHistograms(EN_flagState_t enabledFlag)
+{
+    uint32_t Loc_Size = 0;
+    EN_serverError_t Loc_Error;
+
+    Glb_Request[PROTOCOL_HEADER_SIZE] = (uint8_t)enabledFlag;
+    clientCall(REQUEST_STAGE_HISTOGRAMS, 1, &Loc_Size, &Loc_Error);
+}
+
+/*
+ Name: dumpStageHistograms
+ Input: void
+ Output: void
+ Description: This function asks the server daemon to print the stage histograms on its own output.
+*/
+void dumpStageHistograms(void)
+{
+    uint32_t Loc_Size = 0;
+    EN_serverError_t Loc_Error;
+
+    clientCall(REQUEST_DUMP_STAGES, 0, &Loc_Size, &Loc_Error);
+}
@@ -0,0 +1,1050 @@
+/* accept4 */
+#define _GNU_SOURCE
+
+/* Standard Library */
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Protocol Module */
+#include "../Protocol/protocol.h"
+/* Event Module */
+#include "../Event/event.h"
+/* Daemon Module */
+#include "daemon.h"
+
+/* Sockets, the epoll instance and the listening socket of the Unix domain socket */
+static int Glb_EventDescriptor = -1;
+static sint32_t Glb_ListenDescriptor = -1;
+/* Connections, by slot, and the free slots */
+static ST_daemonConnection_t *Glb_Connections[DAEMON_MAX_CONNECTIONS];
+static uint32_t Glb_FreeSlots[DAEMON_MAX_CONNECTIONS];
+static uint32_t Glb_FreeCount;
+/* Ready list, connections with a complete request not served yet */
+static uint32_t Glb_Ready[DAEMON_MAX_CONNECTIONS];
+static uint32_t Glb_ReadyCount;
+/* Round batch, transactions of all connections authorized with one recieveTransactionBatch call */
+static ST_transaction_t Glb_RoundTransactions[DAEMON_ROUND_TRANSACTIONS];
+static EN_transState_t Glb_RoundStates[DAEMON_ROUND_TRANSACTIONS];
+static uint32_t Glb_RoundSlots[DAEMON_ROUND_TRANSACTIONS];
+static uint32_t Glb_RoundCount;
+static uint32_t Glb_RoundConnectionCount;
+/* Transactions of one history or dates answer */
+static ST_transaction_t Glb_ListTransactions[PROTOCOL_LIST_TRANSACTIONS];
+/* Run flag, put down by SIGINT or SIGTERM */
+static volatile sig_atomic_t Glb_RunFlag = FLAG_UP;
+/* Dump flag, put up by SIGUSR1 to print the stage histograms */
+static volatile sig_atomic_t Glb_DumpFlag = FLAG_DOWN;
+/* Take over flag, put up by SIGUSR2 to turn a standby into the primary */
+static volatile sig_atomic_t Glb_TakeOverFlag = FLAG_DOWN;
+/* Shard workers the server is opened with, 0 if unsharded, clients check theirs against it */
+static uint32_t Glb_Shards = 0;
+
+/*
+ Name: daemonSignal
+ Input: int Signal number
+ Output: void
+ Description: Static Function to handle the signals of the daemon, from a signal handler. SIGINT and SIGTERM stop
+              the event loop after the current round, SIGUSR1 prints the stage histograms after it, and SIGUSR2
+              makes a standby take over at its next check.
+*/
+static void daemonSignal(int signalNumber)
+{
+    /* Check: Signal and its flag */
+    if (signalNumber == SIGUSR1)
+    {
+        Glb_DumpFlag = FLAG_UP;
+    }
+    else if (signalNumber == SIGUSR2)
+    {
+        Glb_TakeOverFlag = FLAG_UP;
+    }
+    else
+    {
+        Glb_RunFlag = FLAG_DOWN;
+    }
+}
+
+/*
+ Name: daemonBeginAnswer
+ Input: Pointer to Connection, uint32_t Largest answer data
+ Output: Pointer to the answer data, or NULL
+ Description: Static Function to make room for an answer at the end of the connection output, the answer is
+              written after its frame header and ended by daemonEndAnswer. If there is no memory the
+              connection is closed and NULL is returned.
+*/
+static uint8_t *daemonBeginAnswer(ST_daemonConnection_t *connection, uint32_t size)
+{
+    uint8_t *Loc_Output = connection->output;
+    uint32_t Loc_Capacity = connection->outputCapacity;
+
+    /* Loop: Until the answer fits the output */
+    while (connection->outputCount + PROTOCOL_HEADER_SIZE + size > Loc_Capacity)
+    {
+        Loc_Capacity = (Loc_Capacity == 0) ? PROTOCOL_REQUEST_SIZE : Loc_Capacity * 2;
+    }
+
+    /* Check: Output is too small, grow it */
+    if (Loc_Capacity != connection->outputCapacity)
+    {
+        Loc_Output = realloc(connection->output, Loc_Capacity);
+
+        /* Check: No memory for the answer */
+        if (Loc_Output == NULL)
+        {
+            connection->closedFlag = FLAG_UP;
+        }
+        else
+        {
+            connection->output         = Loc_Output;
+            connection->outputCapacity = Loc_Capacity;
+        }
+    }
+
+    return (Loc_Output == NULL) ? NULL : &Loc_Output[connection->outputCount + PROTOCOL_HEADER_SIZE];
+}
+
+/*
+ Name: daemonEndAnswer
+ Input: Pointer to Connection, EN_serverError_t Server error, uint32_t Answer data size
+ Output: void
+ Description: Static Function to write the frame header of the answer begun by daemonBeginAnswer.
+*/
+static void daemonEndAnswer(ST_daemonConnection_t *connection, EN_serverError_t error, uint32_t size)
+{
+    protocolPutNumber(&connection->output[connection->outputCount], size + 1, 4);
+    connection->output[connection->outputCount + 4] = (uint8_t)error;
+    connection->outputCount += PROTOCOL_HEADER_SIZE + size;
+}
+
+/*
+ Name: daemonPending
+ Input: Pointer to Connection
+ Output: EN_flagState_t Complete request flag
+ Description: Static Function to tell if the received bytes of a connection start with a complete request.
+*/
+static EN_flagState_t daemonPending(ST_daemonConnection_t *connection)
+{
+    return (connection->inputCount >= PROTOCOL_HEADER_SIZE &&
+            connection->inputCount >= 4 + protocolGetNumber(connection->input, 4)) ? FLAG_UP : FLAG_DOWN;
+}
+
+/*
+ Name: daemonMarkReady
+ Input: Pointer to Connection
+ Output: void
+ Description: Static Function to add a connection to the ready list, once.
+*/
+static void daemonMarkReady(ST_daemonConnection_t *connection)
+{
+    /* Check: Connection is not in the ready list */
+    if (connection->readyFlag == FLAG_DOWN)
+    {
+        connection->readyFlag = FLAG_UP;
+        Glb_Ready[Glb_ReadyCount++] = connection->slot;
+    }
+}
+
+/*
+ Name: daemonCloseConnection
+ Input: Pointer to Connection
+ Output: void
+ Description: Static Function to close a connection and free its slot, closing the socket removes it from epoll.
+              A connection in the ready list is skipped there once its slot is empty.
+*/
+static void daemonCloseConnection(ST_daemonConnection_t *connection)
+{
+    close(connection->fileDescriptor);
+
+    Glb_Connections[connection->slot] = NULL;
+    Glb_FreeSlots[Glb_FreeCount++]    = connection->slot;
+
+    free(connection->output);
+    free(connection);
+}
+
+/*
+ Name: daemonAccept
+ Input: void
+ Output: void
+ Description: Static Function to accept all waiting terminals, non blocking, a terminal is closed at once if all
+              connection slots are used.
+*/
+static void daemonAccept(void)
+{
+    ST_daemonConnection_t *Loc_Connection;
+    sint32_t Loc_Descriptor = accept4(Glb_ListenDescriptor, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    /* Loop: Until no terminal is waiting */
+    while (Loc_Descriptor >= 0)
+    {
+        Loc_Connection = (Glb_FreeCount > 0) ? calloc(1, sizeof(ST_daemonConnection_t)) : NULL;
+
+        /* Check 1: No slot or no memory for the connection */
+        if (Loc_Connection == NULL)
+        {
+            close(Loc_Descriptor);
+        }
+        /* Check 2: Connection is added to epoll */
+        else
+        {
+            Loc_Connection->fileDescriptor = Loc_Descriptor;
+            Loc_Connection->slot           = Glb_FreeSlots[--Glb_FreeCount];
+            Glb_Connections[Loc_Connection->slot] = Loc_Connection;
+
+            /* Check 2.1: Socket can't be added to epoll */
+            if (eventAdd(Glb_EventDescriptor, Loc_Descriptor, Loc_Connection->slot, EVENT_READ) != EVENT_OK)
+            {
+                daemonCloseConnection(Loc_Connection);
+            }
+        }
+
+        Loc_Descriptor = accept4(Glb_ListenDescriptor, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    }
+}
+
+/*
+ Name: daemonRead
+ Input: Pointer to Connection
+ Output: void
+ Description: Static Function to receive the bytes waiting on a connection, until its input is full. A hang up or
+              a receive error closes the connection.
+*/
+static void daemonRead(ST_daemonConnection_t *connection)
+{
+    ssize_t Loc_Received = 1;
+
+    /* Loop: Until no byte is waiting or the input is full */
+    while (Loc_Received > 0 && connection->inputCount < DAEMON_INPUT_SIZE)
+    {
+        Loc_Received = recv(connection->fileDescriptor, &connection->input[connection->inputCount],
+                            DAEMON_INPUT_SIZE - connection->inputCount, 0);
+
+        /* Check 1: Bytes are received */
+        if (Loc_Received > 0)
+        {
+            connection->inputCount += Loc_Received;
+        }
+        /* Check 2: Peer hung up, or receive failed for another reason than no byte waiting */
+        else if (Loc_Received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+        {
+            connection->closedFlag = FLAG_UP;
+        }
+    }
+}
+
+/*
+ Name: daemonFlush
+ Input: Pointer to Connection
+ Output: void
+ Description: Static Function to send the output of a connection. If the socket is full the connection waits for
+              room to write and stops reading requests, once the output is sent it reads requests again.
+*/
+static void daemonFlush(ST_daemonConnection_t *connection)
+{
+    ssize_t Loc_Sent = 1;
+
+    /* Loop: Until all output is sent or the socket is full */
+    while (Loc_Sent > 0 && connection->outputSent < connection->outputCount)
+    {
+        Loc_Sent = send(connection->fileDescriptor, &connection->output[connection->outputSent],
+                        connection->outputCount - connection->outputSent, MSG_NOSIGNAL);
+
+        /* Check 1: Bytes are sent */
+        if (Loc_Sent > 0)
+        {
+            connection->outputSent += Loc_Sent;
+        }
+        /* Check 2: Send failed for another reason than a full socket */
+        else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            connection->closedFlag = FLAG_UP;
+        }
+    }
+
+    /* Check 1: All output is sent, read requests again */
+    if (connection->closedFlag == FLAG_DOWN && connection->outputSent == connection->outputCount)
+    {
+        connection->outputCount = 0;
+        connection->outputSent  = 0;
+
+        /* Check 1.1: Connection was waiting for room to write */
+        if (connection->writingFlag == FLAG_UP)
+        {
+            connection->writingFlag = FLAG_DOWN;
+            eventModify(Glb_EventDescriptor, connection->fileDescriptor, connection->slot, EVENT_READ);
+
+            /* Check 1.1.1: Requests came before the wait */
+            if (daemonPending(connection) == FLAG_UP)
+            {
+                daemonMarkReady(connection);
+            }
+        }
+    }
+    /* Check 2: Socket is full, wait for room to write */
+    else if (connection->closedFlag == FLAG_DOWN && connection->writingFlag == FLAG_DOWN)
+    {
+        connection->writingFlag = FLAG_UP;
+        eventModify(Glb_EventDescriptor, connection->fileDescriptor, connection->slot, EVENT_WRITE);
+    }
+}
+
+/*
+ Name: daemonQueueTransactions
+ Input: Pointer to Connection, uint8_t Request, Pointer to Request data, uint32_t Request data size,
+        uint32_t Number of transactions
+ Output: EN_flagState_t Queued flag
+ Description: Static Function to add the transactions of a request to the round batch, they are answered once
+              the round is authorized. If the round has no room for them will return FLAG_DOWN and the request
+              waits for the next round. A malformed request closes the connection.
+*/
+static EN_flagState_t daemonQueueTransactions(ST_daemonConnection_t *connection, uint8_t request, uint8_t *data, uint32_t size,
+                                              uint32_t count)
+{
+    /* Define local variable to set the queued flag, Queued */
+    EN_flagState_t Loc_QueuedFlag = FLAG_UP;
+    uint32_t Loc_Read = 0, Loc_Field = 1, Loc_Index = 0;
+
+    /* Check 1: Round has no room for the transactions */
+    if (Glb_RoundCount + count > DAEMON_ROUND_TRANSACTIONS)
+    {
+        Loc_QueuedFlag = FLAG_DOWN;
+    }
+    /* Check 2: Decode the transactions after the round ones */
+    else
+    {
+        /* Loop: Until all transactions are decoded, or one is malformed */
+        while (Loc_Index < count && Loc_Field > 0)
+        {
+            Loc_Field = protocolGetTransaction(&data[Loc_Read], size - Loc_Read, &Glb_RoundTransactions[Glb_RoundCount + Loc_Index]);
+            Loc_Read += Loc_Field;
+            Loc_Index++;
+        }
+
+        /* Check 2.1: Request is malformed, or has bytes after its transactions */
+        if (count == 0 || Loc_Field == 0 || Loc_Read != size)
+        {
+            connection->closedFlag = FLAG_UP;
+        }
+        else
+        {
+            connection->roundFirst   = Glb_RoundCount;
+            connection->roundCount   = count;
+            connection->roundRequest = request;
+
+            Glb_RoundSlots[Glb_RoundConnectionCount++] = connection->slot;
+            Glb_RoundCount += count;
+        }
+    }
+
+    return Loc_QueuedFlag;
+}
+
+/*
+ Name: daemonListAnswer
+ Input: Pointer to Connection, EN_serverError_t Server error, uint32_t Number of listed transactions
+ Output: void
+ Description: Static Function to answer the number of listed transactions followed by the transactions.
+*/
+static void daemonListAnswer(ST_daemonConnection_t *connection, EN_serverError_t error, uint32_t count)
+{
+    uint8_t *Loc_Answer = daemonBeginAnswer(connection, 4 + count * PROTOCOL_TRANSACTION_SIZE);
+    uint32_t Loc_Size = 4;
+
+    /* Check: Answer has room */
+    if (Loc_Answer != NULL)
+    {
+        protocolPutNumber(Loc_Answer, count, 4);
+
+        /* Loop: Until all listed transactions are written */
+        for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+        {
+            Loc_Size += protocolPutTransaction(&Loc_Answer[Loc_Size], &Glb_ListTransactions[Loc_Index]);
+        }
+
+        daemonEndAnswer(connection, error, Loc_Size);
+    }
+}
+
+/*
+ Name: daemonRequest
+ Input: Pointer to Connection, uint8_t Request, Pointer to Request data, uint32_t Request data size
+ Output: EN_flagState_t Served flag
+ Description: Static Function to serve one request. Transactions are queued in the round batch, every other
+              request is answered at once with the server.h function of the same name. If a transaction request
+              doesn't fit the round will return FLAG_DOWN, a malformed request closes the connection.
+*/
+static EN_flagState_t daemonRequest(ST_daemonConnection_t *connection, uint8_t request, uint8_t *data, uint32_t size)
+{
+    /* Define local variable to set the served flag, Served */
+    EN_flagState_t Loc_ServedFlag = FLAG_UP;
+    EN_serverError_t Loc_Error = SERVER_OK;
+    ST_cardData_t Loc_Card;
+    ST_accountsDB_t Loc_Account, Loc_Accounts[PROTOCOL_BATCH_TRANSACTIONS];
+    ST_transaction_t Loc_Transaction;
+    ST_velocityLimits_t Loc_Limits;
+    uint8_t Loc_FromDate[PROTOCOL_DATE_SIZE], Loc_ToDate[PROTOCOL_DATE_SIZE];
+    uint32_t Loc_Read, Loc_Field, Loc_Count = 0;
+    uint8_t *Loc_Answer;
+
+    /* Check 1: One transaction, or a batch of them */
+    if (request == REQUEST_TRANSACTION || (request == REQUEST_TRANSACTION_BATCH && size >= 2))
+    {
+        Loc_Read  = (request == REQUEST_TRANSACTION) ? 0 : 2;
+        Loc_Count = (request == REQUEST_TRANSACTION) ? 1 : (uint32_t)protocolGetNumber(data, 2);
+
+        /* Check 1.1: Batch is larger than a request may be */
+        if (Loc_Count > PROTOCOL_BATCH_TRANSACTIONS)
+        {
+            connection->closedFlag = FLAG_UP;
+        }
+        else
+        {
+            Loc_ServedFlag = daemonQueueTransactions(connection, request, &data[Loc_Read], size - Loc_Read, Loc_Count);
+        }
+    }
+    /* Check 2: Account of a card */
+    else if (request == REQUEST_VALID_ACCOUNT && protocolGetCard(data, size, &Loc_Card) == size)
+    {
+        Loc_Error  = isValidAccount(&Loc_Card, &Loc_Account);
+        Loc_Answer = daemonBeginAnswer(connection, PROTOCOL_ACCOUNT_SIZE);
+
+        /* Check 2.1: Answer has room */
+        if (Loc_Answer != NULL)
+        {
+            daemonEndAnswer(connection, Loc_Error, (Loc_Error == SERVER_OK) ? protocolPutAccount(Loc_Answer, &Loc_Account) : 0);
+        }
+    }
+    /* Check 3: Save a transaction */
+    else if (request == REQUEST_SAVE_TRANSACTION && size > 0 && protocolGetTransaction(data, size, &Loc_Transaction) == size)
+    {
+        Loc_Error  = saveTransaction(&Loc_Transaction);
+        Loc_Answer = daemonBeginAnswer(connection, 4);
+
+        /* Check 3.1: Answer has room */
+        if (Loc_Answer != NULL)
+        {
+            protocolPutNumber(Loc_Answer, Loc_Transaction.transactionSequenceNumber, 4);
+            daemonEndAnswer(connection, Loc_Error, 4);
+        }
+    }
+    /* Check 4: Transaction of a sequence number */
+    else if (request == REQUEST_GET_TRANSACTION && size == 4)
+    {
+        Loc_Error  = getTransaction((uint32_t)protocolGetNumber(data, 4), &Loc_Transaction);
+        Loc_Answer = daemonBeginAnswer(connection, PROTOCOL_TRANSACTION_SIZE);
+
+        /* Check 4.1: Answer has room */
+        if (Loc_Answer != NULL)
+        {
+            daemonEndAnswer(connection, Loc_Error, (Loc_Error == SERVER_OK) ? protocolPutTransaction(Loc_Answer, &Loc_Transaction) : 0);
+        }
+    }
+    /* Check 5: Last transactions of the account of a card */
+    else if (request == REQUEST_ACCOUNT_TRANSACTIONS && (Loc_Read = protocolGetCard(data, size, &Loc_Card)) > 0 && Loc_Read + 4 == size)
+    {
+        Loc_Count = (uint32_t)protocolGetNumber(&data[Loc_Read], 4);
+        Loc_Error = getAccountTransactions(&Loc_Card, Glb_ListTransactions,
+                                           (Loc_Count < PROTOCOL_LIST_TRANSACTIONS) ? Loc_Count : PROTOCOL_LIST_TRANSACTIONS, &Loc_Count);
+        daemonListAnswer(connection, Loc_Error, Loc_Count);
+    }
+    /* Check 6: Transactions between two dates */
+    else if (request == REQUEST_TRANSACTIONS_BY_DATE && (Loc_Read = protocolGetString(data, size, Loc_FromDate, sizeof(Loc_FromDate))) > 0 &&
+             (Loc_Count = protocolGetString(&data[Loc_Read], size - Loc_Read, Loc_ToDate, sizeof(Loc_ToDate))) > 0 &&
+             Loc_Read + Loc_Count + 8 == size)
+    {
+        Loc_Read += Loc_Count;
+        Loc_Count = (uint32_t)protocolGetNumber(&data[Loc_Read + 4], 4);
+        Loc_Error = getTransactionsByDate(Loc_FromDate, Loc_ToDate, (uint32_t)protocolGetNumber(&data[Loc_Read], 4), Glb_ListTransactions,
+                                          (Loc_Count < PROTOCOL_LIST_TRANSACTIONS) ? Loc_Count : PROTOCOL_LIST_TRANSACTIONS, &Loc_Count);
+        daemonListAnswer(connection, Loc_Error, Loc_Count);
+    }
+    /* Check 7: Account of a record */
+    else if (request == REQUEST_GET_ACCOUNT && size == 4)
+    {
+        Loc_Error  = getAccount((uint32_t)protocolGetNumber(data, 4), &Loc_Account);
+        Loc_Answer = daemonBeginAnswer(connection, PROTOCOL_ACCOUNT_SIZE);
+
+        /* Check 7.1: Answer has room */
+        if (Loc_Answer != NULL)
+        {
+            daemonEndAnswer(connection, Loc_Error, (Loc_Error == SERVER_OK) ? protocolPutAccount(Loc_Answer, &Loc_Account) : 0);
+        }
+    }
+    /* Check 8: Sum of all balances, or number of blocked accounts */
+    else if ((request == REQUEST_TOTAL_BALANCE || request == REQUEST_BLOCKED_ACCOUNTS) && size == 0)
+    {
+        Loc_Answer = daemonBeginAnswer(connection, 8);
+
+        /* Check 8.1: Answer has room */
+        if (Loc_Answer != NULL)
+        {
+            protocolPutNumber(Loc_Answer, (request == REQUEST_TOTAL_BALANCE) ? (uint64_t)getTotalBalance() : getBlockedAccounts(), 8);
+            daemonEndAnswer(connection, SERVER_OK, 8);
+        }
+    }
+    /* Check 9: Add accounts */
+    else if (request == REQUEST_ADD_ACCOUNTS && size >= 2 && protocolGetNumber(data, 2) <= PROTOCOL_BATCH_TRANSACTIONS)
+    {
+        Loc_Count = (uint32_t)protocolGetNumber(data, 2);
+        Loc_Read  = 2;
+        Loc_Field = 1;
+
+        /* Loop: Until all accounts are decoded, or one is malformed */
+        for (uint32_t Loc_Index = 0; Loc_Index < Loc_Count && Loc_Field > 0; Loc_Index++)
+        {
+            Loc_Field = protocolGetAccount(&data[Loc_Read], size - Loc_Read, &Loc_Accounts[Loc_Index]);
+            Loc_Read += Loc_Field;
+        }
+
+        /* Check 9.1: Request is malformed, or has bytes after its accounts */
+        if (Loc_Field == 0 || Loc_Read != size)
+        {
+            connection->closedFlag = FLAG_UP;
+        }
+        else
+        {
+            Loc_Error  = addAccounts(Loc_Accounts, Loc_Count, &Loc_Count);
+            Loc_Answer = daemonBeginAnswer(connection, 4);
+
+            /* Check 9.1.1: Answer has room */
+            if (Loc_Answer != NULL)
+            {
+                protocolPutNumber(Loc_Answer, Loc_Count, 4);
+                daemonEndAnswer(connection, Loc_Error, 4);
+            }
+        }
+    }
+    /* Check 10: Turn stage histograms on or off, or print them on the daemon output */
+    else if ((request == REQUEST_STAGE_HISTOGRAMS && size == 1 && data[0] <= FLAG_UP) ||
+             (request == REQUEST_DUMP_STAGES && size == 0))
+    {
+        Loc_Answer = daemonBeginAnswer(connection, 0);
+
+        /* Check 10.1: Answer has room */
+        if (Loc_Answer != NULL)
+        {
+            /* Check 10.1.1: Turn stage histograms on or off */
+            if (request == REQUEST_STAGE_HISTOGRAMS)
+            {
+                setStageHistograms(data[0]);
+            }
+            else
+            {
+                dumpStageHistograms();
+            }
+
+            daemonEndAnswer(connection, SERVER_OK, 0);
+        }
+    }
+    /* Check 11: Number of shards of a client, checked against the shards of the server */
+    else if (request == REQUEST_SHARD_COUNT && size == 4)
+    {
+        Loc_Answer = daemonBeginAnswer(connection, 0);
+
+        /* Check 11.1: Answer has room */
+        if (Loc_Answer != NULL)
+        {
+            daemonEndAnswer(connection, ((uint32_t)protocolGetNumber(data, 4) == Glb_Shards) ? SERVER_OK : INIT_FAILED, 0);
+        }
+    }
+    /* Check 12: Velocity limits of every account, set between two rounds */
+    else if (request == REQUEST_VELOCITY_LIMITS && size == PROTOCOL_LIMITS_SIZE)
+    {
+        Loc_Answer = daemonBeginAnswer(connection, 0);
+
+        /* Check 12.1: Answer has room */
+        if (Loc_Answer != NULL)
+        {
+            /* Loop: Until the limits of all windows are read */
+            for (uint32_t Loc_Window = 0; Loc_Window < VELOCITY_WINDOWS; Loc_Window++)
+            {
+                Loc_Limits.maxCount[Loc_Window]  = (uint32_t)protocolGetNumber(&data[Loc_Window * 12], 4);
+                Loc_Limits.maxAmount[Loc_Window] = (sint64_t)protocolGetNumber(&data[Loc_Window * 12 + 4], 8);
+            }
+
+            setVelocityLimits(&Loc_Limits);
+            daemonEndAnswer(connection, SERVER_OK, 0);
+        }
+    }
+    /* Check 13: Unknown or malformed request */
+    else
+    {
+        connection->closedFlag = FLAG_UP;
+    }
+
+    return Loc_ServedFlag;
+}
+
+/*
+ Name: daemonServe
+ Input: Pointer to Connection
+ Output: void
+ Description: Static Function to serve the complete requests received on a connection, in order. It stops at a
+              transaction request, the next requests wait until the round answered it, and at an incomplete
+              request, its end is received later. A request larger than the input closes the connection.
+*/
+static void daemonServe(ST_daemonConnection_t *connection)
+{
+    uint32_t Loc_Used = 0, Loc_Length;
+    EN_flagState_t Loc_ServedFlag = FLAG_UP;
+
+    /* Loop: Until no complete request, or the connection waits for the round or for room to write */
+    while (Loc_ServedFlag == FLAG_UP && connection->closedFlag == FLAG_DOWN && connection->roundCount == 0 &&
+           connection->writingFlag == FLAG_DOWN && connection->inputCount - Loc_Used >= PROTOCOL_HEADER_SIZE)
+    {
+        Loc_Length = (uint32_t)protocolGetNumber(&connection->input[Loc_Used], 4);
+
+        /* Check 1: Request can't fit the input, or has no request code */
+        if (Loc_Length == 0 || Loc_Length > DAEMON_INPUT_SIZE - 4)
+        {
+            connection->closedFlag = FLAG_UP;
+        }
+        /* Check 2: Request is not fully received */
+        else if (connection->inputCount - Loc_Used < 4 + Loc_Length)
+        {
+            Loc_ServedFlag = FLAG_DOWN;
+        }
+        /* Check 3: Serve the request, unless the round has no room for it */
+        else
+        {
+            Loc_ServedFlag = daemonRequest(connection, connection->input[Loc_Used + 4], &connection->input[Loc_Used + PROTOCOL_HEADER_SIZE],
+                                           Loc_Length - 1);
+            Loc_Used += (Loc_ServedFlag == FLAG_UP) ? 4 + Loc_Length : 0;
+        }
+    }
+
+    memmove(connection->input, &connection->input[Loc_Used], connection->inputCount - Loc_Used);
+    connection->inputCount -= Loc_Used;
+}
+
+/*
+ Name: daemonServeReady
+ Input: void
+ Output: void
+ Description: Static Function to serve every connection of the ready list. Connections still holding a complete
+              request because the round is full stay in the list, answers are sent at once.
+*/
+static void daemonServeReady(void)
+{
+    ST_daemonConnection_t *Loc_Connection;
+    uint32_t Loc_Kept = 0;
+
+    /* Loop: Until all ready connections are served */
+    for (uint32_t Loc_Index = 0; Loc_Index < Glb_ReadyCount; Loc_Index++)
+    {
+        Loc_Connection = Glb_Connections[Glb_Ready[Loc_Index]];
+
+        /* Check: Slot is still used, the connection was not closed since it was marked */
+        if (Loc_Connection != NULL && Loc_Connection->readyFlag == FLAG_UP)
+        {
+            daemonServe(Loc_Connection);
+            daemonFlush(Loc_Connection);
+
+            /* Check 1: Connection failed, close it unless its transactions are in the round */
+            if (Loc_Connection->closedFlag == FLAG_UP)
+            {
+                Loc_Connection->readyFlag = FLAG_DOWN;
+
+                /* Check 1.1: Connection is not in the round */
+                if (Loc_Connection->roundCount == 0)
+                {
+                    daemonCloseConnection(Loc_Connection);
+                }
+            }
+            /* Check 2: Connection has a request the round had no room for */
+            else if (Loc_Connection->roundCount == 0 && Loc_Connection->writingFlag == FLAG_DOWN && daemonPending(Loc_Connection) == FLAG_UP)
+            {
+                Glb_Ready[Loc_Kept++] = Loc_Connection->slot;
+            }
+            /* Check 3: Connection waits for the round, for room to write or for more bytes */
+            else
+            {
+                Loc_Connection->readyFlag = FLAG_DOWN;
+            }
+        }
+    }
+
+    Glb_ReadyCount = Loc_Kept;
+}
+
+/*
+ Name: daemonRunRound
+ Input: void
+ Output: void
+ Description: Static Function to authorize the transactions of all connections with one recieveTransactionBatch
+              call, so they share one log append and one log sync, then answer every connection its states and
+              sequence numbers and serve the requests that waited behind them.
+*/
+static void daemonRunRound(void)
+{
+    ST_daemonConnection_t *Loc_Connection;
+    ST_transaction_t *Loc_Transaction;
+    uint8_t *Loc_Answer;
+
+    recieveTransactionBatch(Glb_RoundTransactions, Glb_RoundCount, Glb_RoundStates);
+
+    /* Loop: Until all connections of the round are answered */
+    for (uint32_t Loc_Index = 0; Loc_Index < Glb_RoundConnectionCount; Loc_Index++)
+    {
+        Loc_Connection = Glb_Connections[Glb_RoundSlots[Loc_Index]];
+        Loc_Answer     = (Loc_Connection->closedFlag == FLAG_UP) ? NULL : daemonBeginAnswer(Loc_Connection, 2 + 5 * Loc_Connection->roundCount);
+
+        /* Check: Connection is still open and the answer has room, state and sequence number of each transaction */
+        if (Loc_Answer != NULL)
+        {
+            /* Loop: Until all transactions of the connection are written */
+            for (uint32_t Loc_Item = 0; Loc_Item < Loc_Connection->roundCount; Loc_Item++)
+            {
+                Loc_Transaction = &Glb_RoundTransactions[Loc_Connection->roundFirst + Loc_Item];
+
+                Loc_Answer[5 * Loc_Item] = (uint8_t)Glb_RoundStates[Loc_Connection->roundFirst + Loc_Item];
+                protocolPutNumber(&Loc_Answer[5 * Loc_Item + 1], Loc_Transaction->transactionSequenceNumber, 4);
+            }
+
+            daemonEndAnswer(Loc_Connection, SERVER_OK, 5 * Loc_Connection->roundCount);
+            daemonFlush(Loc_Connection);
+        }
+
+        Loc_Connection->roundCount = 0;
+
+        /* Check 1: Connection failed during the round */
+        if (Loc_Connection->closedFlag == FLAG_UP)
+        {
+            daemonCloseConnection(Loc_Connection);
+        }
+        /* Check 2: Requests waited behind the transactions */
+        else if (Loc_Connection->writingFlag == FLAG_DOWN && daemonPending(Loc_Connection) == FLAG_UP)
+        {
+            daemonMarkReady(Loc_Connection);
+        }
+    }
+
+    Glb_RoundCount           = 0;
+    Glb_RoundConnectionCount = 0;
+}
+
+/*
+ Name: daemonListen
+ Input: void
+ Output: EN_flagState_t Listening flag
+ Description: Static Function to open the epoll instance and listen on the Unix domain socket, a socket file left
+              by a previous daemon is replaced.
+*/
+static EN_flagState_t daemonListen(void)
+{
+    struct sockaddr_un Loc_Address = {0};
+
+    Loc_Address.sun_family = AF_UNIX;
+    strncpy(Loc_Address.sun_path, PROTOCOL_SOCKET_FILE, sizeof(Loc_Address.sun_path) - 1);
+    unlink(PROTOCOL_SOCKET_FILE);
+
+    Glb_ListenDescriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    /* Loop: Until all slots are free, lowest slot first */
+    for (Glb_FreeCount = 0; Glb_FreeCount < DAEMON_MAX_CONNECTIONS; Glb_FreeCount++)
+    {
+        Glb_FreeSlots[Glb_FreeCount] = DAEMON_MAX_CONNECTIONS - 1 - Glb_FreeCount;
+    }
+
+    return (Glb_ListenDescriptor >= 0 &&
+            bind(Glb_ListenDescriptor, (struct sockaddr *)&Loc_Address, sizeof(Loc_Address)) == 0 &&
+            listen(Glb_ListenDescriptor, DAEMON_LISTEN_BACKLOG) == 0 &&
+            eventOpen(&Glb_EventDescriptor) == EVENT_OK &&
+            eventAdd(Glb_EventDescriptor, Glb_ListenDescriptor, DAEMON_LISTEN_KEY, EVENT_READ) == EVENT_OK) ? FLAG_UP : FLAG_DOWN;
+}
+
+/*
+ Name: daemonPrimaryDown
+ Input: Pointer to directory of the primary
+ Output: EN_flagState_t Primary down flag
+ Description: Static Function to connect to the socket of the primary daemon, the primary is down if its socket
+              file is gone or nothing listens on it anymore. A path too long for a socket address is never down.
+*/
+static EN_flagState_t daemonPrimaryDown(uint8_t *primaryDirectory)
+{
+    /* Define local variable to set the flag state, Flag Down */
+    EN_flagState_t Loc_DownFlag = FLAG_DOWN;
+    struct sockaddr_un Loc_Address = {0};
+    sint32_t Loc_Socket;
+
+    Loc_Address.sun_family = AF_UNIX;
+
+    /* Check: Path fits, and the socket is created */
+    if (snprintf(Loc_Address.sun_path, sizeof(Loc_Address.sun_path), "%s/%s", primaryDirectory, PROTOCOL_SOCKET_FILE) < (int)sizeof(Loc_Address.sun_path) &&
+        (Loc_Socket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)) >= 0)
+    {
+        /* Check: Socket file is gone, or refuses the connection */
+        if (connect(Loc_Socket, (struct sockaddr *)&Loc_Address, sizeof(Loc_Address)) != 0 && (errno == ENOENT || errno == ECONNREFUSED))
+        {
+            Loc_DownFlag = FLAG_UP;
+        }
+
+        close(Loc_Socket);
+    }
+
+    return Loc_DownFlag;
+}
+
+/*
+ Name: daemonStandby
+ Input: Pointer to directory of the primary
+ Output: EN_flagState_t Taken over flag
+ Description: Static Function to run a standby until it takes over, the standby threads of the server ship the log
+              of the primary meanwhile. Every DAEMON_STANDBY_CHECK_MS it checks whether SIGUSR2 asked it to take
+              over or the primary is down, every DAEMON_STANDBY_REPORT_MS it prints the replication lag. Once it
+              takes over it prints the time the catch-up took. A signal stopping the daemon stops the standby
+              without taking over.
+*/
+static EN_flagState_t daemonStandby(uint8_t *primaryDirectory)
+{
+    /* Define local variable to set the flag state, Flag Down */
+    EN_flagState_t Loc_TakeOverFlag = FLAG_DOWN;
+    EN_serverError_t Loc_Error;
+    uint64_t Loc_Bytes;
+    uint32_t Loc_Transactions, Loc_Checks = 0;
+    struct timespec Loc_Start, Loc_End;
+
+    /* Loop: Until a signal stops the daemon, or the standby is to take over */
+    while (Glb_RunFlag == FLAG_UP && Loc_TakeOverFlag == FLAG_DOWN)
+    {
+        usleep(DAEMON_STANDBY_CHECK_MS * 1000);
+        Loc_Checks++;
+
+        /* Check 1: SIGUSR2 asks to take over, or the primary is down */
+        if (Glb_TakeOverFlag == FLAG_UP || daemonPrimaryDown(primaryDirectory) == FLAG_UP)
+        {
+            Loc_TakeOverFlag = FLAG_UP;
+        }
+        /* Check 2: Time to report the lag */
+        else if (Loc_Checks % (DAEMON_STANDBY_REPORT_MS / DAEMON_STANDBY_CHECK_MS) == 0)
+        {
+            Loc_Error = getStandbyLag(&Loc_Bytes, &Loc_Transactions);
+            printf(" Standby lag: %" PRIu32 " transactions, %" PRIu64 " bytes%s\n", Loc_Transactions, Loc_Bytes,
+                   (Loc_Error == SERVER_OK) ? "" : ", shipping stopped, a new base copy is needed");
+            fflush(stdout);
+        }
+    }
+
+    /* Check: Standby takes over */
+    if (Loc_TakeOverFlag == FLAG_UP)
+    {
+        getStandbyLag(&Loc_Bytes, &Loc_Transactions);
+
+        clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+        Loc_Error = takeOverServer();
+        clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+
+        printf(" Took over in %.3f ms, %" PRIu32 " transactions, %" PRIu64 " bytes behind the primary%s\n",
+               (Loc_End.tv_sec - Loc_Start.tv_sec) * 1e3 + (Loc_End.tv_nsec - Loc_Start.tv_nsec) / 1e6, Loc_Transactions, Loc_Bytes,
+               (Loc_Error == SERVER_OK) ? "" : ", shipping stopped before the end of the primary log");
+        fflush(stdout);
+    }
+
+    return Loc_TakeOverFlag;
+}
+
+/*
+ Name: daemonLoop
+ Input: void
+ Output: void
+ Description: Static Function to run the event loop until stopped. Each turn waits for ready sockets, without
+              waiting if a request is left from the previous turn, reads them, serves the complete requests and
+              authorizes the transactions of all connections as one round.
+*/
+static void daemonLoop(void)
+{
+    ST_event_t Loc_Events[DAEMON_EVENTS];
+    ST_daemonConnection_t *Loc_Connection;
+    int Loc_Count = 0;
+
+    /* Loop: Until a signal stops the daemon or the wait fails */
+    while (Glb_RunFlag == FLAG_UP &&
+           eventWait(Glb_EventDescriptor, Loc_Events, DAEMON_EVENTS, (Glb_ReadyCount > 0) ? 0 : DAEMON_WAIT_MS, &Loc_Count) == EVENT_OK)
+    {
+        /* Loop: Until all events are handled */
+        for (int Loc_Index = 0; Loc_Index < Loc_Count; Loc_Index++)
+        {
+            Loc_Connection = (Loc_Events[Loc_Index].key == DAEMON_LISTEN_KEY) ? NULL : Glb_Connections[Loc_Events[Loc_Index].key];
+
+            /* Check 1: Terminals are waiting to connect */
+            if (Loc_Events[Loc_Index].key == DAEMON_LISTEN_KEY)
+            {
+                daemonAccept();
+            }
+            /* Check 2: Connection is ready */
+            else if (Loc_Connection != NULL)
+            {
+                /* Check 2.1: Room to write the output */
+                if (Loc_Events[Loc_Index].flags & EVENT_WRITE)
+                {
+                    daemonFlush(Loc_Connection);
+                }
+
+                /* Check 2.2: Bytes to read, or hang up */
+                if (Loc_Events[Loc_Index].flags & (EVENT_READ | EVENT_CLOSED))
+                {
+                    daemonRead(Loc_Connection);
+                }
+
+                /* Check 2.3: Connection failed, close it unless its transactions are in the round */
+                if (Loc_Connection->closedFlag == FLAG_UP && Loc_Connection->roundCount == 0)
+                {
+                    daemonCloseConnection(Loc_Connection);
+                }
+                /* Check 2.4: Connection has a complete request */
+                else if (Loc_Connection->writingFlag == FLAG_DOWN && daemonPending(Loc_Connection) == FLAG_UP)
+                {
+                    daemonMarkReady(Loc_Connection);
+                }
+            }
+        }
+
+        daemonServeReady();
+
+        /* Check: Transactions are waiting in the round */
+        if (Glb_RoundCount > 0)
+        {
+            daemonRunRound();
+        }
+
+        /* Check: Stage histograms are asked for by SIGUSR1 */
+        if (Glb_DumpFlag == FLAG_UP)
+        {
+            Glb_DumpFlag = FLAG_DOWN;
+            dumpStageHistograms();
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    struct sigaction Loc_Action = {0};
+    EN_flagState_t Loc_StagesFlag = FLAG_DOWN;
+    EN_flagState_t Loc_PipelineFlag = FLAG_DOWN;
+    uint8_t *Loc_PrimaryDirectory = NULL;
+    ST_velocityLimits_t Loc_Limits = {{0}, {0}};
+    int Loc_Option, Loc_Status = 0;
+
+    /* Loop: Until all options are read, -s times the server stages, -w opens the server with shard workers,
+       -p opens it pipelined, -f opens it as a standby of the primary in a directory, -v sets the velocity limits
+       of every account as count:cents of its last minute, hour and day */
+    while (Loc_Status == 0 && (Loc_Option = getopt(argc, argv, "spw:f:v:")) != -1)
+    {
+        /* Check: Option and its value */
+        if (Loc_Option == 's')
+        {
+            Loc_StagesFlag = FLAG_UP;
+        }
+        else if (Loc_Option == 'p')
+        {
+            Loc_PipelineFlag = FLAG_UP;
+        }
+        else if (Loc_Option == 'w')
+        {
+            Glb_Shards = strtoul(optarg, NULL, 10);
+        }
+        else if (Loc_Option == 'f')
+        {
+            Loc_PrimaryDirectory = optarg;
+        }
+        else if (Loc_Option == 'v' &&
+                 sscanf(optarg, "%u:%" SCNd64 ",%u:%" SCNd64 ",%u:%" SCNd64,
+                        &Loc_Limits.maxCount[VELOCITY_MINUTE], &Loc_Limits.maxAmount[VELOCITY_MINUTE],
+                        &Loc_Limits.maxCount[VELOCITY_HOUR], &Loc_Limits.maxAmount[VELOCITY_HOUR],
+                        &Loc_Limits.maxCount[VELOCITY_DAY], &Loc_Limits.maxAmount[VELOCITY_DAY]) == 6)
+        {
+            setVelocityLimits(&Loc_Limits);
+        }
+        else
+        {
+            Loc_Status = 2;
+        }
+    }
+
+    /* Check 1: Options are wrong, or pipelined and sharded or standby */
+    if (Loc_Status != 0 || (Loc_PipelineFlag == FLAG_UP && (Glb_Shards != 0 || Loc_PrimaryDirectory != NULL)))
+    {
+        printf(" Usage: %s [-s] [-v count:cents,count:cents,count:cents] [-p | [-w shard workers] [-f primary directory]]\n", argv[0]);
+        return Loc_Status;
+    }
+
+    /* Stop on SIGINT and SIGTERM, ending the wait without restarting it, print the stage histograms on SIGUSR1,
+       take over on SIGUSR2 */
+    Loc_Action.sa_handler = daemonSignal;
+    sigaction(SIGINT, &Loc_Action, NULL);
+    sigaction(SIGTERM, &Loc_Action, NULL);
+    sigaction(SIGUSR1, &Loc_Action, NULL);
+    sigaction(SIGUSR2, &Loc_Action, NULL);
+
+    /* Check 2: Server databases can't be opened */
+    if (((Loc_PrimaryDirectory != NULL) ? initServerStandby(Loc_PrimaryDirectory, Glb_Shards) :
+         (Loc_PipelineFlag == FLAG_UP) ? initServerPipeline() :
+         (Glb_Shards == 0) ? initServer() : initServerShards(Glb_Shards)) != SERVER_OK)
+    {
+        printf(" Can't open server databases\n");
+        return 1;
+    }
+
+    /* Check 3: Server is a standby, it listens once it takes over */
+    if (Loc_PrimaryDirectory != NULL)
+    {
+        printf(" Standby of %s\n", Loc_PrimaryDirectory);
+        fflush(stdout);
+
+        /* Check 3.1: Daemon is stopped before taking over */
+        if (daemonStandby(Loc_PrimaryDirectory) == FLAG_DOWN)
+        {
+            closeServer();
+            return 0;
+        }
+    }
+
+    /* Check 4: Socket can't be listened on */
+    if (daemonListen() == FLAG_DOWN)
+    {
+        printf(" Can't listen on %s\n", PROTOCOL_SOCKET_FILE);
+        closeServer();
+        return 1;
+    }
+
+    /* Check 5: Stage histograms are asked for */
+    if (Loc_StagesFlag == FLAG_UP)
+    {
+        setStageHistograms(FLAG_UP);
+    }
+
+    printf(" Serving %s\n", PROTOCOL_SOCKET_FILE);
+    fflush(stdout);
+
+    daemonLoop();
+
+    /* Loop: Until all connections are closed */
+    for (uint32_t Loc_Slot = 0; Loc_Slot < DAEMON_MAX_CONNECTIONS; Loc_Slot++)
+    {
+        /* Check: Slot is used */
+        if (Glb_Connections[Loc_Slot] != NULL)
+        {
+            daemonCloseConnection(Glb_Connections[Loc_Slot]);
+        }
+    }
+
+    eventClose(Glb_EventDescriptor);
+    close(Glb_ListenDescriptor);
+    unlink(PROTOCOL_SOCKET_FILE);
+    closeServer();
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+#ifndef DAEMON_H_
+#define DAEMON_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define DAEMON_MAX_CONNECTIONS		8192		/* Terminal connections served at once */
+#define DAEMON_LISTEN_BACKLOG		1024
+#define DAEMON_EVENTS				256			/* Ready sockets returned by one wait */
+#define DAEMON_ROUND_TRANSACTIONS	1024		/* Transactions of all connections authorized by one batch */
+#define DAEMON_WAIT_MS				1000		/* Longest wait without events, the stop flag is checked after it */
+#define DAEMON_INPUT_SIZE			PROTOCOL_REQUEST_SIZE	/* Received bytes kept per connection, one full request */
+#define DAEMON_LISTEN_KEY			DAEMON_MAX_CONNECTIONS	/* Event key of the listening socket */
+#define DAEMON_STANDBY_CHECK_MS		100			/* Milliseconds between checks of a standby for taking over */
+#define DAEMON_STANDBY_REPORT_MS	1000		/* Milliseconds between reports of the replication lag */
+
+typedef struct ST_daemonConnection_t
+{
+	sint32_t fileDescriptor;
+	uint32_t slot;							/* Connection slot, its event key */
+	uint8_t input[DAEMON_INPUT_SIZE];
+	uint32_t inputCount;					/* Bytes received, starting with the next request */
+	uint8_t *output;						/* Answers not sent yet */
+	uint32_t outputCount;
+	uint32_t outputSent;
+	uint32_t outputCapacity;
+	uint32_t roundFirst;					/* First transaction of the connection in the round batch */
+	uint32_t roundCount;					/* Transactions of the connection in the round batch, 0 if none */
+	uint8_t roundRequest;					/* Request of these transactions, single or batch */
+	EN_flagState_t readyFlag;				/* Connection is in the ready list */
+	EN_flagState_t writingFlag;				/* Output is blocked, waiting for room to write */
+	EN_flagState_t closedFlag;				/* Peer hung up or sent a malformed request */
+}ST_daemonConnection_t;
+
+#endif /* DAEMON_H_ */
@@ -0,0 +1,648 @@
+/* Standard Library */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Index Module */
+#include "../Index/index.h"
+/* Filter Module */
+#include "../Filter/filter.h"
+/* Database Module */
+#include "database.h"
+
+/*
+ Name: databaseAlign
+ Input: uint64_t Size
+ Output: uint64_t Size rounded up to a whole page
+ Description: Static Function to keep every region of the file page aligned.
+*/
+static uint64_t databaseAlign(uint64_t size)
+{
+    return (size + DATABASE_PAGE_SIZE - 1) & ~(uint64_t)(DATABASE_PAGE_SIZE - 1);
+}
+
+/*
+ Name: databaseCreate
+ Input: Pointer to Database structure, Pointer to file path
+ Output: EN_databaseError_t Error or No Error
+ Description: Static Function to create a new accounts file, header | PAN index slots | PAN filter blocks | balances column |
+              states column | last transactions column | keys column. Each column is one contiguous array, so a scan over balances or states
+              reads no PAN bytes. Only the header is written, the file is extended with ftruncate so the index and
+              columns are sparse zero pages, which is an empty index and empty accounts.
+*/
+static EN_databaseError_t databaseCreate(ST_database_t *database, uint8_t *path)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_databaseError_t Loc_ErrorState = DATABASE_OK;
+    ST_databaseHeader_t Loc_Header = {DATABASE_MAGIC};
+    uint32_t Loc_IndexCapacity = INDEX_MIN_CAPACITY;
+
+    /* Loop: Until index stays below 50% load with all records used, so it never needs to grow */
+    while (Loc_IndexCapacity < DATABASE_DEFAULT_CAPACITY * 2)
+    {
+        Loc_IndexCapacity *= 2;
+    }
+
+    Loc_Header.version        = DATABASE_VERSION;
+    Loc_Header.keySize        = sizeof(ST_panKey_t);
+    Loc_Header.capacity       = DATABASE_DEFAULT_CAPACITY;
+    Loc_Header.count          = 0;
+    Loc_Header.indexCapacity  = Loc_IndexCapacity;
+    Loc_Header.filterBlocks   = filterBlockCount(DATABASE_DEFAULT_CAPACITY);
+    Loc_Header.checkpointSequenceNumber = 0;
+    Loc_Header.indexOffset    = databaseAlign(sizeof(ST_databaseHeader_t));
+    Loc_Header.filterOffset   = Loc_Header.indexOffset + databaseAlign((uint64_t)Loc_IndexCapacity * sizeof(ST_indexSlot_t));
+    Loc_Header.balancesOffset = Loc_Header.filterOffset + databaseAlign((uint64_t)Loc_Header.filterBlocks * sizeof(ST_filterBlock_t));
+    Loc_Header.statesOffset   = Loc_Header.balancesOffset + databaseAlign((uint64_t)DATABASE_DEFAULT_CAPACITY * sizeof(sint64_t));
+    Loc_Header.lastSequencesOffset = Loc_Header.statesOffset + databaseAlign((uint64_t)DATABASE_DEFAULT_CAPACITY * sizeof(uint8_t));
+    Loc_Header.keysOffset     = Loc_Header.lastSequencesOffset + databaseAlign((uint64_t)DATABASE_DEFAULT_CAPACITY * sizeof(uint32_t));
+    Loc_Header.fileSize       = Loc_Header.keysOffset + databaseAlign((uint64_t)DATABASE_DEFAULT_CAPACITY * sizeof(ST_panKey_t));
+
+    database->fileDescriptor = open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+
+    /* Check: File can't be created, written or extended */
+    if (database->fileDescriptor < 0 ||
+        write(database->fileDescriptor, &Loc_Header, sizeof(Loc_Header)) != sizeof(Loc_Header) ||
+        ftruncate(database->fileDescriptor, Loc_Header.fileSize) != 0)
+    {
+        /* Update error state, Open Failed! */
+        Loc_ErrorState = DATABASE_OPEN_FAILED;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: databaseMap
+ Input: Pointer to Database structure
+ Output: EN_databaseError_t Error or No Error
+ Description: Static Function to map the whole accounts file and check its header. No page other than the
+              header is read here, the index and columns are faulted in on first use.
+*/
+static EN_databaseError_t databaseMap(ST_database_t *database)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_databaseError_t Loc_ErrorState = DATABASE_OK;
+    ST_databaseHeader_t *Loc_Header;
+    struct stat Loc_Status;
+
+    database->mapping = MAP_FAILED;
+
+    /* Check 1: File can't be mapped */
+    if (fstat(database->fileDescriptor, &Loc_Status) != 0 || Loc_Status.st_size < (off_t)sizeof(ST_databaseHeader_t) ||
+        (database->mapping = mmap(NULL, Loc_Status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, database->fileDescriptor, 0)) == MAP_FAILED)
+    {
+        /* Update error state, Open Failed! */
+        Loc_ErrorState = DATABASE_OPEN_FAILED;
+    }
+    /* Check 2: File is mapped */
+    else
+    {
+        Loc_Header = (ST_databaseHeader_t *)database->mapping;
+
+        /* Check 2.1: Not an accounts file of this build */
+        if (memcmp(Loc_Header->magic, DATABASE_MAGIC, sizeof(DATABASE_MAGIC)) != 0 || Loc_Header->version != DATABASE_VERSION ||
+            Loc_Header->keySize != sizeof(ST_panKey_t) || Loc_Header->fileSize > (uint64_t)Loc_Status.st_size ||
+            Loc_Header->count > Loc_Header->capacity || Loc_Header->filterBlocks == 0 ||
+            (Loc_Header->filterBlocks & (Loc_Header->filterBlocks - 1)) != 0)
+        {
+            munmap(database->mapping, Loc_Status.st_size);
+            database->mapping = MAP_FAILED;
+
+            /* Update error state, Bad Format! */
+            Loc_ErrorState = DATABASE_BAD_FORMAT;
+        }
+        /* Check 2.2: Accounts file is valid */
+        else
+        {
+            /* Accounts are looked up by PAN in no particular order, don't read ahead */
+            madvise(database->mapping, Loc_Header->fileSize, MADV_RANDOM);
+
+            database->header        = Loc_Header;
+            database->balances      = (sint64_t *)(database->mapping + Loc_Header->balancesOffset);
+            database->states        = database->mapping + Loc_Header->statesOffset;
+            database->lastSequences = (uint32_t *)(database->mapping + Loc_Header->lastSequencesOffset);
+            database->keys          = (ST_panKey_t *)(database->mapping + Loc_Header->keysOffset);
+
+            indexAttach(&database->index, database->keys, (ST_indexSlot_t *)(database->mapping + Loc_Header->indexOffset),
+                        Loc_Header->indexCapacity, Loc_Header->count);
+            filterAttach(&database->filter, (ST_filterBlock_t *)(database->mapping + Loc_Header->filterOffset), Loc_Header->filterBlocks);
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: databaseOpen
+ Input: Pointer to Database structure, Pointer to file path, Pointer to default accounts, uint32_t Number of default accounts
+ Output: EN_databaseError_t Error or No Error
+ Description: 1. This function opens and maps the accounts file, the cost does not depend on the number of accounts.
+              2. If the file does not exist, it is created and the default accounts are added to it.
+              3. If the file can't be opened or created will return DATABASE_OPEN_FAILED, if it is not an accounts
+                 file of this build will return DATABASE_BAD_FORMAT, else return DATABASE_OK.
+*/
+EN_databaseError_t databaseOpen(ST_database_t *database, uint8_t *path, ST_accountsDB_t *defaultAccounts, uint32_t defaultCount)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_databaseError_t Loc_ErrorState = DATABASE_OK;
+    /* Define local variable to set the flag state, Flag Down */
+    EN_flagState_t Loc_CreatedFlag = FLAG_DOWN;
+    uint32_t Loc_Record;
+
+    database->fileDescriptor = open(path, O_RDWR);
+
+    /* Check 1: File does not exist */
+    if (database->fileDescriptor < 0 && errno == ENOENT)
+    {
+        Loc_ErrorState  = databaseCreate(database, path);
+        Loc_CreatedFlag = FLAG_UP;
+    }
+    /* Check 2: File can't be opened */
+    else if (database->fileDescriptor < 0)
+    {
+        /* Update error state, Open Failed! */
+        Loc_ErrorState = DATABASE_OPEN_FAILED;
+    }
+
+    /* Check 3: File is open */
+    if (Loc_ErrorState == DATABASE_OK)
+    {
+        Loc_ErrorState = databaseMap(database);
+    }
+
+    /* Check 4: File is mapped, allocate the dirty block bitmaps */
+    if (Loc_ErrorState == DATABASE_OK)
+    {
+        database->bitmapWords            = (databaseAlign((uint64_t)database->header->capacity * sizeof(sint64_t)) / DATABASE_PAGE_SIZE + 63) / 64;
+        database->dirtyPages             = calloc(database->bitmapWords, sizeof(uint64_t));
+        database->checkpointPages        = calloc(database->bitmapWords, sizeof(uint64_t));
+        database->fullSyncFlag           = FLAG_DOWN;
+        database->checkpointFullSyncFlag = FLAG_DOWN;
+
+        /* Check 4.1: No memory for the bitmaps */
+        if (database->dirtyPages == NULL || database->checkpointPages == NULL)
+        {
+            free(database->dirtyPages);
+            free(database->checkpointPages);
+            indexFree(&database->index);
+            munmap(database->mapping, database->header->fileSize);
+
+            /* Update error state, Open Failed! */
+            Loc_ErrorState = DATABASE_OPEN_FAILED;
+        }
+    }
+
+    /* Check 5: File is new, add default accounts */
+    if (Loc_ErrorState == DATABASE_OK && Loc_CreatedFlag == FLAG_UP)
+    {
+        /* Loop: Until the end of default accounts */
+        for (uint32_t Loc_Index = 0; Loc_Index < defaultCount; Loc_Index++)
+        {
+            databaseAddAccount(database, &defaultAccounts[Loc_Index], &Loc_Record);
+        }
+
+        Loc_ErrorState         = databaseSync(database);
+        database->fullSyncFlag = FLAG_DOWN;
+    }
+
+    /* Check 6: Open failed, release file */
+    if (Loc_ErrorState != DATABASE_OK && database->fileDescriptor >= 0)
+    {
+        close(database->fileDescriptor);
+        database->fileDescriptor = -1;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: databaseAddAccount
+ Input: Pointer to Database structure, Pointer to Account, Pointer to uint32_t Record
+ Output: EN_databaseError_t Error or No Error
+ Description: 1. This function appends an account to the columns of the file and adds it to the PAN index and the
+                 PAN filter, both are updated in place.
+              2. The PAN is stored as its packed key.
+              3. If the PAN is not all digits will return DATABASE_INVALID_ACCOUNT, if the PAN already has an account
+                 will return DATABASE_DUPLICATE_ACCOUNT, if all records are used will return DATABASE_FULL, else
+                 return DATABASE_OK and the record number.
+*/
+EN_databaseError_t databaseAddAccount(ST_database_t *database, ST_accountsDB_t *account, uint32_t *record)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_databaseError_t Loc_ErrorState = DATABASE_OK;
+    uint32_t Loc_Record = database->header->count;
+    EN_indexError_t Loc_IndexError;
+
+    /* Check 1: All records are used */
+    if (Loc_Record == database->header->capacity)
+    {
+        /* Update error state, Full! */
+        Loc_ErrorState = DATABASE_FULL;
+    }
+    /* Check 2: PAN can't be packed */
+    else if (packCardPAN(account->primaryAccountNumber, &database->keys[Loc_Record]) == WRONG_PAN)
+    {
+        memset(&database->keys[Loc_Record], 0, sizeof(ST_panKey_t));
+
+        /* Update error state, Invalid Account! */
+        Loc_ErrorState = DATABASE_INVALID_ACCOUNT;
+    }
+    /* Check 3: Record is available */
+    else
+    {
+        Loc_IndexError = indexInsert(&database->index, Loc_Record);
+
+        /* Check 3.1: Account is not indexed */
+        if (Loc_IndexError != INDEX_OK)
+        {
+            memset(&database->keys[Loc_Record], 0, sizeof(ST_panKey_t));
+
+            /* Update error state, Duplicate Account or Full! */
+            Loc_ErrorState = (Loc_IndexError == INDEX_DUPLICATE_KEY) ? DATABASE_DUPLICATE_ACCOUNT : DATABASE_FULL;
+        }
+        /* Check 3.2: Account is indexed */
+        else
+        {
+            filterAdd(&database->filter, &database->keys[Loc_Record]);
+
+            database->balances[Loc_Record] = account->balance;
+            database->states[Loc_Record]   = account->state;
+            database->header->count++;
+            database->fullSyncFlag = FLAG_UP;
+            *record = Loc_Record;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: databaseGetAccount
+ Input: Pointer to Database structure, uint32_t Record, Pointer to Account
+ Output: void
+ Description: This function gathers the columns of an account record into one account structure, the PAN key is
+              converted back to a PAN string.
+*/
+void databaseGetAccount(ST_database_t *database, uint32_t record, ST_accountsDB_t *account)
+{
+    account->balance = database->balances[record];
+    account->state   = database->states[record];
+    unpackCardPAN(&database->keys[record], account->primaryAccountNumber);
+}
+
+/*
+ Name: databaseReadAccounts
+ Input: Pointer to file path, uint32_t First record, uint32_t Maximum number of records, Pointer to Accounts,
+        Pointer to uint32_t Number of records read
+ Output: EN_databaseError_t Error or No Error
+ Description: 1. This function reads the used accounts records of an accounts file from the given one, at most
+                 maxCount of them, without mapping the file, another process may have it open and add accounts.
+                 The PAN key of every record is converted back to a PAN string.
+              2. A record is read once the other process counted it, after writing its columns.
+              3. If the file can't be opened or read will return DATABASE_OPEN_FAILED, if it is not an accounts file
+                 of this build will return DATABASE_BAD_FORMAT, if it uses fewer records than the given one will
+                 return DATABASE_INVALID_ACCOUNT, else return DATABASE_OK and the number of records read.
+*/
+EN_databaseError_t databaseReadAccounts(uint8_t *path, uint32_t firstRecord, uint32_t maxCount, ST_accountsDB_t *accounts, uint32_t *count)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_databaseError_t Loc_ErrorState = DATABASE_OK;
+    sint32_t Loc_FileDescriptor = open(path, O_RDONLY);
+    ST_databaseHeader_t Loc_Header;
+    ST_panKey_t Loc_Key;
+    uint8_t Loc_State;
+    uint32_t Loc_Record;
+
+    /* Check 1: File can't be opened, or its header can't be read */
+    if (Loc_FileDescriptor < 0 || pread(Loc_FileDescriptor, &Loc_Header, sizeof(Loc_Header), 0) != (ssize_t)sizeof(Loc_Header))
+    {
+        /* Update error state, Open Failed! */
+        Loc_ErrorState = DATABASE_OPEN_FAILED;
+    }
+    /* Check 2: Not an accounts file of this build */
+    else if (memcmp(Loc_Header.magic, DATABASE_MAGIC, sizeof(DATABASE_MAGIC)) != 0 || Loc_Header.version != DATABASE_VERSION ||
+             Loc_Header.keySize != sizeof(ST_panKey_t) || Loc_Header.count > Loc_Header.capacity)
+    {
+        /* Update error state, Bad Format! */
+        Loc_ErrorState = DATABASE_BAD_FORMAT;
+    }
+    /* Check 3: File uses fewer records than the given one */
+    else if (firstRecord > Loc_Header.count)
+    {
+        /* Update error state, Invalid Account! */
+        Loc_ErrorState = DATABASE_INVALID_ACCOUNT;
+    }
+    /* Check 4: Header is read, read the used records from the given one */
+    else
+    {
+        *count = (Loc_Header.count - firstRecord < maxCount) ? Loc_Header.count - firstRecord : maxCount;
+    }
+
+    /* Loop: Until all records are read, or one can't be */
+    for (uint32_t Loc_Index = 0; Loc_ErrorState == DATABASE_OK && Loc_Index < *count; Loc_Index++)
+    {
+        Loc_Record = firstRecord + Loc_Index;
+
+        /* Check: Columns of the record can't be read */
+        if (pread(Loc_FileDescriptor, &Loc_Key, sizeof(Loc_Key), Loc_Header.keysOffset + (uint64_t)Loc_Record * sizeof(ST_panKey_t)) != (ssize_t)sizeof(Loc_Key) ||
+            pread(Loc_FileDescriptor, &accounts[Loc_Index].balance, sizeof(sint64_t), Loc_Header.balancesOffset + (uint64_t)Loc_Record * sizeof(sint64_t)) != (ssize_t)sizeof(sint64_t) ||
+            pread(Loc_FileDescriptor, &Loc_State, 1, Loc_Header.statesOffset + Loc_Record) != 1)
+        {
+            /* Update error state, Open Failed! */
+            Loc_ErrorState = DATABASE_OPEN_FAILED;
+        }
+        else
+        {
+            accounts[Loc_Index].state = Loc_State;
+            unpackCardPAN(&Loc_Key, accounts[Loc_Index].primaryAccountNumber);
+        }
+    }
+
+    /* Check 5: File is open */
+    if (Loc_FileDescriptor >= 0)
+    {
+        close(Loc_FileDescriptor);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: databaseTotalBalance
+ Input: Pointer to Database structure
+ Output: sint64_t Sum of all balances in cents
+ Description: 1. This function adds up the balances column in DATABASE_SCAN_LANES independent sums, which the
+                 compiler turns into vector adds over the contiguous column.
+              2. Balances are read without locks, while transactions run the sum is not a consistent snapshot.
+*/
+sint64_t databaseTotalBalance(ST_database_t *database)
+{
+    sint64_t *Loc_Balances = database->balances;
+    uint32_t Loc_Count = database->header->count;
+    uint32_t Loc_Record = 0;
+    sint64_t Loc_Lanes[DATABASE_SCAN_LANES] = {0};
+    sint64_t Loc_Total = 0;
+
+    /* Loop: Until the last whole block, one add per lane, fixed lanes so the loop is vectorized */
+    for (; Loc_Record + DATABASE_SCAN_LANES <= Loc_Count; Loc_Record += DATABASE_SCAN_LANES)
+    {
+        for (uint32_t Loc_Lane = 0; Loc_Lane < DATABASE_SCAN_LANES; Loc_Lane++)
+        {
+            Loc_Lanes[Loc_Lane] += Loc_Balances[Loc_Record + Loc_Lane];
+        }
+    }
+
+    /* Loop: Until the end of the balances column */
+    for (; Loc_Record < Loc_Count; Loc_Record++)
+    {
+        Loc_Total += Loc_Balances[Loc_Record];
+    }
+
+    for (uint32_t Loc_Lane = 0; Loc_Lane < DATABASE_SCAN_LANES; Loc_Lane++)
+    {
+        Loc_Total += Loc_Lanes[Loc_Lane];
+    }
+
+    return Loc_Total;
+}
+
+/*
+ Name: databaseBlockedAccounts
+ Input: Pointer to Database structure
+ Output: uint32_t Number of blocked accounts
+ Description: This function counts the blocked accounts over the one byte states column in DATABASE_SCAN_LANES
+              independent counts, which the compiler turns into vector compares.
+*/
+uint32_t databaseBlockedAccounts(ST_database_t *database)
+{
+    uint8_t *Loc_States = database->states;
+    uint32_t Loc_Count = database->header->count;
+    uint32_t Loc_Record = 0;
+    uint32_t Loc_Lanes[DATABASE_SCAN_LANES] = {0};
+    uint32_t Loc_Blocked = 0;
+
+    /* Loop: Until the last whole block, one compare per lane, fixed lanes so the loop is vectorized */
+    for (; Loc_Record + DATABASE_SCAN_LANES <= Loc_Count; Loc_Record += DATABASE_SCAN_LANES)
+    {
+        for (uint32_t Loc_Lane = 0; Loc_Lane < DATABASE_SCAN_LANES; Loc_Lane++)
+        {
+            Loc_Lanes[Loc_Lane] += (Loc_States[Loc_Record + Loc_Lane] == BLOCKED);
+        }
+    }
+
+    /* Loop: Until the end of the states column */
+    for (; Loc_Record < Loc_Count; Loc_Record++)
+    {
+        Loc_Blocked += (Loc_States[Loc_Record] == BLOCKED);
+    }
+
+    for (uint32_t Loc_Lane = 0; Loc_Lane < DATABASE_SCAN_LANES; Loc_Lane++)
+    {
+        Loc_Blocked += Loc_Lanes[Loc_Lane];
+    }
+
+    return Loc_Blocked;
+}
+
+/*
+ Name: databaseSync
+ Input: Pointer to Database structure
+ Output: EN_databaseError_t Error or No Error
+ Description: 1. This function writes all changed pages of the mapping back to the file.
+              2. If the pages can't be written will return DATABASE_SYNC_FAILED, else return DATABASE_OK.
+*/
+EN_databaseError_t databaseSync(ST_database_t *database)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_databaseError_t Loc_ErrorState = DATABASE_OK;
+
+    /* Check: Pages can't be written */
+    if (msync(database->mapping, database->header->fileSize, MS_SYNC) != 0)
+    {
+        /* Update error state, Sync Failed! */
+        Loc_ErrorState = DATABASE_SYNC_FAILED;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: databaseMarkAccount
+ Input: Pointer to Database structure, uint32_t Record
+ Output: void
+ Description: 1. This function records that the balance or last transaction of an account changed since the
+                 checkpoint cut, so the next checkpoint writes the pages of its block of DATABASE_BLOCK_ACCOUNTS.
+              2. Many accounts share a block, the bit is only set with an atomic or if it is not set already, so
+                 the cache line of the bitmap is not written by every transaction.
+*/
+void databaseMarkAccount(ST_database_t *database, uint32_t record)
+{
+    uint32_t Loc_Block = record / DATABASE_BLOCK_ACCOUNTS;
+    uint64_t Loc_Bit   = (uint64_t)1 << (Loc_Block % 64);
+
+    /* Check: Block is not marked yet */
+    if ((__atomic_load_n(&database->dirtyPages[Loc_Block / 64], __ATOMIC_RELAXED) & Loc_Bit) == 0)
+    {
+        __atomic_fetch_or(&database->dirtyPages[Loc_Block / 64], Loc_Bit, __ATOMIC_RELAXED);
+    }
+}
+
+/*
+ Name: databaseBeginCheckpoint
+ Input: Pointer to Database structure
+ Output: void
+ Description: 1. This function cuts the checkpoint, pages marked so far are handed to databaseCheckpoint and the
+                 marks start again from an empty bitmap.
+              2. It must be called while no balance can change, the cut only swaps two pointers.
+*/
+void databaseBeginCheckpoint(ST_database_t *database)
+{
+    uint64_t *Loc_Pages = database->checkpointPages;
+
+    database->checkpointPages        = database->dirtyPages;
+    database->dirtyPages             = Loc_Pages;
+    database->checkpointFullSyncFlag = database->fullSyncFlag;
+    database->fullSyncFlag           = FLAG_DOWN;
+}
+
+/*
+ Name: databaseCheckpoint
+ Input: Pointer to Database structure, uint32_t Checkpoint sequence number
+ Output: EN_databaseError_t Error or No Error
+ Description: 1. This function makes the file a snapshot of all transactions before the checkpoint sequence number,
+                 the sequence number of the last databaseBeginCheckpoint.
+              2. Only the balances and last transactions pages of blocks marked before the cut are written, adjacent
+                 blocks with one msync per column. Accounts keep changing meanwhile, a page may be written with newer
+                 values, which the log replay from the checkpoint sequence number overwrites with the same values.
+              3. The whole file is written only if accounts were added before the cut.
+              4. The header records the checkpoint after the pages are written, so after a crash the log only has
+                 to be replayed from the checkpoint sequence number.
+              5. If the pages can't be written will return DATABASE_SYNC_FAILED and the pages stay marked for the
+                 next checkpoint, else return DATABASE_OK.
+*/
+EN_databaseError_t databaseCheckpoint(ST_database_t *database, uint32_t checkpointSequenceNumber)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_databaseError_t Loc_ErrorState = DATABASE_OK;
+    uint64_t *Loc_Pages = database->checkpointPages;
+    uint32_t Loc_PageCount = database->bitmapWords * 64;
+    uint32_t Loc_First, Loc_Last;
+    uint64_t Loc_Marks, Loc_SequencesStart, Loc_SequencesEnd;
+
+    /* Check 1: Accounts were added, write the whole file */
+    if (database->checkpointFullSyncFlag == FLAG_UP)
+    {
+        Loc_ErrorState = databaseSync(database);
+    }
+    /* Check 2: Write the marked pages only */
+    else
+    {
+        /* Loop: Until the end of the bitmap, one run of adjacent marked blocks at a time */
+        for (Loc_First = 0; Loc_First < Loc_PageCount; Loc_First = Loc_Last)
+        {
+            Loc_Marks = Loc_Pages[Loc_First / 64] >> (Loc_First % 64);
+
+            /* Check 2.1: No marked block in the rest of the word, go on with the next word */
+            if (Loc_Marks == 0)
+            {
+                Loc_Last = (Loc_First / 64 + 1) * 64;
+            }
+            /* Check 2.2: Marked block found, write the run starting at it */
+            else
+            {
+                Loc_First += __builtin_ctzll(Loc_Marks);
+
+                /* Loop: Until the end of the run */
+                for (Loc_Last = Loc_First + 1; Loc_Last < Loc_PageCount && ((Loc_Pages[Loc_Last / 64] >> (Loc_Last % 64)) & 1); Loc_Last++)
+                {
+                }
+
+                /* Last transactions of a run are 4 bytes per account, its pages are shared with the neighbour runs */
+                Loc_SequencesStart = (uint64_t)Loc_First * DATABASE_BLOCK_ACCOUNTS * sizeof(uint32_t) & ~(uint64_t)(DATABASE_PAGE_SIZE - 1);
+                Loc_SequencesEnd   = databaseAlign((uint64_t)Loc_Last * DATABASE_BLOCK_ACCOUNTS * sizeof(uint32_t));
+
+                /* Check 2.2.1: Run can't be written */
+                if (msync(database->mapping + database->header->balancesOffset + (uint64_t)Loc_First * DATABASE_PAGE_SIZE,
+                          (uint64_t)(Loc_Last - Loc_First) * DATABASE_PAGE_SIZE, MS_SYNC) != 0 ||
+                    msync(database->mapping + database->header->lastSequencesOffset + Loc_SequencesStart,
+                          Loc_SequencesEnd - Loc_SequencesStart, MS_SYNC) != 0)
+                {
+                    /* Update error state, Sync Failed! */
+                    Loc_ErrorState = DATABASE_SYNC_FAILED;
+                }
+            }
+        }
+    }
+
+    /* Check 3: Pages are written */
+    if (Loc_ErrorState == DATABASE_OK)
+    {
+        database->header->checkpointSequenceNumber = checkpointSequenceNumber;
+
+        /* Check 3.1: Header can't be written */
+        if (msync(database->mapping, DATABASE_PAGE_SIZE, MS_SYNC) != 0)
+        {
+            /* Update error state, Sync Failed! */
+            Loc_ErrorState = DATABASE_SYNC_FAILED;
+        }
+    }
+
+    /* Loop: Until the bitmap is cleared, or merged back into the marks of the next checkpoint */
+    for (uint32_t Loc_Word = 0; Loc_Word < database->bitmapWords; Loc_Word++)
+    {
+        /* Check: Checkpoint failed and the word has marks */
+        if (Loc_ErrorState != DATABASE_OK && Loc_Pages[Loc_Word] != 0)
+        {
+            __atomic_fetch_or(&database->dirtyPages[Loc_Word], Loc_Pages[Loc_Word], __ATOMIC_RELAXED);
+        }
+        Loc_Pages[Loc_Word] = 0;
+    }
+
+    /* Check 4: Checkpoint failed after accounts were added */
+    if (Loc_ErrorState != DATABASE_OK && database->checkpointFullSyncFlag == FLAG_UP)
+    {
+        database->fullSyncFlag = FLAG_UP;
+    }
+    database->checkpointFullSyncFlag = FLAG_DOWN;
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: databaseClose
+ Input: Pointer to Database structure
+ Output: void
+ Description: This function writes back the mapping, then unmaps and closes the accounts file.
+*/
+void databaseClose(ST_database_t *database)
+{
+    uint64_t Loc_FileSize = database->header->fileSize;
+
+    databaseSync(database);
+    indexFree(&database->index);
+    munmap(database->mapping, Loc_FileSize);
+    close(database->fileDescriptor);
+    free(database->dirtyPages);
+    free(database->checkpointPages);
+
+    database->fileDescriptor  = -1;
+    database->mapping         = NULL;
+    database->header          = NULL;
+    database->balances        = NULL;
+    database->states          = NULL;
+    database->lastSequences   = NULL;
+    database->keys            = NULL;
+    database->dirtyPages      = NULL;
+    database->checkpointPages = NULL;
+}
\ No newline at end of file
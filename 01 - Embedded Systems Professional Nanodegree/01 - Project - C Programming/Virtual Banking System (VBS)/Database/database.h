@@ -0,0 +1,70 @@
+#ifndef DATABASE_H_
+#define DATABASE_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define DATABASE_MAGIC				"VBSACCT"
+#define DATABASE_VERSION			8
+#define DATABASE_PAGE_SIZE			4096
+#define DATABASE_DEFAULT_CAPACITY	1048576		/* Account records reserved in a new file, the file is sparse */
+#define DATABASE_SCAN_LANES			16			/* Independent sums of a column scan, one vector register or more */
+#define DATABASE_BLOCK_ACCOUNTS		(DATABASE_PAGE_SIZE / sizeof(sint64_t))	/* Accounts of one balances page */
+
+typedef struct ST_databaseHeader_t
+{
+	uint8_t magic[8];
+	uint32_t version;
+	uint32_t keySize;					/* sizeof(ST_panKey_t) of the build that created the file */
+	uint32_t capacity;					/* Account records reserved */
+	uint32_t count;						/* Account records used */
+	uint32_t indexCapacity;				/* PAN index slots, a power of two */
+	uint32_t filterBlocks;				/* PAN filter blocks, a power of two */
+	uint32_t checkpointSequenceNumber;	/* First logged transaction not yet reflected in the file */
+	uint64_t indexOffset;
+	uint64_t filterOffset;
+	uint64_t balancesOffset;
+	uint64_t statesOffset;
+	uint64_t lastSequencesOffset;
+	uint64_t keysOffset;
+	uint64_t fileSize;
+}ST_databaseHeader_t;
+
+typedef struct ST_database_t
+{
+	sint32_t fileDescriptor;
+	uint8_t *mapping;
+	ST_databaseHeader_t *header;
+	sint64_t *balances;					/* Hot column, read and written by every authorization */
+	uint8_t *states;					/* Hot column, EN_accountState_t of every account in one byte */
+	uint32_t *lastSequences;			/* Last transaction of every account, or 0, head of its history chain */
+	ST_panKey_t *keys;					/* Key column, packed PANs only read by PAN lookups */
+	ST_panIndex_t index;
+	ST_panFilter_t filter;				/* Filter of the indexed PANs, read before the index */
+	uint64_t *dirtyPages;				/* Bit per block of accounts changed since the checkpoint cut */
+	uint64_t *checkpointPages;			/* Bit per block of accounts changed before the cut, being written */
+	uint32_t bitmapWords;				/* 64 bit words of each page bitmap */
+	EN_flagState_t fullSyncFlag;		/* Accounts were added, the index, states and keys must be written too */
+	EN_flagState_t checkpointFullSyncFlag;
+}ST_database_t;
+
+typedef enum EN_databaseError_t
+{
+	DATABASE_OK, DATABASE_OPEN_FAILED, DATABASE_BAD_FORMAT, DATABASE_FULL, DATABASE_DUPLICATE_ACCOUNT, DATABASE_SYNC_FAILED,
+	DATABASE_INVALID_ACCOUNT
+}EN_databaseError_t;
+
+/* Functions' Prototypes */
+EN_databaseError_t databaseOpen(ST_database_t *database, uint8_t *path, ST_accountsDB_t *defaultAccounts, uint32_t defaultCount);
+EN_databaseError_t databaseAddAccount(ST_database_t *database, ST_accountsDB_t *account, uint32_t *record);
+void databaseGetAccount(ST_database_t *database, uint32_t record, ST_accountsDB_t *account);
+EN_databaseError_t databaseReadAccounts(uint8_t *path, uint32_t firstRecord, uint32_t maxCount, ST_accountsDB_t *accounts, uint32_t *count);
+sint64_t databaseTotalBalance(ST_database_t *database);
+uint32_t databaseBlockedAccounts(ST_database_t *database);
+EN_databaseError_t databaseSync(ST_database_t *database);
+void databaseMarkAccount(ST_database_t *database, uint32_t record);
+void databaseBeginCheckpoint(ST_database_t *database);
+EN_databaseError_t databaseCheckpoint(ST_database_t *database, uint32_t checkpointSequenceNumber);
+void databaseClose(ST_database_t *database);
+
+#endif /* DATABASE_H_ */
\ No newline at end of file
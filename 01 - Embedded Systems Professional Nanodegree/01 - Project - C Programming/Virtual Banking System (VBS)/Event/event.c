@@ -0,0 +1,117 @@
+/* Standard Library */
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+/* Event Module */
+#include "event.h"
+
+/*
+ Name: eventMask
+ Input: uint32_t Event flags
+ Output: uint32_t epoll events
+ Description: Static Function to convert EVENT_READ and EVENT_WRITE to epoll events, level triggered.
+*/
+static uint32_t eventMask(uint32_t flags)
+{
+    return ((flags & EVENT_READ) ? EPOLLIN : 0) | ((flags & EVENT_WRITE) ? EPOLLOUT : 0);
+}
+
+/*
+ Name: eventOpen
+ Input: Pointer to Event descriptor
+ Output: EN_eventError_t Error or No Error
+ Description: 1. This function creates an epoll instance to wait on many sockets from one thread.
+              2. If the instance can't be created will return EVENT_FAILED, else return EVENT_OK.
+*/
+EN_eventError_t eventOpen(int *eventDescriptor)
+{
+    *eventDescriptor = epoll_create1(EPOLL_CLOEXEC);
+
+    return (*eventDescriptor < 0) ? EVENT_FAILED : EVENT_OK;
+}
+
+/*
+ Name: eventAdd
+ Input: int Event descriptor, int Socket descriptor, uint32_t Key, uint32_t Event flags
+ Output: EN_eventError_t Error or No Error
+ Description: 1. This function adds a socket to wait on for the flags, its events are returned with the key.
+              2. If the socket can't be added will return EVENT_FAILED, else return EVENT_OK.
+*/
+EN_eventError_t eventAdd(int eventDescriptor, int fileDescriptor, uint32_t key, uint32_t flags)
+{
+    struct epoll_event Loc_Event = {0};
+
+    Loc_Event.events   = eventMask(flags);
+    Loc_Event.data.u32 = key;
+
+    return (epoll_ctl(eventDescriptor, EPOLL_CTL_ADD, fileDescriptor, &Loc_Event) < 0) ? EVENT_FAILED : EVENT_OK;
+}
+
+/*
+ Name: eventModify
+ Input: int Event descriptor, int Socket descriptor, uint32_t Key, uint32_t Event flags
+ Output: EN_eventError_t Error or No Error
+ Description: 1. This function changes the flags waited on for an added socket.
+              2. If the flags can't be changed will return EVENT_FAILED, else return EVENT_OK.
+*/
+EN_eventError_t eventModify(int eventDescriptor, int fileDescriptor, uint32_t key, uint32_t flags)
+{
+    struct epoll_event Loc_Event = {0};
+
+    Loc_Event.events   = eventMask(flags);
+    Loc_Event.data.u32 = key;
+
+    return (epoll_ctl(eventDescriptor, EPOLL_CTL_MOD, fileDescriptor, &Loc_Event) < 0) ? EVENT_FAILED : EVENT_OK;
+}
+
+/*
+ Name: eventWait
+ Input: int Event descriptor, Pointer to Events, int Maximum number of events, int Timeout in milliseconds,
+        Pointer to int Number of events
+ Output: EN_eventError_t Error or No Error
+ Description: 1. This function waits until a socket is ready or the timeout, -1 waits without timeout, and
+                 returns the ready sockets. A signal ends the wait with no events.
+              2. If the wait fails will return EVENT_FAILED, else return EVENT_OK.
+*/
+EN_eventError_t eventWait(int eventDescriptor, ST_event_t *events, int maxCount, int timeout, int *count)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_eventError_t Loc_ErrorState = EVENT_OK;
+    struct epoll_event Loc_Events[maxCount];
+
+    *count = epoll_wait(eventDescriptor, Loc_Events, maxCount, timeout);
+
+    /* Check 1: Wait failed, or ended by a signal */
+    if (*count < 0)
+    {
+        /* Update error state, Failed unless ended by a signal! */
+        Loc_ErrorState = (errno == EINTR) ? EVENT_OK : EVENT_FAILED;
+        *count = 0;
+    }
+
+    /* Loop: Until all events are converted */
+    for (int Loc_Index = 0; Loc_Index < *count; Loc_Index++)
+    {
+        events[Loc_Index].key   = Loc_Events[Loc_Index].data.u32;
+        events[Loc_Index].flags = ((Loc_Events[Loc_Index].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) ? EVENT_READ : 0) |
+                                  ((Loc_Events[Loc_Index].events & EPOLLOUT) ? EVENT_WRITE : 0) |
+                                  ((Loc_Events[Loc_Index].events & (EPOLLHUP | EPOLLERR)) ? EVENT_CLOSED : 0);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: eventClose
+ Input: int Event descriptor
+ Output: void
+ Description: This function closes the epoll instance, sockets are closed by their owner.
+*/
+void eventClose(int eventDescriptor)
+{
+    close(eventDescriptor);
+}
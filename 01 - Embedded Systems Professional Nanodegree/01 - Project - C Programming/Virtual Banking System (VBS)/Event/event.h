@@ -0,0 +1,26 @@
+#ifndef EVENT_H_
+#define EVENT_H_
+
+#define EVENT_READ				0x1			/* Data to read, or the peer hung up */
+#define EVENT_WRITE				0x2			/* Room to write */
+#define EVENT_CLOSED			0x4			/* Peer hung up or the socket failed */
+
+typedef struct ST_event_t
+{
+	uint32_t key;							/* Key given when the socket was added */
+	uint32_t flags;							/* EVENT_READ, EVENT_WRITE and EVENT_CLOSED */
+}ST_event_t;
+
+typedef enum EN_eventError_t
+{
+	EVENT_OK, EVENT_FAILED
+}EN_eventError_t;
+
+/* Functions' Prototypes */
+EN_eventError_t eventOpen(int *eventDescriptor);
+EN_eventError_t eventAdd(int eventDescriptor, int fileDescriptor, uint32_t key, uint32_t flags);
+EN_eventError_t eventModify(int eventDescriptor, int fileDescriptor, uint32_t key, uint32_t flags);
+EN_eventError_t eventWait(int eventDescriptor, ST_event_t *events, int maxCount, int timeout, int *count);
+void eventClose(int eventDescriptor);
+
+#endif /* EVENT_H_ */
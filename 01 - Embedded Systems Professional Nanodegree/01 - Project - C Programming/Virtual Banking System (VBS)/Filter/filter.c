@@ -0,0 +1,172 @@
+/* Standard Library */
+#include <stdlib.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Filter Module */
+#include "filter.h"
+
+/*
+ Name: filterHash
+ Input: Pointer to PAN Key structure
+ Output: uint64_t Hash
+ Description: Static Function to hash a packed PAN with a different mix than the PAN index, so a PAN that collides
+              in the index is not more likely to pass the filter.
+*/
+static uint64_t filterHash(ST_panKey_t *panKey)
+{
+    uint64_t Loc_Hash = panKey->number ^ (panKey->length << 59);
+
+    Loc_Hash = (Loc_Hash ^ (Loc_Hash >> 33)) * 0xFF51AFD7ED558CCDULL;
+    Loc_Hash = (Loc_Hash ^ (Loc_Hash >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+
+    return Loc_Hash ^ (Loc_Hash >> 33);
+}
+
+/*
+ Name: filterBit
+ Input: uint64_t Hash, uint32_t Bit index
+ Output: uint32_t Bit in the block
+ Description: Static Function to choose the bits of a PAN inside its block from the high half of the hash, the
+              low half chooses the block. The step is odd, so the FILTER_HASHES bits are all different.
+*/
+static uint32_t filterBit(uint64_t hash, uint32_t index)
+{
+    return (uint32_t)((hash >> 32) + index * ((hash >> 41) | 1)) & (FILTER_BLOCK_BITS - 1);
+}
+
+/*
+ Name: filterBlockCount
+ Input: uint32_t Maximum number of accounts
+ Output: uint32_t Number of blocks
+ Description: This function gives the number of blocks of a filter for up to capacity accounts, the smallest power
+              of two with at least FILTER_BITS_PER_KEY bits per account.
+*/
+uint32_t filterBlockCount(uint32_t capacity)
+{
+    uint32_t Loc_Blocks = 1;
+
+    /* Loop: Until there are enough bits per account */
+    while ((uint64_t)Loc_Blocks * FILTER_BLOCK_BITS < (uint64_t)capacity * FILTER_BITS_PER_KEY)
+    {
+        Loc_Blocks *= 2;
+    }
+
+    return Loc_Blocks;
+}
+
+/*
+ Name: filterInit
+ Input: Pointer to Filter structure, uint32_t Maximum number of accounts
+ Output: EN_filterError_t Error or No Error
+ Description: 1. This function allocates an empty filter for up to capacity accounts.
+              2. If the blocks can't be allocated will return FILTER_NO_MEMORY, else return FILTER_OK.
+*/
+EN_filterError_t filterInit(ST_panFilter_t *filter, uint32_t capacity)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_filterError_t Loc_ErrorState = FILTER_OK;
+
+    filter->blockCount   = filterBlockCount(capacity);
+    filter->blocks       = calloc(filter->blockCount, sizeof(ST_filterBlock_t));
+    filter->attachedFlag = FLAG_DOWN;
+
+    /* Check: Allocation failed */
+    if (filter->blocks == NULL)
+    {
+        /* Update error state, No Memory! */
+        Loc_ErrorState = FILTER_NO_MEMORY;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: filterAttach
+ Input: Pointer to Filter structure, Pointer to Filter Blocks, uint32_t Number of blocks
+ Output: void
+ Description: This function uses blocks built earlier, e.g. stored in a mapped file, as the filter, nothing is
+              allocated or rebuilt. The number of blocks must be a power of two.
+*/
+void filterAttach(ST_panFilter_t *filter, ST_filterBlock_t *blocks, uint32_t blockCount)
+{
+    filter->blocks       = blocks;
+    filter->blockCount   = blockCount;
+    filter->attachedFlag = FLAG_UP;
+}
+
+/*
+ Name: filterAdd
+ Input: Pointer to Filter structure, Pointer to PAN Key structure
+ Output: void
+ Description: 1. This function adds a PAN to the filter, the filter is updated in place, it never needs a rebuild.
+              2. The hash chooses one block and FILTER_HASHES bits inside it, so a lookup reads one cache line.
+*/
+void filterAdd(ST_panFilter_t *filter, ST_panKey_t *panKey)
+{
+    uint64_t Loc_Hash = filterHash(panKey);
+    ST_filterBlock_t *Loc_Block = &filter->blocks[Loc_Hash & (filter->blockCount - 1)];
+    uint32_t Loc_Bit;
+
+    /* Loop: Until all bits of the PAN are set */
+    for (uint32_t Loc_Index = 0; Loc_Index < FILTER_HASHES; Loc_Index++)
+    {
+        Loc_Bit = filterBit(Loc_Hash, Loc_Index);
+        Loc_Block->words[Loc_Bit / 64] |= (uint64_t)1 << (Loc_Bit % 64);
+    }
+}
+
+/*
+ Name: filterFind
+ Input: Pointer to Filter structure, Pointer to PAN Key structure
+ Output: EN_filterError_t Error or No Error
+ Description: 1. This function checks if a PAN may have been added, reading one cache line.
+              2. If a bit of the PAN is not set the PAN was never added and will return FILTER_NOT_FOUND, else
+                 return FILTER_OK, the PAN was added or is a false positive.
+*/
+EN_filterError_t filterFind(ST_panFilter_t *filter, ST_panKey_t *panKey)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_filterError_t Loc_ErrorState = FILTER_OK;
+    uint64_t Loc_Hash = filterHash(panKey);
+    ST_filterBlock_t *Loc_Block = &filter->blocks[Loc_Hash & (filter->blockCount - 1)];
+    uint64_t Loc_Missing = 0;
+    uint32_t Loc_Bit;
+
+    /* Loop: Over all bits of the PAN, without a branch per bit */
+    for (uint32_t Loc_Index = 0; Loc_Index < FILTER_HASHES; Loc_Index++)
+    {
+        Loc_Bit      = filterBit(Loc_Hash, Loc_Index);
+        Loc_Missing |= ~Loc_Block->words[Loc_Bit / 64] & ((uint64_t)1 << (Loc_Bit % 64));
+    }
+
+    /* Check: A bit is not set */
+    if (Loc_Missing != 0)
+    {
+        /* Update error state, Not Found! */
+        Loc_ErrorState = FILTER_NOT_FOUND;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: filterFree
+ Input: Pointer to Filter structure
+ Output: void
+ Description: This function releases the memory held by the filter.
+*/
+void filterFree(ST_panFilter_t *filter)
+{
+    /* Check: Blocks are owned by the filter */
+    if (filter->attachedFlag == FLAG_DOWN)
+    {
+        free(filter->blocks);
+    }
+
+    filter->blocks = NULL;
+}
@@ -0,0 +1,36 @@
+#ifndef FILTER_H_
+#define FILTER_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define FILTER_BITS_PER_KEY			16			/* Filter bits per account, about 0.1% false positives */
+#define FILTER_BLOCK_BITS			512			/* Bits of a block, one cache line */
+#define FILTER_HASHES				8			/* Bits set per PAN, all in the same block */
+
+typedef struct ST_filterBlock_t
+{
+	uint64_t words[FILTER_BLOCK_BITS / 64];
+}ST_filterBlock_t;
+
+typedef struct ST_panFilter_t
+{
+	ST_filterBlock_t *blocks;
+	uint32_t blockCount;					/* A power of two */
+	EN_flagState_t attachedFlag;			/* Blocks are owned by the caller, e.g. a mapped file */
+}ST_panFilter_t;
+
+typedef enum EN_filterError_t
+{
+	FILTER_OK, FILTER_NOT_FOUND, FILTER_NO_MEMORY
+}EN_filterError_t;
+
+/* Functions' Prototypes */
+uint32_t filterBlockCount(uint32_t capacity);
+EN_filterError_t filterInit(ST_panFilter_t *filter, uint32_t capacity);
+void filterAttach(ST_panFilter_t *filter, ST_filterBlock_t *blocks, uint32_t blockCount);
+void filterAdd(ST_panFilter_t *filter, ST_panKey_t *panKey);
+EN_filterError_t filterFind(ST_panFilter_t *filter, ST_panKey_t *panKey);
+void filterFree(ST_panFilter_t *filter);
+
+#endif /* FILTER_H_ */
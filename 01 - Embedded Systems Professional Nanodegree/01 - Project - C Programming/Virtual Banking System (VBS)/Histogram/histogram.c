@@ -0,0 +1,186 @@
+/* Standard Library */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* Histogram Module */
+#include "histogram.h"
+
+/* Ticks of histogramNow per nanosecond, measured once by the first histogramTicksPerNanosecond call */
+static float64_t Glb_TicksPerNanosecond = 0;
+
+/*
+ Name: histogramBucket
+ Input: uint64_t Ticks
+ Output: uint32_t Bucket
+ Description: Static Function to find the bucket of a value. Values below 2^HISTOGRAM_SUB_BITS have a bucket each,
+              every larger power of two is split in 2^HISTOGRAM_SUB_BITS buckets by the bits after its top bit.
+*/
+static uint32_t histogramBucket(uint64_t ticks)
+{
+    /* Define local variable to set the bucket, the value itself for small values */
+    uint32_t Loc_Bucket = (uint32_t)ticks;
+    uint32_t Loc_Exponent;
+
+    /* Check 1: Value is too large, count it in the last bucket */
+    if (ticks >= (1ULL << HISTOGRAM_MAX_BITS))
+    {
+        Loc_Bucket = HISTOGRAM_BUCKETS - 1;
+    }
+    /* Check 2: Value is split by its top bit and the bits after it */
+    else if (ticks >= (1ULL << HISTOGRAM_SUB_BITS))
+    {
+        Loc_Exponent = 63 - __builtin_clzll(ticks);
+        Loc_Bucket   = ((Loc_Exponent - HISTOGRAM_SUB_BITS + 1) << HISTOGRAM_SUB_BITS) +
+                       (uint32_t)((ticks >> (Loc_Exponent - HISTOGRAM_SUB_BITS)) & ((1 << HISTOGRAM_SUB_BITS) - 1));
+    }
+
+    return Loc_Bucket;
+}
+
+/*
+ Name: histogramBucketValue
+ Input: uint32_t Bucket
+ Output: uint64_t Largest value of the bucket
+ Description: Static Function to give the largest value counted in a bucket.
+*/
+static uint64_t histogramBucketValue(uint32_t bucket)
+{
+    uint32_t Loc_Shift = (bucket >> HISTOGRAM_SUB_BITS == 0) ? 0 : (bucket >> HISTOGRAM_SUB_BITS) - 1;
+    uint64_t Loc_Base  = (bucket >> HISTOGRAM_SUB_BITS == 0) ? 0 : (1ULL << HISTOGRAM_SUB_BITS);
+
+    return ((Loc_Base + (bucket & ((1 << HISTOGRAM_SUB_BITS) - 1))) << Loc_Shift) + (1ULL << Loc_Shift) - 1;
+}
+
+/*
+ Name: histogramNow
+ Input: void
+ Output: uint64_t Ticks
+ Description: This function reads the time stamp counter, a few nanoseconds, or the monotonic clock in nanoseconds
+              where there is no such counter. Only differences of two readings are meaningful.
+*/
+uint64_t histogramNow(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec Loc_Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Now);
+
+    return Loc_Now.tv_sec * 1000000000ULL + Loc_Now.tv_nsec;
+#endif
+}
+
+/*
+ Name: histogramRecord
+ Input: Pointer to Histogram structure, uint64_t Ticks
+ Output: void
+ Description: This function counts a sample with one relaxed atomic add, threads record in the same histogram
+              without locks.
+*/
+void histogramRecord(ST_histogram_t *histogram, uint64_t ticks)
+{
+    __atomic_fetch_add(&histogram->counts[histogramBucket(ticks)], 1, __ATOMIC_RELAXED);
+}
+
+/*
+ Name: histogramReset
+ Input: Pointer to Histogram structure
+ Output: void
+ Description: This function clears all samples, samples recorded at the same time may be lost.
+*/
+void histogramReset(ST_histogram_t *histogram)
+{
+    memset(histogram->counts, 0, sizeof(histogram->counts));
+}
+
+/*
+ Name: histogramCount
+ Input: Pointer to Histogram structure
+ Output: uint64_t Number of samples
+ Description: This function sums the samples of all buckets.
+*/
+uint64_t histogramCount(ST_histogram_t *histogram)
+{
+    uint64_t Loc_Count = 0;
+
+    /* Loop: Until all buckets are summed */
+    for (uint32_t Loc_Bucket = 0; Loc_Bucket < HISTOGRAM_BUCKETS; Loc_Bucket++)
+    {
+        Loc_Count += __atomic_load_n(&histogram->counts[Loc_Bucket], __ATOMIC_RELAXED);
+    }
+
+    return Loc_Count;
+}
+
+/*
+ Name: histogramPercentile
+ Input: Pointer to Histogram structure, float64_t Fraction of samples
+ Output: uint64_t Ticks
+ Description: 1. This function gives the value that at least the fraction of samples did not exceed, as the largest
+                 value of its bucket, a fraction of 1 gives the largest sample.
+              2. If there is no sample will return 0.
+*/
+uint64_t histogramPercentile(ST_histogram_t *histogram, float64_t fraction)
+{
+    uint64_t Loc_Count = histogramCount(histogram);
+    uint64_t Loc_Rank  = (uint64_t)(fraction * Loc_Count + 0.999999);
+    uint64_t Loc_Seen  = 0;
+    uint32_t Loc_Bucket = 0;
+
+    Loc_Rank = (Loc_Rank == 0) ? 1 : Loc_Rank;
+
+    /* Loop: Until the samples seen reach the rank */
+    while (Loc_Bucket < HISTOGRAM_BUCKETS &&
+           (Loc_Seen += __atomic_load_n(&histogram->counts[Loc_Bucket], __ATOMIC_RELAXED)) < Loc_Rank)
+    {
+        Loc_Bucket++;
+    }
+
+    return (Loc_Count == 0) ? 0 : histogramBucketValue((Loc_Bucket < HISTOGRAM_BUCKETS) ? Loc_Bucket : HISTOGRAM_BUCKETS - 1);
+}
+
+/*
+ Name: histogramTicksPerNanosecond
+ Input: void
+ Output: float64_t Ticks per nanosecond
+ Description: This function measures the ticks of histogramNow against the monotonic clock over
+              HISTOGRAM_CALIBRATION_MS, once, and returns the same rate afterwards.
+*/
+float64_t histogramTicksPerNanosecond(void)
+{
+    struct timespec Loc_Start, Loc_End, Loc_Sleep = {0, HISTOGRAM_CALIBRATION_MS * 1000000L};
+    uint64_t Loc_StartTicks, Loc_EndTicks;
+
+    /* Check: Rate is not measured yet */
+    if (Glb_TicksPerNanosecond == 0)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &Loc_Start);
+        Loc_StartTicks = histogramNow();
+        nanosleep(&Loc_Sleep, NULL);
+        Loc_EndTicks = histogramNow();
+        clock_gettime(CLOCK_MONOTONIC, &Loc_End);
+
+        Glb_TicksPerNanosecond = (Loc_EndTicks - Loc_StartTicks) /
+                                 ((Loc_End.tv_sec - Loc_Start.tv_sec) * 1e9 + (Loc_End.tv_nsec - Loc_Start.tv_nsec));
+    }
+
+    return Glb_TicksPerNanosecond;
+}
+
+/*
+ Name: histogramPrint
+ Input: Pointer to Histogram structure, Pointer to name string
+ Output: void
+ Description: This function prints one line with the name, the number of samples and the p50, p99, p999 and largest
+              sample in nanoseconds.
+*/
+void histogramPrint(ST_histogram_t *histogram, uint8_t *name)
+{
+    float64_t Loc_Rate = histogramTicksPerNanosecond();
+
+    printf(" %-20s %10" PRIu64 " %10.0f %10.0f %10.0f %10.0f\n", name, histogramCount(histogram),
+           histogramPercentile(histogram, 0.50) / Loc_Rate, histogramPercentile(histogram, 0.99) / Loc_Rate,
+           histogramPercentile(histogram, 0.999) / Loc_Rate, histogramPercentile(histogram, 1.0) / Loc_Rate);
+}
@@ -0,0 +1,26 @@
+#ifndef HISTOGRAM_H_
+#define HISTOGRAM_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define HISTOGRAM_SUB_BITS			5			/* 32 buckets per power of two, a value is known within 3% */
+#define HISTOGRAM_MAX_BITS			40			/* Values from 2^40 ticks up share the last bucket */
+#define HISTOGRAM_BUCKETS			((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 1) << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_CALIBRATION_MS	20			/* Time the tick counter is measured against the clock */
+
+typedef struct ST_histogram_t
+{
+	uint64_t counts[HISTOGRAM_BUCKETS];		/* Samples of each bucket, added to with relaxed atomics */
+}ST_histogram_t;
+
+/* Functions' Prototypes */
+uint64_t histogramNow(void);
+void histogramRecord(ST_histogram_t *histogram, uint64_t ticks);
+void histogramReset(ST_histogram_t *histogram);
+uint64_t histogramCount(ST_histogram_t *histogram);
+uint64_t histogramPercentile(ST_histogram_t *histogram, float64_t fraction);
+float64_t histogramTicksPerNanosecond(void);
+void histogramPrint(ST_histogram_t *histogram, uint8_t *name);
+
+#endif /* HISTOGRAM_H_ */
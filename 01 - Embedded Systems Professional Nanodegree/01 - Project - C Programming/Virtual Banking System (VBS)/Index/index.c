@@ -0,0 +1,339 @@
+/* Standard Library */
+#include <stdlib.h>
+#include <string.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Index Module */
+#include "index.h"
+
+/*
+ Name: indexHash
+ Input: Pointer to PAN Key structure
+ Output: uint32_t Hash
+ Description: Static Function to hash a packed PAN with one multiply, then mix the high bits down so that PANs
+              sharing the same BIN prefix still spread over the whole table.
+*/
+static uint32_t indexHash(ST_panKey_t *panKey)
+{
+    uint64_t Loc_Hash = (panKey->number ^ (panKey->length << 59)) * 0x9E3779B97F4A7C15ULL;
+
+    return (uint32_t)((Loc_Hash ^ (Loc_Hash >> 32)) & 0xFFFFFFFF);
+}
+
+/*
+ Name: indexAllocTable
+ Input: Pointer to Index Table structure, uint32_t Capacity
+ Output: EN_indexError_t Error or No Error
+ Description: Static Function to allocate a table with all slots empty, capacity must be a power of two.
+*/
+static EN_indexError_t indexAllocTable(ST_indexTable_t *table, uint32_t capacity)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_indexError_t Loc_ErrorState = INDEX_OK;
+
+    /* Allocate all slots empty */
+    table->slots = calloc(capacity, sizeof(ST_indexSlot_t));
+
+    /* Check 1: Allocation failed */
+    if (table->slots == NULL)
+    {
+        /* Update error state, No Memory! */
+        Loc_ErrorState = INDEX_NO_MEMORY;
+    }
+    /* Check 2: Allocation succeeded */
+    else
+    {
+        table->capacity = capacity;
+        table->count    = 0;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: indexPlace
+ Input: Pointer to Index Table structure, uint32_t Hash, uint32_t Slot record (record + 1)
+ Output: void
+ Description: Static Function to put a record in the first empty slot of its probe sequence (linear probing).
+*/
+static void indexPlace(ST_indexTable_t *table, uint32_t hash, uint32_t record)
+{
+    uint32_t Loc_Mask = table->capacity - 1;
+    uint32_t Loc_Slot = hash & Loc_Mask;
+
+    /* Loop: Until an empty slot is found */
+    while (table->slots[Loc_Slot].record != INDEX_EMPTY_RECORD)
+    {
+        Loc_Slot = (Loc_Slot + 1) & Loc_Mask;
+    }
+
+    table->slots[Loc_Slot].hash   = hash;
+    table->slots[Loc_Slot].record = record;
+    table->count++;
+}
+
+/*
+ Name: indexProbe
+ Input: Pointer to Index structure, Pointer to Index Table structure, uint32_t Hash, Pointer to PAN Key structure,
+        Pointer to uint32_t Record
+ Output: EN_indexError_t Error or No Error
+ Description: Static Function to walk the probe sequence of one table, only slots with a matching hash are
+              compared against the PAN stored in the key column of the accounts.
+*/
+static EN_indexError_t indexProbe(ST_panIndex_t *index, ST_indexTable_t *table, uint32_t hash, ST_panKey_t *panKey, uint32_t *record)
+{
+    /* Define local variable to set the error state, Not Found */
+    EN_indexError_t Loc_ErrorState = INDEX_NOT_FOUND;
+    uint32_t Loc_Mask = table->capacity - 1;
+    uint32_t Loc_Slot = hash & Loc_Mask;
+
+    /* Loop: Until an empty slot ends the probe sequence */
+    while (table->slots[Loc_Slot].record != INDEX_EMPTY_RECORD)
+    {
+        /* Check: Hash matches and PAN matches */
+        if (table->slots[Loc_Slot].hash == hash &&
+            index->keys[table->slots[Loc_Slot].record - 1].number == panKey->number &&
+            index->keys[table->slots[Loc_Slot].record - 1].length == panKey->length)
+        {
+            *record = table->slots[Loc_Slot].record - 1;
+
+            /* Update error state, Record Found! */
+            Loc_ErrorState = INDEX_OK;
+            break;
+        }
+
+        Loc_Slot = (Loc_Slot + 1) & Loc_Mask;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: indexMigrate
+ Input: Pointer to Index structure, uint32_t Number of slots
+ Output: void
+ Description: Static Function to move some slots of the old table into the active table while the index grows.
+              Old slots are copied, not removed, so lookups in the old table stay valid until it is released.
+*/
+static void indexMigrate(ST_panIndex_t *index, uint32_t slots)
+{
+    /* Loop: Until the requested slots are moved or the old table is drained */
+    while (slots > 0 && index->migrateCursor < index->oldTable.capacity)
+    {
+        ST_indexSlot_t *Loc_Slot = &index->oldTable.slots[index->migrateCursor];
+
+        /* Check: Slot is used */
+        if (Loc_Slot->record != INDEX_EMPTY_RECORD)
+        {
+            indexPlace(&index->activeTable, Loc_Slot->hash, Loc_Slot->record);
+        }
+
+        index->migrateCursor++;
+        slots--;
+    }
+
+    /* Check: Old table is drained */
+    if (index->oldTable.slots != NULL && index->migrateCursor == index->oldTable.capacity)
+    {
+        free(index->oldTable.slots);
+        index->oldTable.slots    = NULL;
+        index->oldTable.capacity = 0;
+        index->oldTable.count    = 0;
+    }
+}
+
+/*
+ Name: indexGrow
+ Input: Pointer to Index structure
+ Output: EN_indexError_t Error or No Error
+ Description: Static Function to start growing the index, a table of double size becomes the active table and the
+              current one is drained into it a few slots per insert, so no single insert pays for a full rehash.
+*/
+static EN_indexError_t indexGrow(ST_panIndex_t *index)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_indexError_t Loc_ErrorState = INDEX_OK;
+    ST_indexTable_t Loc_NewTable;
+
+    /* Finish any previous migration first */
+    indexMigrate(index, 0xFFFFFFFF);
+
+    /* Check 1: New table allocated */
+    if (indexAllocTable(&Loc_NewTable, index->activeTable.capacity * 2) == INDEX_OK)
+    {
+        index->oldTable      = index->activeTable;
+        index->activeTable   = Loc_NewTable;
+        index->migrateCursor = 0;
+    }
+    /* Check 2: No memory */
+    else
+    {
+        /* Update error state, No Memory! */
+        Loc_ErrorState = INDEX_NO_MEMORY;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: indexInit
+ Input: Pointer to Index structure, Pointer to Accounts Key column, uint32_t Expected number of accounts
+ Output: EN_indexError_t Error or No Error
+ Description: 1. This function initializes an empty PAN index over the given accounts key column.
+              2. The table is sized so that the expected accounts fit below the maximum load.
+              3. If the table can't be allocated will return INDEX_NO_MEMORY, else return INDEX_OK.
+*/
+EN_indexError_t indexInit(ST_panIndex_t *index, ST_panKey_t *keys, uint32_t capacity)
+{
+    uint32_t Loc_Capacity = INDEX_MIN_CAPACITY;
+
+    /* Loop: Until expected accounts fit below the maximum load */
+    while ((uint64_t)Loc_Capacity * INDEX_MAX_LOAD_PERCENT / 100 < capacity)
+    {
+        Loc_Capacity *= 2;
+    }
+
+    index->keys              = keys;
+    index->count             = 0;
+    index->oldTable.slots    = NULL;
+    index->oldTable.capacity = 0;
+    index->oldTable.count    = 0;
+    index->migrateCursor     = 0;
+    index->attachedFlag      = FLAG_DOWN;
+
+    return indexAllocTable(&index->activeTable, Loc_Capacity);
+}
+
+/*
+ Name: indexAttach
+ Input: Pointer to Index structure, Pointer to Accounts Key column, Pointer to Slots, uint32_t Slots capacity,
+        uint32_t Number of indexed accounts
+ Output: EN_indexError_t Error or No Error
+ Description: 1. This function uses slots built earlier, e.g. stored in a mapped file, as the index table,
+                 nothing is allocated or rebuilt.
+              2. An attached index can't grow, once it is full inserts return INDEX_FULL.
+              3. If the capacity is not a power of two will return INDEX_FULL, else return INDEX_OK.
+*/
+EN_indexError_t indexAttach(ST_panIndex_t *index, ST_panKey_t *keys, ST_indexSlot_t *slots, uint32_t capacity, uint32_t count)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_indexError_t Loc_ErrorState = INDEX_OK;
+
+    /* Check: Capacity is zero or not a power of two */
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+    {
+        /* Update error state, Full! */
+        Loc_ErrorState = INDEX_FULL;
+    }
+
+    index->keys                 = keys;
+    index->count                = count;
+    index->activeTable.slots    = slots;
+    index->activeTable.capacity = capacity;
+    index->activeTable.count    = count;
+    index->oldTable.slots       = NULL;
+    index->oldTable.capacity    = 0;
+    index->oldTable.count       = 0;
+    index->migrateCursor        = 0;
+    index->attachedFlag         = FLAG_UP;
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: indexInsert
+ Input: Pointer to Index structure, uint32_t Record number in the accounts database
+ Output: EN_indexError_t Error or No Error
+ Description: 1. This function adds an account record to the index using the PAN stored in the record.
+              2. If the PAN is already indexed will return INDEX_DUPLICATE_KEY, if the index can't grow will return
+                 INDEX_NO_MEMORY, or INDEX_FULL for an attached index, else return INDEX_OK.
+*/
+EN_indexError_t indexInsert(ST_panIndex_t *index, uint32_t record)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_indexError_t Loc_ErrorState = INDEX_OK;
+    ST_panKey_t *Loc_PAN = &index->keys[record];
+    uint32_t Loc_Record;
+
+    /* Check 1: PAN is already indexed */
+    if (indexFind(index, Loc_PAN, &Loc_Record) == INDEX_OK)
+    {
+        /* Update error state, Duplicate Key! */
+        Loc_ErrorState = INDEX_DUPLICATE_KEY;
+    }
+    /* Check 2: Index is full */
+    else if ((uint64_t)(index->count + 1) * 100 > (uint64_t)index->activeTable.capacity * INDEX_MAX_LOAD_PERCENT)
+    {
+        /* Check 2.1: Attached index can't grow */
+        if (index->attachedFlag == FLAG_UP)
+        {
+            /* Update error state, Full! */
+            Loc_ErrorState = INDEX_FULL;
+        }
+        /* Check 2.2: Index can't grow */
+        else if (indexGrow(index) == INDEX_NO_MEMORY)
+        {
+            /* Update error state, No Memory! */
+            Loc_ErrorState = INDEX_NO_MEMORY;
+        }
+    }
+
+    /* Check 3: Index has room */
+    if (Loc_ErrorState == INDEX_OK)
+    {
+        /* Move part of the old table, if growing */
+        indexMigrate(index, INDEX_MIGRATE_STEP);
+
+        indexPlace(&index->activeTable, indexHash(Loc_PAN), record + 1);
+        index->count++;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: indexFind
+ Input: Pointer to Index structure, Pointer to PAN Key structure, Pointer to uint32_t Record
+ Output: EN_indexError_t Error or No Error
+ Description: 1. This function searches the index for a PAN.
+              2. While the index is growing both tables are searched, the active table first.
+              3. If the PAN is not indexed will return INDEX_NOT_FOUND, else return INDEX_OK and the record number.
+*/
+EN_indexError_t indexFind(ST_panIndex_t *index, ST_panKey_t *panKey, uint32_t *record)
+{
+    uint32_t Loc_Hash = indexHash(panKey);
+    /* Define local variable to set the error state, search the active table */
+    EN_indexError_t Loc_ErrorState = indexProbe(index, &index->activeTable, Loc_Hash, panKey, record);
+
+    /* Check: Not found and index is growing */
+    if (Loc_ErrorState == INDEX_NOT_FOUND && index->oldTable.slots != NULL)
+    {
+        Loc_ErrorState = indexProbe(index, &index->oldTable, Loc_Hash, panKey, record);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: indexFree
+ Input: Pointer to Index structure
+ Output: void
+ Description: This function releases the memory held by the index.
+*/
+void indexFree(ST_panIndex_t *index)
+{
+    /* Check: Slots are owned by the index */
+    if (index->attachedFlag == FLAG_DOWN)
+    {
+        free(index->activeTable.slots);
+    }
+    free(index->oldTable.slots);
+
+    index->activeTable.slots = NULL;
+    index->oldTable.slots    = NULL;
+}
\ No newline at end of file
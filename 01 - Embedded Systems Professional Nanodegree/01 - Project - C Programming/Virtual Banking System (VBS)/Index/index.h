@@ -0,0 +1,47 @@
+#ifndef INDEX_H_
+#define INDEX_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define INDEX_MIN_CAPACITY			64			/* Must be a power of two */
+#define INDEX_MAX_LOAD_PERCENT		75			/* Grow the index once it is 75% full */
+#define INDEX_MIGRATE_STEP			64			/* Old slots moved per insert while growing */
+#define INDEX_EMPTY_RECORD			0			/* Slots hold record + 1, so zeroed memory is an empty index */
+
+typedef struct ST_indexSlot_t
+{
+	uint32_t hash;
+	uint32_t record;
+}ST_indexSlot_t;
+
+typedef struct ST_indexTable_t
+{
+	ST_indexSlot_t *slots;
+	uint32_t capacity;
+	uint32_t count;
+}ST_indexTable_t;
+
+typedef struct ST_panIndex_t
+{
+	ST_panKey_t *keys;						/* Key column of the accounts, PANs are compared here */
+	ST_indexTable_t activeTable;
+	ST_indexTable_t oldTable;
+	uint32_t migrateCursor;
+	uint32_t count;
+	EN_flagState_t attachedFlag;			/* Slots are owned by the caller, e.g. a mapped file */
+}ST_panIndex_t;
+
+typedef enum EN_indexError_t
+{
+	INDEX_OK, INDEX_NOT_FOUND, INDEX_DUPLICATE_KEY, INDEX_NO_MEMORY, INDEX_FULL
+}EN_indexError_t;
+
+/* Functions' Prototypes */
+EN_indexError_t indexInit(ST_panIndex_t *index, ST_panKey_t *keys, uint32_t capacity);
+EN_indexError_t indexAttach(ST_panIndex_t *index, ST_panKey_t *keys, ST_indexSlot_t *slots, uint32_t capacity, uint32_t count);
+EN_indexError_t indexInsert(ST_panIndex_t *index, uint32_t record);
+EN_indexError_t indexFind(ST_panIndex_t *index, ST_panKey_t *panKey, uint32_t *record);
+void indexFree(ST_panIndex_t *index);
+
+#endif /* INDEX_H_ */
\ No newline at end of file
@@ -0,0 +1,505 @@
+/* fallocate */
+#define _GNU_SOURCE
+
+/* Standard Library */
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Log Module */
+#include "log.h"
+
+/*
+ Name: logChecksum
+ Input: Pointer to Log Record structure
+ Output: uint32_t Checksum
+ Description: Static Function to compute the FNV-1a checksum of a record, used to find torn records after a crash.
+*/
+static uint32_t logChecksum(ST_logRecord_t *record)
+{
+    uint8_t *Loc_Bytes = (uint8_t *)record;
+    uint32_t Loc_Checksum = 2166136261UL;
+
+    /* Loop: Over all bytes before the checksum field */
+    for (uint32_t Loc_Index = 0; Loc_Index < offsetof(ST_logRecord_t, checksum); Loc_Index++)
+    {
+        Loc_Checksum ^= Loc_Bytes[Loc_Index];
+        Loc_Checksum  = (Loc_Checksum * 16777619UL) & 0xFFFFFFFF;
+    }
+
+    return Loc_Checksum;
+}
+
+/*
+ Name: logWriteGroup
+ Input: Pointer to Log structure
+ Output: void
+ Description: Static Function called by the group leader with the lock held and the flushing flag up. It swaps the
+              buffers, so appends go on into the other buffer, then writes the whole group with one write and
+              one fdatasync, and wakes up every thread whose records are now durable.
+*/
+static void logWriteGroup(ST_log_t *log)
+{
+    ST_logRecord_t *Loc_Buffer = log->buffers[log->fillingBuffer];
+    uint64_t Loc_Size   = (uint64_t)log->bufferCount * sizeof(ST_logRecord_t);
+    uint64_t Loc_End    = log->appendedOffset;
+    uint64_t Loc_Offset = Loc_End - Loc_Size;
+    uint64_t Loc_Written = 0;
+    sint64_t Loc_Result = 0;
+
+    /* Swap buffers */
+    log->fillingBuffer ^= 1;
+    log->bufferCount    = 0;
+
+    pthread_mutex_unlock(&log->lock);
+
+    /* Loop: Until the whole group is written */
+    while (Loc_Written < Loc_Size && Loc_Result >= 0)
+    {
+        Loc_Result = pwrite(log->fileDescriptor, (uint8_t *)Loc_Buffer + Loc_Written, Loc_Size - Loc_Written, Loc_Offset + Loc_Written);
+        Loc_Written += (Loc_Result > 0) ? Loc_Result : 0;
+    }
+
+    /* Check: Group not fully written */
+    if (Loc_Written < Loc_Size || fdatasync(log->fileDescriptor) != 0)
+    {
+        Loc_Result = -1;
+    }
+
+    pthread_mutex_lock(&log->lock);
+
+    /* Check: Group written and synced */
+    if (Loc_Result >= 0)
+    {
+        log->durableOffset = Loc_End;
+    }
+    else
+    {
+        /* Log can't be trusted anymore, refuse further appends */
+        log->failedFlag = FLAG_UP;
+    }
+
+    log->flushingFlag = FLAG_DOWN;
+    pthread_cond_broadcast(&log->flushedCondition);
+}
+
+/*
+ Name: logOpen
+ Input: Pointer to Log structure, Pointer to file path, uint32_t First sequence number of a new log
+ Output: EN_logError_t Error or No Error
+ Description: 1. This function opens the log file, or creates it with the given first sequence number.
+              2. Records past the last one with a valid checksum are a torn write of the last group and are cut off.
+              3. If the file can't be opened will return LOG_OPEN_FAILED, if it is not a log of this build will return
+                 LOG_BAD_FORMAT, else return LOG_OK.
+*/
+EN_logError_t logOpen(ST_log_t *log, uint8_t *path, uint32_t firstSequenceNumber)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_logError_t Loc_ErrorState = LOG_OK;
+    ST_logHeader_t Loc_Header = {LOG_MAGIC};
+    ST_logRecord_t Loc_Record;
+    struct stat Loc_Status;
+    uint64_t Loc_Count = 0;
+
+    Loc_Header.version             = LOG_VERSION;
+    Loc_Header.recordSize          = sizeof(ST_logRecord_t);
+    Loc_Header.firstSequenceNumber = firstSequenceNumber;
+
+    log->fileDescriptor = open(path, O_RDWR | O_CREAT, 0644);
+
+    /* Check 1: File can't be opened */
+    if (log->fileDescriptor < 0 || fstat(log->fileDescriptor, &Loc_Status) != 0)
+    {
+        /* Update error state, Open Failed! */
+        Loc_ErrorState = LOG_OPEN_FAILED;
+    }
+    /* Check 2: File is new, write header */
+    else if (Loc_Status.st_size == 0)
+    {
+        /* Check 2.1: Header can't be written */
+        if (pwrite(log->fileDescriptor, &Loc_Header, sizeof(Loc_Header), 0) != sizeof(Loc_Header) || fdatasync(log->fileDescriptor) != 0)
+        {
+            /* Update error state, Open Failed! */
+            Loc_ErrorState = LOG_OPEN_FAILED;
+        }
+    }
+    /* Check 3: File exists, check header */
+    else if (pread(log->fileDescriptor, &Loc_Header, sizeof(Loc_Header), 0) != sizeof(Loc_Header) ||
+             memcmp(Loc_Header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 || Loc_Header.version != LOG_VERSION ||
+             Loc_Header.recordSize != sizeof(ST_logRecord_t))
+    {
+        /* Update error state, Bad Format! */
+        Loc_ErrorState = LOG_BAD_FORMAT;
+    }
+    /* Check 4: Log is valid, find its last complete record */
+    else
+    {
+        Loc_Count = (Loc_Status.st_size - sizeof(ST_logHeader_t)) / sizeof(ST_logRecord_t);
+
+        /* Loop: Drop records of a torn last group */
+        while (Loc_Count > 0 &&
+               (pread(log->fileDescriptor, &Loc_Record, sizeof(Loc_Record), sizeof(ST_logHeader_t) + (Loc_Count - 1) * sizeof(ST_logRecord_t)) != sizeof(Loc_Record) ||
+                Loc_Record.checksum != logChecksum(&Loc_Record)))
+        {
+            Loc_Count--;
+        }
+
+        ftruncate(log->fileDescriptor, sizeof(ST_logHeader_t) + Loc_Count * sizeof(ST_logRecord_t));
+    }
+
+    /* Check 5: Log is open */
+    if (Loc_ErrorState == LOG_OK)
+    {
+        log->buffers[0] = malloc(LOG_BUFFER_RECORDS * sizeof(ST_logRecord_t));
+        log->buffers[1] = malloc(LOG_BUFFER_RECORDS * sizeof(ST_logRecord_t));
+
+        log->fillingBuffer       = 0;
+        log->bufferCount         = 0;
+        log->waiters             = 0;
+        log->appendedOffset      = sizeof(ST_logHeader_t) + Loc_Count * sizeof(ST_logRecord_t);
+        log->durableOffset       = log->appendedOffset;
+        log->firstSequenceNumber = Loc_Header.firstSequenceNumber;
+        log->nextSequenceNumber  = Loc_Header.firstSequenceNumber + Loc_Count;
+        log->flushingFlag        = FLAG_DOWN;
+        log->failedFlag          = FLAG_DOWN;
+
+        pthread_mutex_init(&log->lock, NULL);
+        pthread_cond_init(&log->appendedCondition, NULL);
+        pthread_cond_init(&log->flushedCondition, NULL);
+
+        /* Check 5.1: No memory for buffers */
+        if (log->buffers[0] == NULL || log->buffers[1] == NULL)
+        {
+            /* Update error state, Open Failed! */
+            Loc_ErrorState = LOG_OPEN_FAILED;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: logFollow
+ Input: Pointer to Log structure, Pointer to file path
+ Output: EN_logError_t Error or No Error
+ Description: 1. This function opens the log of another server read only, to follow the records it appends.
+              2. The file is never written nor cut, logAppend always fails on a followed log, logRead reads the
+                 records written so far, logPoll finds the records written since.
+              3. A record written by the other server is found before it is synced, a record in the middle of a
+                 write fails its checksum and is not found until the write is over.
+              4. If the file can't be opened will return LOG_OPEN_FAILED, if it is not a log of this build will
+                 return LOG_BAD_FORMAT, else return LOG_OK.
+*/
+EN_logError_t logFollow(ST_log_t *log, uint8_t *path)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_logError_t Loc_ErrorState = LOG_OK;
+    ST_logHeader_t Loc_Header;
+
+    log->fileDescriptor = open(path, O_RDONLY);
+
+    /* Check 1: File can't be opened */
+    if (log->fileDescriptor < 0)
+    {
+        /* Update error state, Open Failed! */
+        Loc_ErrorState = LOG_OPEN_FAILED;
+    }
+    /* Check 2: File is not a log of this build */
+    else if (pread(log->fileDescriptor, &Loc_Header, sizeof(Loc_Header), 0) != sizeof(Loc_Header) ||
+             memcmp(Loc_Header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 || Loc_Header.version != LOG_VERSION ||
+             Loc_Header.recordSize != sizeof(ST_logRecord_t))
+    {
+        close(log->fileDescriptor);
+
+        /* Update error state, Bad Format! */
+        Loc_ErrorState = LOG_BAD_FORMAT;
+    }
+    /* Check 3: Log is open, without buffers, appends are refused */
+    else
+    {
+        log->buffers[0]          = NULL;
+        log->buffers[1]          = NULL;
+        log->fillingBuffer       = 0;
+        log->bufferCount         = 0;
+        log->waiters             = 0;
+        log->appendedOffset      = sizeof(ST_logHeader_t);
+        log->durableOffset       = sizeof(ST_logHeader_t);
+        log->polledSize          = sizeof(ST_logHeader_t);
+        log->firstSequenceNumber = Loc_Header.firstSequenceNumber;
+        log->nextSequenceNumber  = Loc_Header.firstSequenceNumber;
+        log->flushingFlag        = FLAG_DOWN;
+        log->failedFlag          = FLAG_UP;
+
+        pthread_mutex_init(&log->lock, NULL);
+        pthread_cond_init(&log->appendedCondition, NULL);
+        pthread_cond_init(&log->flushedCondition, NULL);
+
+        logPoll(log);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: logPoll
+ Input: Pointer to Log structure
+ Output: uint32_t Next sequence number
+ Description: This function finds the records written to a followed log since it was opened or last polled, from
+              the file size, which it keeps in polledSize, and returns the sequence number after the last one.
+*/
+uint32_t logPoll(ST_log_t *log)
+{
+    struct stat Loc_Status;
+    uint64_t Loc_Count;
+    uint32_t Loc_NextSequence;
+
+    pthread_mutex_lock(&log->lock);
+
+    /* Check: File size is known and holds more whole records */
+    if (fstat(log->fileDescriptor, &Loc_Status) == 0 && (uint64_t)Loc_Status.st_size > log->durableOffset)
+    {
+        __atomic_store_n(&log->polledSize, (uint64_t)Loc_Status.st_size, __ATOMIC_RELAXED);
+
+        Loc_Count = ((uint64_t)Loc_Status.st_size - sizeof(ST_logHeader_t)) / sizeof(ST_logRecord_t);
+
+        log->durableOffset      = sizeof(ST_logHeader_t) + Loc_Count * sizeof(ST_logRecord_t);
+        log->appendedOffset     = log->durableOffset;
+        log->nextSequenceNumber = log->firstSequenceNumber + Loc_Count;
+    }
+
+    Loc_NextSequence = log->nextSequenceNumber;
+    pthread_mutex_unlock(&log->lock);
+
+    return Loc_NextSequence;
+}
+
+/*
+ Name: logOffset
+ Input: Pointer to Log structure, uint32_t Transaction Number
+ Output: uint64_t File offset
+ Description: This function returns the file offset of the record of a sequence number, records are fixed size
+              and keep their offset once released, the offset of the next sequence number is the end of the log.
+*/
+uint64_t logOffset(ST_log_t *log, uint32_t transactionSequenceNumber)
+{
+    return sizeof(ST_logHeader_t) + (uint64_t)(transactionSequenceNumber - log->firstSequenceNumber) * sizeof(ST_logRecord_t);
+}
+
+/*
+ Name: logAppend
+ Input: Pointer to Log structure, Pointer to Log Records, uint32_t Number of records, Pointer to uint64_t Offset
+ Output: EN_logError_t Error or No Error
+ Description: 1. This function copies records into the log buffer, they are not durable until logCommit returns.
+              2. Records must be appended in sequence number order, at most LOG_BUFFER_RECORDS at a time.
+              3. If the log failed before will return LOG_WRITE_FAILED, else return LOG_OK and the offset to commit.
+*/
+EN_logError_t logAppend(ST_log_t *log, ST_logRecord_t *records, uint32_t count, uint64_t *offset)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_logError_t Loc_ErrorState = LOG_OK;
+
+    /* Loop: Checksum records before taking the lock */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+    {
+        records[Loc_Index].checksum = logChecksum(&records[Loc_Index]);
+    }
+
+    pthread_mutex_lock(&log->lock);
+
+    /* Loop: Until records fit in the filling buffer */
+    while (log->failedFlag == FLAG_DOWN && count <= LOG_BUFFER_RECORDS && log->bufferCount + count > LOG_BUFFER_RECORDS)
+    {
+        /* Check: Group is being written, wait for it, else write the full buffer now */
+        if (log->flushingFlag == FLAG_UP)
+        {
+            pthread_cond_wait(&log->flushedCondition, &log->lock);
+        }
+        else
+        {
+            log->flushingFlag = FLAG_UP;
+            logWriteGroup(log);
+        }
+    }
+
+    /* Check 1: Log failed or too many records */
+    if (log->failedFlag == FLAG_UP || count > LOG_BUFFER_RECORDS)
+    {
+        /* Update error state, Write Failed! */
+        Loc_ErrorState = LOG_WRITE_FAILED;
+    }
+    /* Check 2: Records fit */
+    else
+    {
+        memcpy(&log->buffers[log->fillingBuffer][log->bufferCount], records, count * sizeof(ST_logRecord_t));
+
+        log->bufferCount        += count;
+        log->appendedOffset     += (uint64_t)count * sizeof(ST_logRecord_t);
+        log->nextSequenceNumber += count;
+        *offset = log->appendedOffset;
+
+        pthread_cond_signal(&log->appendedCondition);
+    }
+
+    pthread_mutex_unlock(&log->lock);
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: logCommit
+ Input: Pointer to Log structure, uint64_t Offset returned by logAppend
+ Output: EN_logError_t Error or No Error
+ Description: 1. This function waits until all records up to the offset are written and synced.
+              2. The first waiter becomes the group leader. If other threads are waiting too, the leader gives them
+                 up to LOG_GROUP_COMMIT_DELAY_US to append, then writes all appended records with one fdatasync.
+              3. The other waiters sleep until a group covering their records is durable.
+              4. If the records can't be written will return LOG_WRITE_FAILED, else return LOG_OK.
+*/
+EN_logError_t logCommit(ST_log_t *log, uint64_t offset)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_logError_t Loc_ErrorState = LOG_OK;
+    struct timespec Loc_Deadline;
+
+    pthread_mutex_lock(&log->lock);
+    log->waiters++;
+
+    /* Loop: Until records are durable */
+    while (log->durableOffset < offset && log->failedFlag == FLAG_DOWN)
+    {
+        /* Check 1: Another leader is writing, wait for its group */
+        if (log->flushingFlag == FLAG_UP)
+        {
+            pthread_cond_wait(&log->flushedCondition, &log->lock);
+        }
+        /* Check 2: Become leader */
+        else
+        {
+            log->flushingFlag = FLAG_UP;
+
+            /* Check 2.1: Other threads are committing, give them time to join the group */
+            if (log->waiters > 1)
+            {
+                clock_gettime(CLOCK_REALTIME, &Loc_Deadline);
+                Loc_Deadline.tv_nsec += LOG_GROUP_COMMIT_DELAY_US * 1000L;
+                Loc_Deadline.tv_sec  += Loc_Deadline.tv_nsec / 1000000000L;
+                Loc_Deadline.tv_nsec %= 1000000000L;
+
+                /* Loop: Until group is big enough or delay is over */
+                while (log->bufferCount < LOG_GROUP_COMMIT_RECORDS &&
+                       pthread_cond_timedwait(&log->appendedCondition, &log->lock, &Loc_Deadline) == 0)
+                {
+                }
+            }
+
+            logWriteGroup(log);
+        }
+    }
+
+    /* Check 3: Records are not durable */
+    if (log->durableOffset < offset)
+    {
+        /* Update error state, Write Failed! */
+        Loc_ErrorState = LOG_WRITE_FAILED;
+    }
+
+    log->waiters--;
+    pthread_mutex_unlock(&log->lock);
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: logRead
+ Input: Pointer to Log structure, uint32_t Transaction sequence number, Pointer to Log Record structure
+ Output: EN_logError_t Error or No Error
+ Description: 1. This function reads a durable record back from the log file.
+              2. Records have a fixed size and consecutive sequence numbers, so the record is read at a computed offset.
+              3. If the record is not in the log or not durable yet will return LOG_NOT_FOUND, else return LOG_OK.
+*/
+EN_logError_t logRead(ST_log_t *log, uint32_t transactionSequenceNumber, ST_logRecord_t *record)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_logError_t Loc_ErrorState = LOG_OK;
+    uint64_t Loc_Offset = sizeof(ST_logHeader_t) + (uint64_t)(transactionSequenceNumber - log->firstSequenceNumber) * sizeof(ST_logRecord_t);
+    uint64_t Loc_DurableOffset;
+
+    pthread_mutex_lock(&log->lock);
+    Loc_DurableOffset = log->durableOffset;
+    pthread_mutex_unlock(&log->lock);
+
+    /* Check: Sequence number out of log, not durable, or record damaged */
+    if (transactionSequenceNumber < log->firstSequenceNumber || Loc_Offset + sizeof(ST_logRecord_t) > Loc_DurableOffset ||
+        pread(log->fileDescriptor, record, sizeof(ST_logRecord_t), Loc_Offset) != sizeof(ST_logRecord_t) ||
+        record->checksum != logChecksum(record))
+    {
+        /* Update error state, Not Found! */
+        Loc_ErrorState = LOG_NOT_FOUND;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: logRelease
+ Input: Pointer to Log structure, uint32_t First sequence number kept
+ Output: EN_logError_t Error or No Error
+ Description: 1. This function gives the disk space of the records before a sequence number back to the file system,
+                 with a hole punched into the file, the offsets of the other records don't change.
+              2. Released records read back as not found, only records kept elsewhere and not replayed on a restart
+                 may be released. The last record of the log is never released, logOpen reads it to find the end.
+              3. If the file system can't punch holes will return LOG_WRITE_FAILED and the records are kept, else
+                 return LOG_OK.
+*/
+EN_logError_t logRelease(ST_log_t *log, uint32_t transactionSequenceNumber)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_logError_t Loc_ErrorState = LOG_OK;
+    uint32_t Loc_Last;
+
+    pthread_mutex_lock(&log->lock);
+    Loc_Last = log->nextSequenceNumber - 1;
+    pthread_mutex_unlock(&log->lock);
+
+    transactionSequenceNumber = (transactionSequenceNumber < Loc_Last) ? transactionSequenceNumber : Loc_Last;
+
+    /* Check: Records to release, and the hole can't be punched */
+    if (transactionSequenceNumber > log->firstSequenceNumber &&
+        fallocate(log->fileDescriptor, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, sizeof(ST_logHeader_t),
+                  (uint64_t)(transactionSequenceNumber - log->firstSequenceNumber) * sizeof(ST_logRecord_t)) != 0)
+    {
+        /* Update error state, Write Failed! */
+        Loc_ErrorState = LOG_WRITE_FAILED;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: logClose
+ Input: Pointer to Log structure
+ Output: void
+ Description: This function commits all appended records, then closes the log file.
+*/
+void logClose(ST_log_t *log)
+{
+    logCommit(log, log->appendedOffset);
+    close(log->fileDescriptor);
+
+    free(log->buffers[0]);
+    free(log->buffers[1]);
+
+    pthread_mutex_destroy(&log->lock);
+    pthread_cond_destroy(&log->appendedCondition);
+    pthread_cond_destroy(&log->flushedCondition);
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef LOG_H_
+#define LOG_H_
+
+/* Standard Library */
+#include <pthread.h>
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define LOG_MAGIC					"VBSWLOG"
+#define LOG_VERSION					4
+#define LOG_BUFFER_RECORDS			4096		/* Records appended while the previous group is written */
+#define LOG_GROUP_COMMIT_RECORDS	256			/* Group is written once it holds this many records ... */
+#define LOG_GROUP_COMMIT_DELAY_US	200			/* ... or once its first record waited this long */
+#define LOG_NO_ACCOUNT				0xFFFFFFFF
+
+typedef struct ST_logHeader_t
+{
+	uint8_t magic[8];
+	uint32_t version;
+	uint32_t recordSize;
+	uint32_t firstSequenceNumber;
+}ST_logHeader_t;
+
+typedef struct ST_logRecord_t
+{
+	ST_transaction_t transaction;
+	uint32_t record;					/* Account record in accountsDB, or LOG_NO_ACCOUNT */
+	sint64_t balance;					/* Account balance after the transaction, in cents */
+	uint32_t previousSequenceNumber;	/* Previous transaction of the same account, or 0 */
+	uint32_t checksum;
+}ST_logRecord_t;
+
+typedef struct ST_log_t
+{
+	sint32_t fileDescriptor;
+	pthread_mutex_t lock;
+	pthread_cond_t appendedCondition;
+	pthread_cond_t flushedCondition;
+	ST_logRecord_t *buffers[2];
+	uint32_t fillingBuffer;				/* Buffer receiving appends, the other one may be in write */
+	uint32_t bufferCount;
+	uint32_t waiters;					/* Threads waiting in logCommit */
+	uint64_t appendedOffset;			/* File offset after the last appended record */
+	uint64_t durableOffset;				/* File offset after the last synced record */
+	uint64_t polledSize;				/* File size found by the last poll of a followed log, a record being written included */
+	uint32_t firstSequenceNumber;
+	uint32_t nextSequenceNumber;
+	EN_flagState_t flushingFlag;
+	EN_flagState_t failedFlag;
+}ST_log_t;
+
+typedef enum EN_logError_t
+{
+	LOG_OK, LOG_OPEN_FAILED, LOG_BAD_FORMAT, LOG_WRITE_FAILED, LOG_NOT_FOUND
+}EN_logError_t;
+
+/* Functions' Prototypes */
+EN_logError_t logOpen(ST_log_t *log, uint8_t *path, uint32_t firstSequenceNumber);
+EN_logError_t logFollow(ST_log_t *log, uint8_t *path);
+uint32_t logPoll(ST_log_t *log);
+uint64_t logOffset(ST_log_t *log, uint32_t transactionSequenceNumber);
+EN_logError_t logAppend(ST_log_t *log, ST_logRecord_t *records, uint32_t count, uint64_t *offset);
+EN_logError_t logCommit(ST_log_t *log, uint64_t offset);
+EN_logError_t logRead(ST_log_t *log, uint32_t transactionSequenceNumber, ST_logRecord_t *record);
+EN_logError_t logRelease(ST_log_t *log, uint32_t transactionSequenceNumber);
+void logClose(ST_log_t *log);
+
+#endif /* LOG_H_ */
\ No newline at end of file
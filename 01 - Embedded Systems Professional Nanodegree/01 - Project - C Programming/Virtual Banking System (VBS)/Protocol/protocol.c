@@ -0,0 +1,265 @@
+/* Standard Library */
+#include <string.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Protocol Module */
+#include "protocol.h"
+
+/*
+ Name: protocolPutNumber
+ Input: Pointer to Buffer, uint64_t Value, uint32_t Number of bytes
+ Output: void
+ Description: This function writes the low size bytes of a number, least significant byte first.
+*/
+void protocolPutNumber(uint8_t *buffer, uint64_t value, uint32_t size)
+{
+    /* Loop: Until all bytes are written */
+    for (uint32_t Loc_Index = 0; Loc_Index < size; Loc_Index++)
+    {
+        buffer[Loc_Index] = (uint8_t)(value >> (8 * Loc_Index));
+    }
+}
+
+/*
+ Name: protocolGetNumber
+ Input: Pointer to Buffer, uint32_t Number of bytes
+ Output: uint64_t Value
+ Description: This function reads a number of size bytes, least significant byte first.
+*/
+uint64_t protocolGetNumber(uint8_t *buffer, uint32_t size)
+{
+    uint64_t Loc_Value = 0;
+
+    /* Loop: Until all bytes are read */
+    for (uint32_t Loc_Index = 0; Loc_Index < size; Loc_Index++)
+    {
+        Loc_Value |= (uint64_t)buffer[Loc_Index] << (8 * Loc_Index);
+    }
+
+    return Loc_Value;
+}
+
+/*
+ Name: protocolPutString
+ Input: Pointer to Buffer, Pointer to String, uint32_t Size of the string field
+ Output: uint32_t Number of bytes written
+ Description: This function writes a string as its length in one byte then its characters, without the unused
+              end of its field.
+*/
+uint32_t protocolPutString(uint8_t *buffer, uint8_t *string, uint32_t capacity)
+{
+    uint32_t Loc_Length = strnlen((char *)string, capacity - 1);
+
+    buffer[0] = (uint8_t)Loc_Length;
+    memcpy(&buffer[1], string, Loc_Length);
+
+    return 1 + Loc_Length;
+}
+
+/*
+ Name: protocolGetString
+ Input: Pointer to Buffer, uint32_t Bytes in the buffer, Pointer to String, uint32_t Size of the string field
+ Output: uint32_t Number of bytes read
+ Description: 1. This function reads a string written by protocolPutString, the rest of its field is cleared.
+              2. If the string is cut or doesn't fit its field will return 0.
+*/
+uint32_t protocolGetString(uint8_t *buffer, uint32_t size, uint8_t *string, uint32_t capacity)
+{
+    /* Define local variable to set the bytes read, None */
+    uint32_t Loc_Read = 0;
+
+    /* Check: Length is in the buffer, string fits its field and is in the buffer */
+    if (size > 0 && buffer[0] < capacity && 1 + (uint32_t)buffer[0] <= size)
+    {
+        memset(string, 0, capacity);
+        memcpy(string, &buffer[1], buffer[0]);
+
+        Loc_Read = 1 + buffer[0];
+    }
+
+    return Loc_Read;
+}
+
+/*
+ Name: protocolPutCard
+ Input: Pointer to Buffer, Pointer to Card Data structure
+ Output: uint32_t Number of bytes written
+ Description: This function writes the card data, a PAN of digits only is written packed, its number of digits
+              with PROTOCOL_PACKED_PAN then the 8 bytes of its number.
+*/
+uint32_t protocolPutCard(uint8_t *buffer, ST_cardData_t *cardData)
+{
+    uint32_t Loc_Written = protocolPutString(buffer, cardData->cardHolderName, sizeof(cardData->cardHolderName));
+    ST_panKey_t Loc_PanKey;
+
+    /* Check 1: PAN packs to a key */
+    if (packCardPAN(cardData->primaryAccountNumber, &Loc_PanKey) == CARD_OK)
+    {
+        buffer[Loc_Written] = PROTOCOL_PACKED_PAN | (uint8_t)Loc_PanKey.length;
+        protocolPutNumber(&buffer[Loc_Written + 1], Loc_PanKey.number, 8);
+        Loc_Written += 9;
+    }
+    /* Check 2: PAN is kept as a string */
+    else
+    {
+        Loc_Written += protocolPutString(&buffer[Loc_Written], cardData->primaryAccountNumber, sizeof(cardData->primaryAccountNumber));
+    }
+
+    return Loc_Written + protocolPutString(&buffer[Loc_Written], cardData->cardExpirationDate, sizeof(cardData->cardExpirationDate));
+}
+
+/*
+ Name: protocolGetCard
+ Input: Pointer to Buffer, uint32_t Bytes in the buffer, Pointer to Card Data structure
+ Output: uint32_t Number of bytes read
+ Description: 1. This function reads card data written by protocolPutCard.
+              2. If the card data is cut or malformed will return 0.
+*/
+uint32_t protocolGetCard(uint8_t *buffer, uint32_t size, ST_cardData_t *cardData)
+{
+    uint32_t Loc_Read = protocolGetString(buffer, size, cardData->cardHolderName, sizeof(cardData->cardHolderName));
+    uint32_t Loc_Field = 0;
+    ST_panKey_t Loc_PanKey;
+
+    /* Check 1: Name is read and the PAN is packed */
+    if (Loc_Read > 0 && Loc_Read < size && (buffer[Loc_Read] & PROTOCOL_PACKED_PAN) != 0)
+    {
+        Loc_PanKey.length = buffer[Loc_Read] & ~PROTOCOL_PACKED_PAN;
+
+        /* Check 1.1: Number is in the buffer and has at most 19 digits */
+        if (Loc_Read + 9 <= size && Loc_PanKey.length > 0 && Loc_PanKey.length < sizeof(cardData->primaryAccountNumber))
+        {
+            Loc_PanKey.number = protocolGetNumber(&buffer[Loc_Read + 1], 8);
+            memset(cardData->primaryAccountNumber, 0, sizeof(cardData->primaryAccountNumber));
+            unpackCardPAN(&Loc_PanKey, cardData->primaryAccountNumber);
+
+            Loc_Field = 9;
+        }
+    }
+    /* Check 2: Name is read and the PAN is a string */
+    else if (Loc_Read > 0)
+    {
+        Loc_Field = protocolGetString(&buffer[Loc_Read], size - Loc_Read, cardData->primaryAccountNumber, sizeof(cardData->primaryAccountNumber));
+    }
+
+    /* Check 3: PAN is read */
+    if (Loc_Field > 0)
+    {
+        Loc_Read += Loc_Field;
+        Loc_Field = protocolGetString(&buffer[Loc_Read], size - Loc_Read, cardData->cardExpirationDate, sizeof(cardData->cardExpirationDate));
+    }
+
+    return (Loc_Field > 0) ? Loc_Read + Loc_Field : 0;
+}
+
+/*
+ Name: protocolPutTransaction
+ Input: Pointer to Buffer, Pointer to Transaction structure
+ Output: uint32_t Number of bytes written
+ Description: This function writes a transaction, its card data, the amounts in 8 bytes, the date string, the
+              terminal id and request id in 4 bytes each, the state in one byte and the sequence number in 4 bytes,
+              at most PROTOCOL_TRANSACTION_SIZE bytes.
+*/
+uint32_t protocolPutTransaction(uint8_t *buffer, ST_transaction_t *transData)
+{
+    uint32_t Loc_Written = protocolPutCard(buffer, &transData->cardHolderData);
+
+    protocolPutNumber(&buffer[Loc_Written], (uint64_t)transData->terminalData.transAmount, 8);
+    protocolPutNumber(&buffer[Loc_Written + 8], (uint64_t)transData->terminalData.maxTransAmount, 8);
+    Loc_Written += 16;
+    Loc_Written += protocolPutString(&buffer[Loc_Written], transData->terminalData.transactionDate, sizeof(transData->terminalData.transactionDate));
+    protocolPutNumber(&buffer[Loc_Written], transData->terminalData.terminalId, 4);
+    protocolPutNumber(&buffer[Loc_Written + 4], transData->terminalData.requestId, 4);
+    Loc_Written += 8;
+
+    buffer[Loc_Written] = (uint8_t)transData->transState;
+    protocolPutNumber(&buffer[Loc_Written + 1], transData->transactionSequenceNumber, 4);
+
+    return Loc_Written + 5;
+}
+
+/*
+ Name: protocolGetTransaction
+ Input: Pointer to Buffer, uint32_t Bytes in the buffer, Pointer to Transaction structure
+ Output: uint32_t Number of bytes read
+ Description: 1. This function reads a transaction written by protocolPutTransaction.
+              2. If the transaction is cut or malformed will return 0.
+*/
+uint32_t protocolGetTransaction(uint8_t *buffer, uint32_t size, ST_transaction_t *transData)
+{
+    uint32_t Loc_Read = protocolGetCard(buffer, size, &transData->cardHolderData);
+    uint32_t Loc_Field = 0;
+
+    /* Check 1: Card data and amounts are read */
+    if (Loc_Read > 0 && Loc_Read + 16 <= size)
+    {
+        transData->terminalData.transAmount    = (sint64_t)protocolGetNumber(&buffer[Loc_Read], 8);
+        transData->terminalData.maxTransAmount = (sint64_t)protocolGetNumber(&buffer[Loc_Read + 8], 8);
+        Loc_Read += 16;
+
+        Loc_Field = protocolGetString(&buffer[Loc_Read], size - Loc_Read, transData->terminalData.transactionDate,
+                                      sizeof(transData->terminalData.transactionDate));
+    }
+
+    /* Check 2: Date is read, ids, state and sequence number are in the buffer */
+    if (Loc_Field > 0 && Loc_Read + Loc_Field + 13 <= size && buffer[Loc_Read + Loc_Field + 8] <= DECLINED_VELOCITY_LIMIT)
+    {
+        Loc_Read += Loc_Field;
+        transData->terminalData.terminalId   = (uint32_t)protocolGetNumber(&buffer[Loc_Read], 4);
+        transData->terminalData.requestId    = (uint32_t)protocolGetNumber(&buffer[Loc_Read + 4], 4);
+        Loc_Read += 8;
+        transData->transState                = buffer[Loc_Read];
+        transData->transactionSequenceNumber = (uint32_t)protocolGetNumber(&buffer[Loc_Read + 1], 4);
+        Loc_Read += 5;
+    }
+    else
+    {
+        Loc_Read = 0;
+    }
+
+    return Loc_Read;
+}
+
+/*
+ Name: protocolPutAccount
+ Input: Pointer to Buffer, Pointer to Account
+ Output: uint32_t Number of bytes written
+ Description: This function writes an account, its balance in 8 bytes, its state in one byte and its PAN string.
+*/
+uint32_t protocolPutAccount(uint8_t *buffer, ST_accountsDB_t *account)
+{
+    protocolPutNumber(buffer, (uint64_t)account->balance, 8);
+    buffer[8] = (uint8_t)account->state;
+
+    return 9 + protocolPutString(&buffer[9], account->primaryAccountNumber, sizeof(account->primaryAccountNumber));
+}
+
+/*
+ Name: protocolGetAccount
+ Input: Pointer to Buffer, uint32_t Bytes in the buffer, Pointer to Account
+ Output: uint32_t Number of bytes read
+ Description: 1. This function reads an account written by protocolPutAccount.
+              2. If the account is cut or malformed will return 0.
+*/
+uint32_t protocolGetAccount(uint8_t *buffer, uint32_t size, ST_accountsDB_t *account)
+{
+    /* Define local variable to set the bytes read, None */
+    uint32_t Loc_Read = 0;
+
+    /* Check: Balance and state are in the buffer */
+    if (size > 9 && buffer[8] <= BLOCKED)
+    {
+        account->balance = (sint64_t)protocolGetNumber(buffer, 8);
+        account->state   = buffer[8];
+
+        Loc_Read = protocolGetString(&buffer[9], size - 9, account->primaryAccountNumber, sizeof(account->primaryAccountNumber));
+        Loc_Read = (Loc_Read > 0) ? 9 + Loc_Read : 0;
+    }
+
+    return Loc_Read;
+}
@@ -0,0 +1,38 @@
+#ifndef PROTOCOL_H_
+#define PROTOCOL_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define PROTOCOL_SOCKET_FILE			"vbs.sock"	/* Unix domain socket of the server daemon */
+#define PROTOCOL_HEADER_SIZE			5			/* Frame length in 4 bytes, then the request code or server error */
+#define PROTOCOL_TRANSACTION_SIZE		91			/* Longest encoded transaction, unpacked PAN and all strings full */
+#define PROTOCOL_ACCOUNT_SIZE			29			/* Longest encoded account */
+#define PROTOCOL_BATCH_TRANSACTIONS		32			/* Transactions of one batch request */
+#define PROTOCOL_LIST_TRANSACTIONS		16384		/* Transactions of one history or dates answer */
+#define PROTOCOL_REQUEST_SIZE			(PROTOCOL_HEADER_SIZE + 2 + PROTOCOL_BATCH_TRANSACTIONS * PROTOCOL_TRANSACTION_SIZE)
+#define PROTOCOL_DATE_SIZE				11			/* Date string field, DD/MM/YYYY */
+#define PROTOCOL_PACKED_PAN				0x80		/* PAN length flag, the digits follow as one 64 bit number */
+#define PROTOCOL_LIMITS_SIZE			(VELOCITY_WINDOWS * 12)	/* Count in 4 bytes then cents in 8 bytes of every window */
+
+typedef enum EN_protocolRequest_t
+{
+	REQUEST_TRANSACTION, REQUEST_TRANSACTION_BATCH, REQUEST_VALID_ACCOUNT, REQUEST_SAVE_TRANSACTION, REQUEST_GET_TRANSACTION,
+	REQUEST_ACCOUNT_TRANSACTIONS, REQUEST_TRANSACTIONS_BY_DATE, REQUEST_GET_ACCOUNT, REQUEST_TOTAL_BALANCE,
+	REQUEST_BLOCKED_ACCOUNTS, REQUEST_ADD_ACCOUNTS, REQUEST_STAGE_HISTOGRAMS, REQUEST_DUMP_STAGES, REQUEST_SHARD_COUNT,
+	REQUEST_VELOCITY_LIMITS
+}EN_protocolRequest_t;
+
+/* Functions' Prototypes */
+void protocolPutNumber(uint8_t *buffer, uint64_t value, uint32_t size);
+uint64_t protocolGetNumber(uint8_t *buffer, uint32_t size);
+uint32_t protocolPutString(uint8_t *buffer, uint8_t *string, uint32_t capacity);
+uint32_t protocolGetString(uint8_t *buffer, uint32_t size, uint8_t *string, uint32_t capacity);
+uint32_t protocolPutCard(uint8_t *buffer, ST_cardData_t *cardData);
+uint32_t protocolGetCard(uint8_t *buffer, uint32_t size, ST_cardData_t *cardData);
+uint32_t protocolPutTransaction(uint8_t *buffer, ST_transaction_t *transData);
+uint32_t protocolGetTransaction(uint8_t *buffer, uint32_t size, ST_transaction_t *transData);
+uint32_t protocolPutAccount(uint8_t *buffer, ST_accountsDB_t *account);
+uint32_t protocolGetAccount(uint8_t *buffer, uint32_t size, ST_accountsDB_t *account);
+
+#endif /* PROTOCOL_H_ */
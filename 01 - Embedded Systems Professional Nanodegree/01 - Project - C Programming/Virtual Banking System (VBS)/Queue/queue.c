@@ -0,0 +1,252 @@
+/* Standard Library */
+#include <limits.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Queue Module */
+#include "queue.h"
+
+/*
+ Name: queueFutex
+ Input: Pointer to futex word, int Operation, uint32_t Value
+ Output: void
+ Description: Static Function to sleep on a futex word while it holds the value, or to wake that many sleepers.
+*/
+static void queueFutex(uint32_t *word, int operation, uint32_t value)
+{
+    syscall(SYS_futex, word, operation, value, NULL, NULL, 0);
+}
+
+/*
+ Name: queueInit
+ Input: Pointer to Queue structure
+ Output: EN_queueError_t Error or No Error
+ Description: 1. This function allocates the QUEUE_SLOTS cells of a bounded multi-producer single-consumer queue,
+                 every cell starts free for its own position.
+              2. If there is no memory will return QUEUE_FAILED, else will return QUEUE_OK.
+*/
+EN_queueError_t queueInit(ST_queue_t *queue)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_queueError_t Loc_ErrorState = QUEUE_OK;
+
+    queue->tail         = 0;
+    queue->head         = 0;
+    queue->sleepingFlag = 0;
+    queue->cells        = aligned_alloc(QUEUE_CACHE_LINE_SIZE, QUEUE_SLOTS * sizeof(ST_queueCell_t));
+
+    /* Check: No memory for the cells */
+    if (queue->cells == NULL)
+    {
+        /* Update error state, Queue Failed! */
+        Loc_ErrorState = QUEUE_FAILED;
+    }
+    else
+    {
+        /* Loop: Until all cells are free */
+        for (uint64_t Loc_Position = 0; Loc_Position < QUEUE_SLOTS; Loc_Position++)
+        {
+            queue->cells[Loc_Position].sequence = Loc_Position;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: queueFree
+ Input: Pointer to Queue structure
+ Output: void
+ Description: This function releases the cells of a queue.
+*/
+void queueFree(ST_queue_t *queue)
+{
+    free(queue->cells);
+    queue->cells = NULL;
+}
+
+/*
+ Name: queuePush
+ Input: Pointer to Queue structure, Pointer to Queue Entry
+ Output: EN_queueError_t Error or No Error
+ Description: 1. This function adds an entry at the tail of a queue without locks, any number of threads push at
+                 the same time. A producer claims the tail position with one compare and swap, fills the cell, then
+                 marks it full for the consumer, producers only wait for each other if their CAS collides.
+              2. The consumer is woken if it sleeps.
+              3. If the queue is full will return QUEUE_FULL and the entry is not added, else will return QUEUE_OK.
+*/
+EN_queueError_t queuePush(ST_queue_t *queue, ST_queueEntry_t *entry)
+{
+    /* Define local variable to set the error state, Queue Full */
+    EN_queueError_t Loc_ErrorState = QUEUE_FULL;
+    /* Define local variable to set the flag state, Flag Up */
+    EN_flagState_t Loc_TryFlag = FLAG_UP;
+    uint64_t Loc_Position = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+    ST_queueCell_t *Loc_Cell;
+    sint64_t Loc_Difference;
+
+    /* Loop: Until a position is claimed, or the queue is full */
+    while (Loc_TryFlag == FLAG_UP)
+    {
+        Loc_Cell       = &queue->cells[Loc_Position & (QUEUE_SLOTS - 1)];
+        Loc_Difference = (sint64_t)(__atomic_load_n(&Loc_Cell->sequence, __ATOMIC_ACQUIRE) - Loc_Position);
+
+        /* Check 1: Cell is free for the position, claim it, a failed claim reloads the tail */
+        if (Loc_Difference == 0)
+        {
+            /* Check 1.1: Position is claimed */
+            if (__atomic_compare_exchange_n(&queue->tail, &Loc_Position, Loc_Position + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                Loc_Cell->entry = *entry;
+                __atomic_store_n(&Loc_Cell->sequence, Loc_Position + 1, __ATOMIC_RELEASE);
+
+                /* Update error state, Queue OK! */
+                Loc_ErrorState = QUEUE_OK;
+                Loc_TryFlag    = FLAG_DOWN;
+            }
+        }
+        /* Check 2: Cell still holds the entry of the previous round, the queue is full */
+        else if (Loc_Difference < 0)
+        {
+            Loc_TryFlag = FLAG_DOWN;
+        }
+        /* Check 3: Another producer took the position */
+        else
+        {
+            Loc_Position = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    /* Order the push before reading the sleeping flag, queueSleep orders them the other way */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    /* Check: Entry is added and the consumer sleeps */
+    if (Loc_ErrorState == QUEUE_OK && __atomic_load_n(&queue->sleepingFlag, __ATOMIC_RELAXED) == 1)
+    {
+        queueWake(queue);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: queuePop
+ Input: Pointer to Queue structure, Pointer to Queue Entries, uint32_t Maximum number of entries
+ Output: uint32_t Number of entries
+ Description: This function takes up to maxCount entries from the head of a queue in order, without waiting, and
+              frees their cells for the producers. Only one thread may pop.
+*/
+uint32_t queuePop(ST_queue_t *queue, ST_queueEntry_t *entries, uint32_t maxCount)
+{
+    uint32_t Loc_Count = 0;
+    ST_queueCell_t *Loc_Cell = &queue->cells[queue->head & (QUEUE_SLOTS - 1)];
+
+    /* Loop: Until enough entries, or the next cell is not full yet */
+    while (Loc_Count < maxCount && __atomic_load_n(&Loc_Cell->sequence, __ATOMIC_ACQUIRE) == queue->head + 1)
+    {
+        entries[Loc_Count++] = Loc_Cell->entry;
+        __atomic_store_n(&Loc_Cell->sequence, queue->head + QUEUE_SLOTS, __ATOMIC_RELEASE);
+
+        queue->head++;
+        Loc_Cell = &queue->cells[queue->head & (QUEUE_SLOTS - 1)];
+    }
+
+    return Loc_Count;
+}
+
+/*
+ Name: queueSleep
+ Input: Pointer to Queue structure, Pointer to Run flag
+ Output: void
+ Description: This function lets the consumer sleep until an entry is pushed, or queueWake is called after the run
+              flag is put down. It returns at once if an entry is waiting or the run flag is down.
+*/
+void queueSleep(ST_queue_t *queue, EN_flagState_t *runFlag)
+{
+    __atomic_store_n(&queue->sleepingFlag, 1, __ATOMIC_SEQ_CST);
+
+    /* Check: Still no entry and still running once the flag is up, a push or a stop from now on wakes the consumer */
+    if (__atomic_load_n(&queue->cells[queue->head & (QUEUE_SLOTS - 1)].sequence, __ATOMIC_SEQ_CST) != queue->head + 1 &&
+        __atomic_load_n(runFlag, __ATOMIC_SEQ_CST) == FLAG_UP)
+    {
+        queueFutex(&queue->sleepingFlag, FUTEX_WAIT_PRIVATE, 1);
+    }
+
+    __atomic_store_n(&queue->sleepingFlag, 0, __ATOMIC_RELAXED);
+}
+
+/*
+ Name: queueWake
+ Input: Pointer to Queue structure
+ Output: void
+ Description: This function wakes the consumer of a queue, it is called by queuePush and by the thread stopping
+              the consumer after putting its run flag down.
+*/
+void queueWake(ST_queue_t *queue)
+{
+    __atomic_store_n(&queue->sleepingFlag, 0, __ATOMIC_SEQ_CST);
+    queueFutex(&queue->sleepingFlag, FUTEX_WAKE_PRIVATE, 1);
+}
+
+/*
+ Name: queueStartCompletion
+ Input: Pointer to Queue Completion, uint32_t Number of entries
+ Output: void
+ Description: This function sets a completion slot to wait for a number of entries, before they are pushed.
+*/
+void queueStartCompletion(ST_queueCompletion_t *completion, uint32_t count)
+{
+    __atomic_store_n(&completion->pending, count, __ATOMIC_RELAXED);
+}
+
+/*
+ Name: queueComplete
+ Input: Pointer to Queue Completion, uint32_t Number of entries done
+ Output: void
+ Description: This function marks entries of a completion slot done, after their results are written, and wakes
+              the producer once all are done. The slot may be gone as soon as the count reaches 0, the wake only
+              uses its address.
+*/
+void queueComplete(ST_queueCompletion_t *completion, uint32_t count)
+{
+    /* Check: Last entries of the slot */
+    if (__atomic_sub_fetch(&completion->pending, count, __ATOMIC_ACQ_REL) == 0)
+    {
+        queueFutex(&completion->pending, FUTEX_WAKE_PRIVATE, INT_MAX);
+    }
+}
+
+/*
+ Name: queueWaitCompletion
+ Input: Pointer to Queue Completion
+ Output: void
+ Description: This function waits until all entries of a completion slot are done, checking QUEUE_SPINS times
+              before sleeping on the slot.
+*/
+void queueWaitCompletion(ST_queueCompletion_t *completion)
+{
+    uint32_t Loc_Pending = __atomic_load_n(&completion->pending, __ATOMIC_ACQUIRE);
+
+    /* Loop: Until spun enough, or all entries are done */
+    for (uint32_t Loc_Spin = 0; Loc_Spin < QUEUE_SPINS && Loc_Pending != 0; Loc_Spin++)
+    {
+        __builtin_ia32_pause();
+        Loc_Pending = __atomic_load_n(&completion->pending, __ATOMIC_ACQUIRE);
+    }
+
+    /* Loop: Until all entries are done, sleeping while the count is unchanged */
+    while (Loc_Pending != 0)
+    {
+        queueFutex(&completion->pending, FUTEX_WAIT_PRIVATE, Loc_Pending);
+        Loc_Pending = __atomic_load_n(&completion->pending, __ATOMIC_ACQUIRE);
+    }
+}
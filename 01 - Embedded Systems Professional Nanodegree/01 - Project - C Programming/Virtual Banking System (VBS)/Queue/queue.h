@@ -0,0 +1,53 @@
+#ifndef QUEUE_H_
+#define QUEUE_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define QUEUE_SLOTS					4096		/* Entries of a queue, a power of two */
+#define QUEUE_CACHE_LINE_SIZE		64
+#define QUEUE_SPINS					256			/* Times a waiter checks again before it sleeps */
+
+typedef enum EN_queueError_t
+{
+	QUEUE_OK, QUEUE_FULL, QUEUE_FAILED
+}EN_queueError_t;
+
+typedef struct ST_queueCompletion_t
+{
+	uint32_t pending;						/* Entries not done yet, a futex word the waiter sleeps on */
+}ST_queueCompletion_t;
+
+typedef struct ST_queueEntry_t
+{
+	ST_transaction_t *transData;			/* Transaction of the producer, the consumer writes the result back */
+	EN_transState_t *transState;
+	ST_queueCompletion_t *completion;		/* Completion slot of the producer, shared by the entries of a batch */
+}ST_queueEntry_t;
+
+typedef struct ST_queueCell_t
+{
+	uint64_t sequence;						/* Position the cell is free for, or full for plus one */
+	ST_queueEntry_t entry;
+}ST_queueCell_t;
+
+typedef struct ST_queue_t
+{
+	uint64_t tail __attribute__((aligned(QUEUE_CACHE_LINE_SIZE)));	/* Next position to push, taken by producers */
+	uint64_t head __attribute__((aligned(QUEUE_CACHE_LINE_SIZE)));	/* Next position to pop, only the consumer */
+	uint32_t sleepingFlag;					/* Futex word, the consumer sleeps until a producer puts it down */
+	ST_queueCell_t *cells;
+}ST_queue_t;
+
+/* Functions' Prototypes */
+EN_queueError_t queueInit(ST_queue_t *queue);
+void queueFree(ST_queue_t *queue);
+EN_queueError_t queuePush(ST_queue_t *queue, ST_queueEntry_t *entry);
+uint32_t queuePop(ST_queue_t *queue, ST_queueEntry_t *entries, uint32_t maxCount);
+void queueSleep(ST_queue_t *queue, EN_flagState_t *runFlag);
+void queueWake(ST_queue_t *queue);
+void queueStartCompletion(ST_queueCompletion_t *completion, uint32_t count);
+void queueComplete(ST_queueCompletion_t *completion, uint32_t count);
+void queueWaitCompletion(ST_queueCompletion_t *completion);
+
+#endif /* QUEUE_H_ */
@@ -0,0 +1,204 @@
+/* Standard Library */
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Retry Module */
+#include "retry.h"
+
+/*
+ Name: retryBucket
+ Input: uint32_t Terminal id, uint32_t Request id
+ Output: uint32_t Bucket
+ Description: Static Function to hash a terminal id and a request id to a bucket of a cache.
+*/
+static uint32_t retryBucket(uint32_t terminalId, uint32_t requestId)
+{
+    uint64_t Loc_Hash = ((uint64_t)terminalId << 32 | requestId) * 0x9E3779B97F4A7C15ULL;
+
+    return (uint32_t)(Loc_Hash >> 32) & (RETRY_BUCKETS - 1);
+}
+
+/*
+ Name: retryInit
+ Input: Pointer to Retry Cache
+ Output: EN_retryError_t Error or No Error
+ Description: 1. This function allocates the RETRY_BUCKETS buckets of a retry cache, all entries free. The cache
+                 has a fixed size, done entries expire after RETRY_EXPIRY_MS and are replaced oldest first.
+              2. If there is no memory will return RETRY_FAILED, else will return RETRY_OK.
+*/
+EN_retryError_t retryInit(ST_retryCache_t *cache)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_retryError_t Loc_ErrorState = RETRY_OK;
+
+    cache->entries = calloc(RETRY_BUCKETS * RETRY_WAYS, sizeof(ST_retryEntry_t));
+
+    /* Check: No memory for the entries */
+    if (cache->entries == NULL)
+    {
+        /* Update error state, Retry Failed! */
+        Loc_ErrorState = RETRY_FAILED;
+    }
+
+    /* Loop: Until all bucket locks are initialized */
+    for (uint32_t Loc_Lock = 0; Loc_Lock < RETRY_LOCKS; Loc_Lock++)
+    {
+        pthread_mutex_init(&cache->locks[Loc_Lock], NULL);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: retryFree
+ Input: Pointer to Retry Cache
+ Output: void
+ Description: This function releases the entries of a retry cache.
+*/
+void retryFree(ST_retryCache_t *cache)
+{
+    free(cache->entries);
+    cache->entries = NULL;
+}
+
+/*
+ Name: retryNow
+ Input: void
+ Output: uint64_t Milliseconds
+ Description: This function returns the monotonic time in milliseconds, the clock of the cache expiry.
+*/
+uint64_t retryNow(void)
+{
+    struct timespec Loc_Time;
+
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Time);
+
+    return (uint64_t)Loc_Time.tv_sec * 1000 + (uint64_t)Loc_Time.tv_nsec / 1000000;
+}
+
+/*
+ Name: retryBegin
+ Input: Pointer to Retry Cache, Pointer to Transaction structure, uint64_t Milliseconds now
+ Output: EN_retryError_t Error or No Error
+ Description: 1. This function looks up the terminal id and request id of a transaction before it is authorized.
+              2. If the request is done and not expired, will copy its state and sequence number into the
+                 transaction and return RETRY_DONE, the transaction must not be authorized again.
+              3. If the request is in progress, will return RETRY_PENDING, the caller asks again later.
+              4. If the request is not known, will hold an entry for it owned by the transaction and return
+                 RETRY_NEW, retryEnd must be called once the transaction is authorized.
+              5. If the request has no id, or every entry of its bucket is in progress, will return RETRY_BYPASS
+                 and the transaction is authorized without the cache.
+*/
+EN_retryError_t retryBegin(ST_retryCache_t *cache, ST_transaction_t *transData, uint64_t now)
+{
+    /* Define local variable to set the error state, Retry Bypass */
+    EN_retryError_t Loc_ErrorState = RETRY_BYPASS;
+    uint32_t Loc_TerminalId = transData->terminalData.terminalId;
+    uint32_t Loc_RequestId  = transData->terminalData.requestId;
+    uint32_t Loc_Bucket     = retryBucket(Loc_TerminalId, Loc_RequestId);
+    ST_retryEntry_t *Loc_Entries = &cache->entries[Loc_Bucket * RETRY_WAYS];
+    ST_retryEntry_t *Loc_Victim  = NULL;
+
+    /* Check: Request has an id */
+    if (Loc_RequestId != TERMINAL_NO_REQUEST)
+    {
+        pthread_mutex_lock(&cache->locks[Loc_Bucket & (RETRY_LOCKS - 1)]);
+
+        /* Loop: Until all entries of the bucket are checked, or the request is found */
+        for (uint32_t Loc_Way = 0; Loc_Way < RETRY_WAYS && Loc_ErrorState == RETRY_BYPASS; Loc_Way++)
+        {
+            /* Check 1: Entry of the request, in progress or not expired */
+            if (Loc_Entries[Loc_Way].terminalId == Loc_TerminalId && Loc_Entries[Loc_Way].requestId == Loc_RequestId &&
+                (Loc_Entries[Loc_Way].owner != NULL || Loc_Entries[Loc_Way].expiry > now))
+            {
+                /* Check 1.1: First submission is in progress */
+                if (Loc_Entries[Loc_Way].owner != NULL)
+                {
+                    /* Update error state, Retry Pending! */
+                    Loc_ErrorState = RETRY_PENDING;
+                }
+                /* Check 1.2: First submission is done, answer with its result */
+                else
+                {
+                    transData->transState                = Loc_Entries[Loc_Way].transState;
+                    transData->transactionSequenceNumber = Loc_Entries[Loc_Way].transactionSequenceNumber;
+
+                    /* Update error state, Retry Done! */
+                    Loc_ErrorState = RETRY_DONE;
+                }
+            }
+            /* Check 2: Done entry, keep the one expiring first to replace */
+            else if (Loc_Entries[Loc_Way].owner == NULL && (Loc_Victim == NULL || Loc_Entries[Loc_Way].expiry < Loc_Victim->expiry))
+            {
+                Loc_Victim = &Loc_Entries[Loc_Way];
+            }
+        }
+
+        /* Check: Request is not known and an entry can be replaced, hold it for the transaction */
+        if (Loc_ErrorState == RETRY_BYPASS && Loc_Victim != NULL)
+        {
+            Loc_Victim->terminalId = Loc_TerminalId;
+            Loc_Victim->requestId  = Loc_RequestId;
+            Loc_Victim->expiry     = now + RETRY_EXPIRY_MS;
+            Loc_Victim->owner      = transData;
+
+            /* Update error state, Retry New! */
+            Loc_ErrorState = RETRY_NEW;
+        }
+
+        pthread_mutex_unlock(&cache->locks[Loc_Bucket & (RETRY_LOCKS - 1)]);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: retryEnd
+ Input: Pointer to Retry Cache, Pointer to Transaction structure
+ Output: void
+ Description: 1. This function records the state and sequence number of an authorized transaction in the entry it
+                 holds, retries of the request are answered with them until the entry expires.
+              2. A transaction that could not be saved releases its entry instead, a retry authorizes it again.
+              3. It does nothing for a transaction not holding an entry, so it may be called for every transaction.
+*/
+void retryEnd(ST_retryCache_t *cache, ST_transaction_t *transData)
+{
+    uint32_t Loc_TerminalId = transData->terminalData.terminalId;
+    uint32_t Loc_RequestId  = transData->terminalData.requestId;
+    uint32_t Loc_Bucket     = retryBucket(Loc_TerminalId, Loc_RequestId);
+    ST_retryEntry_t *Loc_Entries = &cache->entries[Loc_Bucket * RETRY_WAYS];
+
+    /* Check: Request has an id */
+    if (Loc_RequestId != TERMINAL_NO_REQUEST)
+    {
+        pthread_mutex_lock(&cache->locks[Loc_Bucket & (RETRY_LOCKS - 1)]);
+
+        /* Loop: Until all entries of the bucket are checked */
+        for (uint32_t Loc_Way = 0; Loc_Way < RETRY_WAYS; Loc_Way++)
+        {
+            /* Check: Entry of the request held by the transaction */
+            if (Loc_Entries[Loc_Way].owner == transData && Loc_Entries[Loc_Way].terminalId == Loc_TerminalId &&
+                Loc_Entries[Loc_Way].requestId == Loc_RequestId)
+            {
+                Loc_Entries[Loc_Way].transState                = transData->transState;
+                Loc_Entries[Loc_Way].transactionSequenceNumber = transData->transactionSequenceNumber;
+                Loc_Entries[Loc_Way].owner                     = NULL;
+
+                /* Check: Transaction is not saved, free the entry */
+                if (transData->transState == INTERNAL_SERVER_ERROR)
+                {
+                    Loc_Entries[Loc_Way].expiry = 0;
+                }
+            }
+        }
+
+        pthread_mutex_unlock(&cache->locks[Loc_Bucket & (RETRY_LOCKS - 1)]);
+    }
+}
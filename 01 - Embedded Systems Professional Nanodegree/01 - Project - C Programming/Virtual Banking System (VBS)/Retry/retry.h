@@ -0,0 +1,40 @@
+#ifndef RETRY_H_
+#define RETRY_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define RETRY_BUCKETS				4096		/* Buckets of a cache, a power of two */
+#define RETRY_WAYS					4			/* Entries of a bucket, the oldest done entry is replaced */
+#define RETRY_LOCKS					64			/* Bucket lock stripes, a power of two */
+#define RETRY_EXPIRY_MS				120000		/* Milliseconds a done request is answered from the cache */
+
+typedef enum EN_retryError_t
+{
+	RETRY_OK, RETRY_NEW, RETRY_DONE, RETRY_PENDING, RETRY_BYPASS, RETRY_FAILED
+}EN_retryError_t;
+
+typedef struct ST_retryEntry_t
+{
+	uint32_t terminalId;					/* Key, the terminal and its request number */
+	uint32_t requestId;
+	uint64_t expiry;						/* Milliseconds the entry is valid until, 0 for a free entry */
+	ST_transaction_t *owner;				/* Transaction of the first submission while it is in progress, else NULL */
+	EN_transState_t transState;				/* Result of the first submission once done */
+	uint32_t transactionSequenceNumber;
+}ST_retryEntry_t;
+
+typedef struct ST_retryCache_t
+{
+	ST_retryEntry_t *entries;				/* RETRY_BUCKETS buckets of RETRY_WAYS entries */
+	pthread_mutex_t locks[RETRY_LOCKS];
+}ST_retryCache_t;
+
+/* Functions' Prototypes */
+EN_retryError_t retryInit(ST_retryCache_t *cache);
+void retryFree(ST_retryCache_t *cache);
+uint64_t retryNow(void);
+EN_retryError_t retryBegin(ST_retryCache_t *cache, ST_transaction_t *transData, uint64_t now);
+void retryEnd(ST_retryCache_t *cache, ST_transaction_t *transData);
+
+#endif /* RETRY_H_ */
@@ -1,281 +1,3294 @@
-/* Standard Library */
-#include <string.h>
-
-/* Card Module */
-#include "../Card/card.h"
-/* Terminal Module */
-#include "../Terminal/terminal.h"
-/* Server Module */
-#include "server.h"
-
-/* Accounts Database */
-ST_accountsDB_t  accountsDB[255] =               /* Visa */                               /* MasterCard */
-                                    /* Balance |  State |        PAN       */  /* Balance |  State |        PAN       */
-                                   {{  12000   , BLOCKED, "4728459258966333"}, {  68600.3 , RUNNING, "5183150660610263"},
-                                    {  5805.5  , RUNNING, "4946084897338284"}, {  5000.3  , RUNNING, "5400829062340903"},
-                                    {  90360.12, RUNNING, "4728451059691228"}, {  1800000 , RUNNING, "5191786640828580"},
-                                    {  16800.58, RUNNING, "4573762093153876"}, {  40800   , RUNNING, "5367052744350494"},
-                                    {  520.9   , RUNNING, "4127856791257426"}, {  18900.45, RUNNING, "5248692364161088"},
-                                    {  6900.33 , RUNNING, "4946099660091878"}, {  1047751 , RUNNING, "5419558003040483"},
-                                    {  200000  , RUNNING, "4834699064563433"}, {  3026239 , RUNNING, "5116136307216426"},
-                                    {  5000000 , RUNNING, "4946069587908256"}, {  9362076 , RUNNING, "5335847432506029"},
-                                    {  25600   , RUNNING, "4946085117749481"}, {  10662670, RUNNING, "5424438206113309"},
-                                    {  895000  , RUNNING, "4946099683908835"}, {  1824    , RUNNING, "5264166325336492"}};
-/* Accounts Database Index */
-uint8_t Glb_AccountsDBIndex = 0;
-
-/* Transactions Database */
-ST_transaction_t transactionsDB[255] = {0};
-/* Transactions Database Index */
-static uint8_t Glb_TransactionsDBIndex = 0;
-
-/* 
- Name: recieveTransactionData
- Input: Pointer to Transaction structure
- Output: EN_transState_t Transaction State
- Description: 1. This function will take all transaction data and validate its data.
-              2. It checks the account details and amount availability.
-              3. If the account does not exist return FRAUD_CARD, if the amount is not available will return DECLINED_INSUFFECIENT_FUND, 
-                 if the account is blocked will return DECLINED_STOLEN_CARD, if a transaction can't be saved will 
-                 return INTERNAL_SERVER_ERROR and will not save the transaction, else returns APPROVED.
-              4. It will update the database with the new balance.
-*/
-EN_transState_t recieveTransactionData(ST_transaction_t *transData)
-{
-    /* Define local variable to set the transaction state, Approved */
-    EN_transState_t Loc_TransState = APPROVED;
-    /* Declare local variable to get all current account data from accountsDB */
-    ST_accountsDB_t Loc_CurrentAccount;
-
-    /* Check 1: Account is not found */
-    if (isValidAccount(&transData->cardHolderData, &Loc_CurrentAccount) == ACCOUNT_NOT_FOUND)
-    {
-        /* Save the current Transaction state in the current transaction structure */
-        transData->transState = FRAUD_CARD;
-
-        /* Update transaction state, Fraud Card! */
-        Loc_TransState = FRAUD_CARD;
-    }
-    /* Check 2: Account is found */
-    else
-    {
-        /* Check 2.1: Account is blocked */
-        if (isBlockedAccount(&Loc_CurrentAccount) == BLOCKED_ACCOUNT)
-        {
-            /* Save the current Transaction state in the current transaction structure */
-            transData->transState = DECLINED_STOLEN_CARD;
-            
-            /* Update transaction state, Stolen Card! */
-            Loc_TransState = DECLINED_STOLEN_CARD;          
-        }
-        /* Check 2.2: Amount is not available */
-        else if (isAmountAvailable(&transData->terminalData, &Loc_CurrentAccount) == LOW_BALANCE)
-        {
-            /* Save the current Transaction state in the current transaction structure */
-            transData->transState = DECLINED_INSUFFECIENT_FUND;
-
-            /* Update transaction state, Stolen Card! */
-            Loc_TransState = DECLINED_INSUFFECIENT_FUND;            
-        }
-
-        /* Check 2.3: Saving failed */
-        if (saveTransaction(transData) == SAVING_FAILED)
-        {
-            /* Save the current Transaction state in the current transaction structure */
-            transData->transState = INTERNAL_SERVER_ERROR;
-
-            /* Update transaction state, Server Error! */
-            Loc_TransState = INTERNAL_SERVER_ERROR;
-        }
-        /* Check 2.4: Saving succeed */
-        else
-        {
-            /* Check 2.4.1: Account is not blocked and Amount is available */
-            if (Loc_TransState != DECLINED_STOLEN_CARD && Loc_TransState != DECLINED_INSUFFECIENT_FUND)
-            {
-                /* Update Account in accountsDB with new balance after transaction approval */
-                accountsDB[Glb_AccountsDBIndex].balance -= transData->terminalData.transAmount;
-                
-                /* Save the current Transaction state in the current transaction structure */
-                transData->transState = APPROVED;
-            }     
-        }
-    }
-
-    return Loc_TransState;
-}
-
-/*
- Name: isValidAccount
- Input: Pointer to Card Data structure, 
- Output: EN_sreverError_t Error or No Error
- Description: 1. This function will take card data and validate if the account related to this card exists or not.
-              2. It checks if the PAN exists or not in the server's database (searches for the card PAN in the DB).
-              3. If the PAN doesn't exist will return ACCOUNT_NOT_FOUND, else will return SERVER_OK and return a reference 
-                 to this account in the DB.
-*/
-EN_serverError_t isValidAccount(ST_cardData_t *cardData, ST_accountsDB_t *accountRefrence)
-{
-    /* Define local variable to set the error state, No Error */
-    EN_serverError_t Loc_ErrorState = SERVER_OK;
-    /* Define local variable to set the flag state, Flag Down */
-    EN_flagState_t Loc_Flag = FLAG_DOWN;
-    
-    /* Loop: Until Account is found or until the end of accountsDB */
-    for (uint8_t Loc_Index = 0; Loc_Index < 255; Loc_Index++)
-    {
-        /* Check 1: Account is found */
-        if (!strcmp(cardData->primaryAccountNumber, accountsDB[Loc_Index].primaryAccountNumber))
-        {
-            /* Copy Account details from accountsDB to passed pointer */
-            *accountRefrence = accountsDB[Loc_Index];
-            /* Update accountsDB Index */
-            Glb_AccountsDBIndex = Loc_Index;
-
-            /* Update flag state, Account is Found! */
-            Loc_Flag = FLAG_UP;            
-            break;
-        }
-    }
-
-    /* Check 2: Account is not found */
-    if (Loc_Flag == FLAG_DOWN)
-    {
-        /* Update error state, Account Not Found! */
-        Loc_ErrorState = ACCOUNT_NOT_FOUND;
-    }    
-
-    return Loc_ErrorState;
-}
-
-/*
- Name: isBlockedAccount
- Input: 
- Output: EN_sreverError_t Error or No Error
- Description: 1. This function will take a reference to an existing account in the database.
-              2. It checks if the account is blocked or not.
-              3. If the account is blocked, will return BLOCKED_ACCOUNT, else will return SERVER_OK.
-*/
-EN_serverError_t isBlockedAccount(ST_accountsDB_t *accountRefrence)
-{
-    /* Define local variable to set the error state, No Error */
-    EN_serverError_t Loc_ErrorState = SERVER_OK;
-
-    /* Check: Account is Blocked */
-    if (accountRefrence->state == BLOCKED)
-    {
-        /* Update error state, Blocked Account! */
-        Loc_ErrorState = BLOCKED_ACCOUNT;
-    }
-
-    return Loc_ErrorState;
-}
-
-/*
- Name: isAmountAvailable
- Input: Pointer to Terminal Data structure
- Output: EN_sreverError_t Error or No Error
- Description: 1. This function will take terminal data and validate these data.
-              2. It checks if the transaction's amount is available or not.
-              3. If the transaction amount is greater than the balance in the database will return LOW_BALANCE, 
-                 else will return SERVER_OK
-*/
-EN_serverError_t isAmountAvailable(ST_terminalData_t *termData, ST_accountsDB_t *accountRefrence)
-{
-    /* Define local variable to set the error state, No Error */
-    EN_serverError_t Loc_ErrorState = SERVER_OK;
-    
-    /* Check: Transaction Amount > Account Balance */
-    if (termData->transAmount > accountRefrence->balance)
-    {
-        /* Update error state, Low Balance! */
-        Loc_ErrorState =  LOW_BALANCE; 
-    }
-
-    return Loc_ErrorState;
-}
-
-/*
- Name: saveTransaction
- Input: Pointer to Transaction structure
- Output: EN_sreverError_t Error or No Error
- Description: 1. This function will store all transaction data in the transactions database.
-              2. It gives a sequence number to a transaction, this number is incremented once a transaction 
-                 is processed into the server, you must check the last sequence number in the server to give 
-                 the new transaction a new sequence number.
-              3. It saves any type of transactions, APPROVED or DECLINED, with the specific reason for declining/transaction state.
-              4. If the transaction can't be saved, for any reason (ex: dropped connection) will return SAVING_FAILED, 
-                 else will return SERVER_OK, you can simulate this by commenting on the lines where your 
-                 code writes the transaction data in the database.
-              5. It checks if the transaction is saved or not using the getTransaction function.
-*/
-EN_serverError_t saveTransaction(ST_transaction_t *transData)
-{
-    /* Define local variable to set the error state, No Error */
-    EN_serverError_t Loc_ErrorState = SERVER_OK;
-    /* Define static local uint32_t variable to store the sequence number of the current transaction */
-    static uint32_t transSeqNumber = 1000;
-
-    /* Save the current sequence number in the current transaction structure */
-    transData->transactionSequenceNumber = transSeqNumber;
-    /* Save Transaction Data in transactionsDB */
-    transactionsDB[Glb_TransactionsDBIndex] = *transData;
-
-    /* Check 1: Transaction is not found */
-    if (getTransaction(transSeqNumber, transData) == TRANSACTION_NOT_FOUND)
-    {
-        /* Update error state, Saving Failed! */
-        Loc_ErrorState = SAVING_FAILED;
-    }
-    /* Check 2: Transaction is found */
-    else
-    {
-        /* Increment transaction sequence number */
-        transSeqNumber++;
-        /* Increment transactionsDB Index */
-        Glb_TransactionsDBIndex++;
-    }
-
-    return Loc_ErrorState;
-}
-
-/*
- Name: getTransaction
- Input: uint32_t Transaction Number, Pointer to Transaction structure
- Output: EN_sreverError_t Error or No Error
- Description: 1. This function takes the sequence number of a transaction and returns the transaction data 
-                 if found in the transactions DB.
-              2. If the sequence number is not found, then the transaction is not found, 
-                 the function will return TRANSACTION_NOT_FOUND, else return transaction data as well as SERVER_OK
-*/
-EN_serverError_t getTransaction(uint32_t transactionSequenceNumber, ST_transaction_t *transData)
-{
-    /* Define local variable to set the error state, No Error */
-    EN_serverError_t Loc_ErrorState = SERVER_OK ;
-    /* Define local variable to set the flag state, Flag Down */
-    EN_flagState_t Loc_Flag = FLAG_DOWN;
-
-    /* Loop: Until Transaction is found or until the end of transactionsDB */
-    for(uint8_t Loc_Index = 0; Loc_Index < 255; Loc_Index++)
-    {
-        /* Check 1: Transaction is found */
-        if (transactionsDB[Loc_Index].transactionSequenceNumber == transactionSequenceNumber)
-        {
-            /* Copy transaction details from transactionsDB to passed pointer */
-            *transData = transactionsDB[Loc_Index];
-
-            /* Update flag state, Transaction Found! */
-            Loc_Flag = FLAG_UP;
-            break;
-        }
-    }
-
-    /* Check 2: Transaction not found */
-    if (Loc_Flag == FLAG_DOWN)
-    {
-        /* Update error state, Transaction Not Found! */
-        Loc_ErrorState = TRANSACTION_NOT_FOUND;
-    }
-
-    return Loc_ErrorState;
-}
\ No newline at end of file
+/* pthread_setaffinity_np */
+#define _GNU_SOURCE
+
+/* Standard Library */
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "server.h"
+/* Index Module */
+#include "../Index/index.h"
+/* Filter Module */
+#include "../Filter/filter.h"
+/* Store Module */
+#include "../Store/store.h"
+/* Database Module */
+#include "../Database/database.h"
+/* Log Module */
+#include "../Log/log.h"
+/* Archive Module */
+#include "../Archive/archive.h"
+/* Histogram Module */
+#include "../Histogram/histogram.h"
+/* Queue Module */
+#include "../Queue/queue.h"
+/* Retry Module */
+#include "../Retry/retry.h"
+/* Velocity Module */
+#include "../Velocity/velocity.h"
+
+/* Default Accounts, added to a new accounts database file, balances in cents */
+static ST_accountsDB_t Glb_DefaultAccountsDB[] =    /* Visa */                                  /* MasterCard */
+                                    /* Balance  |  State |        PAN       */  /*  Balance  |  State |        PAN       */
+                                   {{  1200000  , BLOCKED, "4728459258966333"}, {  6860030   , RUNNING, "5183150660610263"},
+                                    {  580550   , RUNNING, "4946084897338284"}, {  500030    , RUNNING, "5400829062340903"},
+                                    {  9036012  , RUNNING, "4728451059691228"}, {  180000000 , RUNNING, "5191786640828580"},
+                                    {  1680058  , RUNNING, "4573762093153876"}, {  4080000   , RUNNING, "5367052744350494"},
+                                    {  52090    , RUNNING, "4127856791257426"}, {  1890045   , RUNNING, "5248692364161088"},
+                                    {  690033   , RUNNING, "4946099660091878"}, {  104775100 , RUNNING, "5419558003040483"},
+                                    {  20000000 , RUNNING, "4834699064563433"}, {  302623900 , RUNNING, "5116136307216426"},
+                                    {  500000000, RUNNING, "4946069587908256"}, {  936207600 , RUNNING, "5335847432506029"},
+                                    {  2560000  , RUNNING, "4946085117749481"}, {  1066267000, RUNNING, "5424438206113309"},
+                                    {  89500000 , RUNNING, "4946099683908835"}, {  182400    , RUNNING, "5264166325336492"}};
+/* Server Shard, the accounts, transactions and sequence range of one part of the PAN space, on its own cache lines */
+typedef struct __attribute__((aligned(SERVER_CACHE_LINE_SIZE))) ST_serverShard_t
+{
+    /* Accounts Database File, balances, states and PANs columns mapped from the accounts database file */
+    ST_database_t accountsDatabase;
+    /* Account Locks, an account is guarded by the lock of its record stripe, one lock per cache line */
+    union
+    {
+        pthread_mutex_t lock;
+        uint8_t line[SERVER_CACHE_LINE_SIZE];
+    }accountLocks[SERVER_ACCOUNT_LOCKS];
+
+    /* Transactions Database */
+    ST_transactionStore_t transactionsStore;
+    /* Transactions Log */
+    ST_log_t transactionsLog;
+    /* Transactions Archive, blocks of the log before the checkpoint compressed by the checkpointer, then punched
+       out of the log */
+    ST_archive_t transactionsArchive;
+    /* Transactions Lock, keeps sequence numbers in the store and record positions in the log in step */
+    pthread_mutex_t transactionsLock;
+    /* First sequence number of the next shard, the shard can't save a transaction past it */
+    uint32_t sequenceLimit;
+    /* Retry Cache, results of the requests of the last RETRY_EXPIRY_MS, a retry of a PAN comes to its shard */
+    ST_retryCache_t retryCache;
+    /* Velocity Table, the approved transactions of every account in its last minute, hour and day, guarded by the
+       lock of the account */
+    ST_velocityTable_t velocityTable;
+    /* Pipeline, saved transactions are applied by a later stage, so the checkpoint is cut at the last applied one,
+       and the checks see the balances of transactions in flight, with their number, per account record */
+    EN_flagState_t pipelineFlag;
+    uint32_t appliedSequenceNumber;
+    sint64_t *pipelineBalances;
+    uint32_t *pipelineCounts;
+    /* Standby, the log of the same shard of the primary server, followed by the standby thread, its accounts file,
+       read for the accounts added after the base copy, the records it ships at once, and its failure, a record it
+       can't apply */
+    ST_log_t primaryLog;
+    uint8_t primaryAccountsFile[SERVER_STANDBY_PATH_SIZE];
+    ST_logRecord_t *standbyRecords;
+    pthread_t standbyThread;
+    EN_flagState_t standbyFailedFlag;
+    /* Checkpointer, writes the changed pages of the accounts file in the background */
+    pthread_t checkpointThread;
+    pthread_mutex_t checkpointLock;
+    pthread_cond_t checkpointCondition;
+    EN_flagState_t checkpointRunFlag;
+    EN_flagState_t checkpointRequestFlag;
+
+    /* Worker, the only thread authorizing transactions of the shard, and its lock-free submission queue */
+    pthread_t workerThread;
+    uint32_t index;
+    ST_queue_t queue;
+    EN_flagState_t workerRunFlag;
+    /* Worker batch, transactions of the popped entries authorized together, and the entries their results go to */
+    ST_queueEntry_t *batchEntries;
+    ST_transaction_t *batchTransactions;
+    EN_transState_t *batchStates;
+    ST_batchItem_t *batchItems;
+    ST_logRecord_t *batchRecords;
+}ST_serverShard_t;
+
+/* Pipeline Stages, each on its own thread, the input ring of the lookup stage holds the free batches */
+typedef enum EN_pipelineStage_t
+{
+    PIPELINE_LOOKUP, PIPELINE_CHECK, PIPELINE_PERSIST, PIPELINE_APPLY, PIPELINE_STAGES
+}EN_pipelineStage_t;
+
+/* Pipeline Batch, entries popped from the submission queue together and carried through the stages */
+typedef struct ST_pipelineBatch_t
+{
+    uint32_t count;
+    uint32_t found;
+    uint32_t deferred;
+    uint32_t saved;
+    uint32_t nextSequenceNumber;        /* Next sequence number after the saved transactions, 0 if none is saved */
+    ST_queueEntry_t *entries;
+    ST_transaction_t *transactions;
+    EN_transState_t *states;
+    ST_batchItem_t *items;
+    ST_logRecord_t *records;
+}ST_pipelineBatch_t;
+
+/* Pipeline Ring, batches handed to a stage in order, it can hold every batch and the stop marker */
+typedef struct ST_pipelineRing_t
+{
+    ST_pipelineBatch_t *batches[SERVER_PIPELINE_DEPTH + 1];
+    uint32_t head;
+    uint32_t count;
+    pthread_mutex_t lock;
+    pthread_cond_t condition;
+}ST_pipelineRing_t;
+
+/* Server Shards, one unless the server is sharded, each on its own cache lines */
+static ST_serverShard_t *Glb_Shards;
+static uint32_t Glb_ShardCount;
+/* Workers flag, transactions are authorized by the shard workers, or the pipeline */
+static EN_flagState_t Glb_WorkersFlag = FLAG_DOWN;
+/* Pipeline, its batches, the input ring and thread of every stage */
+static EN_flagState_t Glb_PipelineFlag = FLAG_DOWN;
+static ST_pipelineBatch_t Glb_PipelineBatches[SERVER_PIPELINE_DEPTH];
+static ST_pipelineRing_t Glb_PipelineRings[PIPELINE_STAGES];
+static pthread_t Glb_PipelineThreads[PIPELINE_STAGES];
+/* Pipeline failure, a batch was not fully saved, batches checked and applied so far */
+static EN_flagState_t Glb_PipelineFailedFlag = FLAG_DOWN;
+static uint64_t Glb_PipelineChecked = 0;
+static uint64_t Glb_PipelineApplied = 0;
+/* Standby, the server follows the logs of a primary server and refuses transactions until it takes over, and
+   the standby threads run */
+static EN_flagState_t Glb_StandbyFlag = FLAG_DOWN;
+static EN_flagState_t Glb_StandbyRunFlag = FLAG_DOWN;
+/* Velocity Limits, checked while the flag is up, the flag is up while one of them is set */
+static EN_flagState_t Glb_VelocityFlag = FLAG_DOWN;
+static ST_velocityLimits_t Glb_VelocityLimits;
+/* Stage Histograms, time of each stage of recieveTransactionData, recorded while the flag is up */
+static ST_histogram_t Glb_StageHistograms[SERVER_STAGES];
+static EN_flagState_t Glb_StageFlag = FLAG_DOWN;
+static uint8_t *Glb_StageNames[SERVER_STAGES] = {"isValidAccount", "isBlockedAccount", "isAmountAvailable",
+                                                 "saveTransaction", "getTransaction"};
+
+/*
+ Name: recoverServer
+ Input: Pointer to Server Shard, uint32_t First sequence number not reflected in the accounts file
+ Output: void
+ Description: Static Function to replay the log tail on top of the accounts file. Log records hold the balance
+              after each transaction, so replaying a record twice gives the same balance. Replayed transactions
+              are also appended to the transactions store and become the last transaction of their account.
+*/
+static void recoverServer(ST_serverShard_t *shard, uint32_t checkpointSequenceNumber)
+{
+    ST_logRecord_t Loc_Record;
+
+    /* Loop: Until the end of the log */
+    for (uint32_t Loc_Sequence = checkpointSequenceNumber; logRead(&shard->transactionsLog, Loc_Sequence, &Loc_Record) == LOG_OK; Loc_Sequence++)
+    {
+        /* Check: Transaction belongs to an account */
+        if (Loc_Record.record != LOG_NO_ACCOUNT)
+        {
+            shard->accountsDatabase.balances[Loc_Record.record]      = Loc_Record.balance;
+            shard->accountsDatabase.lastSequences[Loc_Record.record] = Loc_Sequence;
+            databaseMarkAccount(&shard->accountsDatabase, Loc_Record.record);
+        }
+
+        storeAppend(&shard->transactionsStore, &Loc_Record.transaction, Loc_Record.previousSequenceNumber);
+    }
+}
+
+/*
+ Name: accountLock
+ Input: Pointer to Server Shard, uint32_t Account record
+ Output: Pointer to the lock of the account
+ Description: Static Function to get the lock guarding an account record.
+*/
+static pthread_mutex_t *accountLock(ST_serverShard_t *shard, uint32_t record)
+{
+    return &shard->accountLocks[record & (SERVER_ACCOUNT_LOCKS - 1)].lock;
+}
+
+/*
+ Name: panShard
+ Input: Pointer to PAN string
+ Output: Pointer to Server Shard
+ Description: Static Function to give the shard owning a PAN, from a 64 bit FNV-1a hash of its characters. The hash
+              is the same on every run, so a PAN always finds the shard files of its account.
+*/
+static ST_serverShard_t *panShard(uint8_t *primaryAccountNumber)
+{
+    uint64_t Loc_Hash = 14695981039346656037ULL;
+
+    /* Loop: Until the end of the PAN */
+    for (uint32_t Loc_Index = 0; Loc_Index < 20 && primaryAccountNumber[Loc_Index] != '\0'; Loc_Index++)
+    {
+        Loc_Hash = (Loc_Hash ^ primaryAccountNumber[Loc_Index]) * 1099511628211ULL;
+    }
+
+    return &Glb_Shards[Loc_Hash % Glb_ShardCount];
+}
+
+/*
+ Name: sequenceShard
+ Input: uint32_t Transaction sequence number
+ Output: Pointer to Server Shard, or NULL
+ Description: Static Function to give the shard whose sequence range holds a sequence number, NULL if there is
+              none. An unsharded server has one range.
+*/
+static ST_serverShard_t *sequenceShard(uint32_t transactionSequenceNumber)
+{
+    ST_serverShard_t *Loc_Shard = &Glb_Shards[0];
+    uint32_t Loc_Index = (transactionSequenceNumber - SERVER_FIRST_SEQUENCE_NUMBER) / SERVER_SHARD_SEQUENCES;
+
+    /* Check: Server is sharded, a pipelined server is not */
+    if (Glb_WorkersFlag == FLAG_UP && Glb_PipelineFlag == FLAG_DOWN)
+    {
+        Loc_Shard = (transactionSequenceNumber < SERVER_FIRST_SEQUENCE_NUMBER || Loc_Index >= Glb_ShardCount) ?
+                    NULL : &Glb_Shards[Loc_Index];
+    }
+
+    return Loc_Shard;
+}
+
+/*
+ Name: findAccount
+ Input: Pointer to Server Shard, Pointer to PAN string, Pointer to uint32_t Record
+ Output: EN_serverError_t Error or No Error
+ Description: Static Function to convert a PAN to its packed key once, then look the key up in the PAN filter and
+              the PAN index. Most unknown PANs, e.g. card testing, are rejected by the filter from one cache line,
+              only known PANs and false positives reach the index. A PAN that is not all digits has no account.
+*/
+static EN_serverError_t findAccount(ST_serverShard_t *shard, uint8_t *primaryAccountNumber, uint32_t *record)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    ST_panKey_t Loc_Key;
+
+    /* Check: PAN can't be packed, or is not found */
+    if (packCardPAN(primaryAccountNumber, &Loc_Key) == WRONG_PAN ||
+        filterFind(&shard->accountsDatabase.filter, &Loc_Key) == FILTER_NOT_FOUND ||
+        indexFind(&shard->accountsDatabase.index, &Loc_Key, record) == INDEX_NOT_FOUND)
+    {
+        /* Update error state, Account Not Found! */
+        Loc_ErrorState = ACCOUNT_NOT_FOUND;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: checkpointServer
+ Input: Pointer to Server Shard, uint32_t Transactions needed since the last checkpoint
+ Output: void
+ Description: Static Function to write the changed pages of the accounts file back and record the next sequence
+              number as its checkpoint, the log before the checkpoint is not needed for recovery anymore.
+              A transaction holds its account lock from saving until its balance is applied and its page is marked,
+              so with all account locks held every transaction before the next sequence number is in the marked
+              pages. A pipeline applies saved batches later, in order, its cut is after the last applied batch.
+              The locks are only held for the cut, the pages are written while transactions go on.
+*/
+static void checkpointServer(ST_serverShard_t *shard, uint32_t interval)
+{
+    uint32_t Loc_NextSequence;
+    /* Define local variable to set the flag state, Flag Down */
+    EN_flagState_t Loc_CutFlag = FLAG_DOWN;
+
+    /* Loop: Until all account locks are held, always in the same order */
+    for (uint32_t Loc_Lock = 0; Loc_Lock < SERVER_ACCOUNT_LOCKS; Loc_Lock++)
+    {
+        pthread_mutex_lock(&shard->accountLocks[Loc_Lock].lock);
+    }
+
+    pthread_mutex_lock(&shard->transactionsLock);
+    Loc_NextSequence = (shard->pipelineFlag == FLAG_UP) ? __atomic_load_n(&shard->appliedSequenceNumber, __ATOMIC_ACQUIRE) :
+                       shard->transactionsStore.nextSequenceNumber;
+    pthread_mutex_unlock(&shard->transactionsLock);
+
+    /* Check: Enough transactions since the last checkpoint */
+    if (Loc_NextSequence - shard->accountsDatabase.header->checkpointSequenceNumber >= interval)
+    {
+        databaseBeginCheckpoint(&shard->accountsDatabase);
+        Loc_CutFlag = FLAG_UP;
+    }
+
+    /* Loop: Until all account locks are released */
+    for (uint32_t Loc_Lock = 0; Loc_Lock < SERVER_ACCOUNT_LOCKS; Loc_Lock++)
+    {
+        pthread_mutex_unlock(&shard->accountLocks[Loc_Lock].lock);
+    }
+
+    /* Check: Checkpoint was cut */
+    if (Loc_CutFlag == FLAG_UP)
+    {
+        databaseCheckpoint(&shard->accountsDatabase, Loc_NextSequence);
+    }
+}
+
+/*
+ Name: archiveShard
+ Input: Pointer to Server Shard
+ Output: void
+ Description: Static Function run by the checkpointer after a checkpoint, the compactor. It reads the next ranges of
+              ARCHIVE_BLOCK_TRANSACTIONS transactions before the checkpoint back from the log, at most
+              ARCHIVE_BLOCKS_PER_PASS of them, encodes each as a block of the archive, then punches the archived
+              records out of the log. A range before the checkpoint is sealed, it is never replayed and its
+              transactions never change. A range must end before the checkpoint, so the last record of the log
+              stays in the log.
+*/
+static void archiveShard(ST_serverShard_t *shard)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_archiveError_t Loc_ErrorState = ARCHIVE_OK;
+    ST_transaction_t *Loc_Transactions = malloc(ARCHIVE_BLOCK_TRANSACTIONS * sizeof(ST_transaction_t));
+    uint32_t *Loc_PreviousSequences = malloc(ARCHIVE_BLOCK_TRANSACTIONS * sizeof(uint32_t));
+    uint32_t Loc_Checkpoint = shard->accountsDatabase.header->checkpointSequenceNumber;
+    uint32_t Loc_First, Loc_Read, Loc_Archived = 0;
+    ST_logRecord_t Loc_Record;
+
+    /* Loop: Until no sealed range is left, the pass archived enough blocks, or a range can't be archived */
+    while (Loc_Transactions != NULL && Loc_PreviousSequences != NULL && Loc_ErrorState == ARCHIVE_OK && Loc_Archived < ARCHIVE_BLOCKS_PER_PASS &&
+           shard->transactionsArchive.nextSequenceNumber + ARCHIVE_BLOCK_TRANSACTIONS < Loc_Checkpoint)
+    {
+        Loc_First = shard->transactionsArchive.nextSequenceNumber;
+        Loc_Read  = 0;
+
+        /* Loop: Until the range is read back from the log */
+        while (Loc_Read < ARCHIVE_BLOCK_TRANSACTIONS && logRead(&shard->transactionsLog, Loc_First + Loc_Read, &Loc_Record) == LOG_OK)
+        {
+            Loc_Transactions[Loc_Read]      = Loc_Record.transaction;
+            Loc_PreviousSequences[Loc_Read] = Loc_Record.previousSequenceNumber;
+            Loc_Read++;
+        }
+
+        /* Check: Range not fully in the log, or block can't be written, try again on the next pass */
+        if (Loc_Read < ARCHIVE_BLOCK_TRANSACTIONS || archiveAppend(&shard->transactionsArchive, Loc_Transactions, Loc_PreviousSequences) != ARCHIVE_OK)
+        {
+            /* Update error state, Write Failed! */
+            Loc_ErrorState = ARCHIVE_WRITE_FAILED;
+        }
+        else
+        {
+            Loc_Archived++;
+        }
+    }
+
+    /* Check: Blocks were archived, the log before the end of the archive is not needed anymore */
+    if (Loc_Archived != 0)
+    {
+        logRelease(&shard->transactionsLog, shard->transactionsArchive.nextSequenceNumber);
+    }
+
+    free(Loc_Transactions);
+    free(Loc_PreviousSequences);
+}
+
+/*
+ Name: checkpointThread
+ Input: Pointer to Server Shard
+ Output: NULL
+ Description: Static Function run by the checkpointer thread. It checkpoints every SERVER_CHECKPOINT_PERIOD_MS if any
+              transaction was saved, or as soon as a transaction requests it, then archives the log before the
+              checkpoint, until closeServer stops it.
+*/
+static void *checkpointThread(void *argument)
+{
+    ST_serverShard_t *Loc_Shard = argument;
+    struct timespec Loc_Deadline;
+
+    pthread_mutex_lock(&Loc_Shard->checkpointLock);
+
+    /* Loop: Until the server is closed */
+    while (Loc_Shard->checkpointRunFlag == FLAG_UP)
+    {
+        /* Check: No checkpoint requested, wait for a request or the period */
+        if (Loc_Shard->checkpointRequestFlag == FLAG_DOWN)
+        {
+            clock_gettime(CLOCK_REALTIME, &Loc_Deadline);
+            Loc_Deadline.tv_nsec += (SERVER_CHECKPOINT_PERIOD_MS % 1000) * 1000000L;
+            Loc_Deadline.tv_sec  += SERVER_CHECKPOINT_PERIOD_MS / 1000 + Loc_Deadline.tv_nsec / 1000000000L;
+            Loc_Deadline.tv_nsec %= 1000000000L;
+
+            pthread_cond_timedwait(&Loc_Shard->checkpointCondition, &Loc_Shard->checkpointLock, &Loc_Deadline);
+        }
+
+        pthread_mutex_unlock(&Loc_Shard->checkpointLock);
+        checkpointServer(Loc_Shard, 1);
+        archiveShard(Loc_Shard);
+        pthread_mutex_lock(&Loc_Shard->checkpointLock);
+
+        /* Requests made while checkpointing are served by this checkpoint */
+        Loc_Shard->checkpointRequestFlag = FLAG_DOWN;
+    }
+
+    pthread_mutex_unlock(&Loc_Shard->checkpointLock);
+
+    return NULL;
+}
+
+/*
+ Name: requestCheckpoint
+ Input: Pointer to Server Shard, uint32_t Next sequence number
+ Output: void
+ Description: Static Function to wake the checkpointer once SERVER_CHECKPOINT_INTERVAL transactions were saved since
+              the last checkpoint. Transactions never write pages themselves, and only the first one past the
+              interval takes the checkpointer lock.
+*/
+static void requestCheckpoint(ST_serverShard_t *shard, uint32_t nextSequenceNumber)
+{
+    /* Check: Enough transactions since last checkpoint, and not requested yet */
+    if (nextSequenceNumber - shard->accountsDatabase.header->checkpointSequenceNumber >= SERVER_CHECKPOINT_INTERVAL &&
+        __atomic_load_n(&shard->checkpointRequestFlag, __ATOMIC_RELAXED) == FLAG_DOWN)
+    {
+        pthread_mutex_lock(&shard->checkpointLock);
+        shard->checkpointRequestFlag = FLAG_UP;
+        pthread_cond_signal(&shard->checkpointCondition);
+        pthread_mutex_unlock(&shard->checkpointLock);
+    }
+}
+
+/*
+ Name: stageStart
+ Input: void
+ Output: uint64_t Ticks
+ Description: Static Function to read the clock at the start of a stage, 0 while stage histograms are off.
+*/
+static inline uint64_t stageStart(void)
+{
+    return (__atomic_load_n(&Glb_StageFlag, __ATOMIC_RELAXED) == FLAG_UP) ? histogramNow() : 0;
+}
+
+/*
+ Name: stageEnd
+ Input: EN_serverStage_t Stage, uint64_t Ticks of stageStart
+ Output: void
+ Description: Static Function to record the time of a stage, if it was started while stage histograms are on.
+*/
+static inline void stageEnd(EN_serverStage_t stage, uint64_t start)
+{
+    /* Check: Stage is timed */
+    if (start != 0)
+    {
+        histogramRecord(&Glb_StageHistograms[stage], histogramNow() - start);
+    }
+}
+
+/*
+ Name: getShardTransaction
+ Input: Pointer to Server Shard, uint32_t Transaction Number, Pointer to Transaction structure
+ Output: EN_serverError_t Error or No Error
+ Description: Static Function to get a transaction of a shard from its transactions store, or from its archive
+              or its log for transactions no longer in the store.
+*/
+static EN_serverError_t getShardTransaction(ST_serverShard_t *shard, uint32_t transactionSequenceNumber, ST_transaction_t *transData)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK ;
+    ST_logRecord_t Loc_Record;
+    uint32_t Loc_PreviousSequence;
+
+    EN_storeError_t Loc_StoreError;
+
+    pthread_mutex_lock(&shard->transactionsLock);
+    Loc_StoreError = storeGet(&shard->transactionsStore, transactionSequenceNumber, transData);
+    pthread_mutex_unlock(&shard->transactionsLock);
+
+    /* Check 1: Transaction not in the transactions store, from before the last restart or retired, and not archived */
+    if (Loc_StoreError == STORE_NOT_FOUND &&
+        archiveGet(&shard->transactionsArchive, transactionSequenceNumber, transData, &Loc_PreviousSequence) == ARCHIVE_NOT_FOUND)
+    {
+        /* Check 1.1: Transaction not in the log either */
+        if (logRead(&shard->transactionsLog, transactionSequenceNumber, &Loc_Record) == LOG_NOT_FOUND)
+        {
+            /* Update error state, Transaction Not Found! */
+            Loc_ErrorState = TRANSACTION_NOT_FOUND;
+        }
+        else
+        {
+            /* Copy transaction details from the log to passed pointer */
+            *transData = Loc_Record.transaction;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: logTransaction
+ Input: Pointer to Server Shard, Pointer to Transaction structure, uint32_t Account record, sint64_t Account balance after the transaction
+ Output: EN_serverError_t Error or No Error
+ Description: Static Function to give the transaction its sequence number, add it to the transactions store and
+              the log, and wait until the log is synced. Only the appends are serialized, the sync is shared by all
+              threads committing at the same time. The caller holds the lock of the account record, if any.
+              The transaction is chained after the last transaction of the account, and becomes the last one once
+              it is durable. A transaction that can't be made durable is dropped from the transactions store with
+              every transaction appended after it, their syncs fail too, so none of them can be read or chained.
+*/
+static EN_serverError_t logTransaction(ST_serverShard_t *shard, ST_transaction_t *transData, uint32_t record, sint64_t balance)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    /* Define local variable to build the log record of the transaction */
+    ST_logRecord_t Loc_Record = {0};
+    uint64_t Loc_LogOffset = 0;
+    EN_logError_t Loc_CommitError;
+    /* Declare local variables to time reading the transaction back */
+    uint64_t Loc_Start;
+    EN_serverError_t Loc_GetError;
+
+    Loc_Record.record  = record;
+    Loc_Record.balance = balance;
+
+    pthread_mutex_lock(&shard->transactionsLock);
+
+    /* Chain after the last transaction of the account, the chain head moves under the transactions lock */
+    Loc_Record.previousSequenceNumber = (record != LOG_NO_ACCOUNT) ? shard->accountsDatabase.lastSequences[record] : 0;
+
+    /* Check 1: Sequence range of the shard is used up, or Transaction can't be appended to the transactions store */
+    if (shard->transactionsStore.nextSequenceNumber >= shard->sequenceLimit ||
+        storeAppend(&shard->transactionsStore, transData, Loc_Record.previousSequenceNumber) != STORE_OK)
+    {
+        /* Update error state, Saving Failed! */
+        Loc_ErrorState = SAVING_FAILED;
+    }
+    /* Check 2: Transaction can't be appended to the log, drop it from the transactions store */
+    else if ((Loc_Record.transaction = *transData, logAppend(&shard->transactionsLog, &Loc_Record, 1, &Loc_LogOffset)) != LOG_OK)
+    {
+        storeTruncate(&shard->transactionsStore, transData->transactionSequenceNumber);
+
+        /* Update error state, Saving Failed! */
+        Loc_ErrorState = SAVING_FAILED;
+    }
+
+    pthread_mutex_unlock(&shard->transactionsLock);
+
+    /* Check 3: Transaction is in the log */
+    if (Loc_ErrorState == SERVER_OK)
+    {
+        Loc_CommitError = logCommit(&shard->transactionsLog, Loc_LogOffset);
+
+        pthread_mutex_lock(&shard->transactionsLock);
+
+        /* Check 3.1: Log can't be synced, drop the transaction and the ones after it from the transactions store */
+        if (Loc_CommitError != LOG_OK)
+        {
+            storeTruncate(&shard->transactionsStore, transData->transactionSequenceNumber);
+
+            /* Update error state, Saving Failed! */
+            Loc_ErrorState = SAVING_FAILED;
+        }
+        /* Check 3.2: Transaction is durable, it is the last transaction of its account */
+        else if (record != LOG_NO_ACCOUNT)
+        {
+            shard->accountsDatabase.lastSequences[record] = transData->transactionSequenceNumber;
+        }
+
+        pthread_mutex_unlock(&shard->transactionsLock);
+    }
+
+    /* Check 4: Transaction is durable, read it back */
+    if (Loc_ErrorState == SERVER_OK)
+    {
+        Loc_Start    = stageStart();
+        Loc_GetError = getShardTransaction(shard, transData->transactionSequenceNumber, transData);
+        stageEnd(STAGE_GET_TRANSACTION, Loc_Start);
+
+        /* Check 4.1: Transaction is not found */
+        if (Loc_GetError == TRANSACTION_NOT_FOUND)
+        {
+            /* Update error state, Saving Failed! */
+            Loc_ErrorState = SAVING_FAILED;
+        }
+        /* Check 4.2: Transaction is saved and belongs to an account */
+        else if (record != LOG_NO_ACCOUNT)
+        {
+            databaseMarkAccount(&shard->accountsDatabase, record);
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: getChainedTransaction
+ Input: Pointer to Server Shard, uint32_t Transaction sequence number, Pointer to Transaction structure, Pointer to uint32_t Previous sequence number
+ Output: EN_serverError_t Error or No Error
+ Description: Static Function to get a transaction with the previous transaction of its account, from the
+              transactions store, or from the archive or the log for transactions no longer in the store.
+*/
+static EN_serverError_t getChainedTransaction(ST_serverShard_t *shard, uint32_t transactionSequenceNumber, ST_transaction_t *transData, uint32_t *previousSequenceNumber)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    ST_logRecord_t Loc_Record;
+    EN_storeError_t Loc_StoreError;
+
+    pthread_mutex_lock(&shard->transactionsLock);
+    Loc_StoreError = storeGet(&shard->transactionsStore, transactionSequenceNumber, transData);
+    storeGetPrevious(&shard->transactionsStore, transactionSequenceNumber, previousSequenceNumber);
+    pthread_mutex_unlock(&shard->transactionsLock);
+
+    /* Check 1: Transaction not in the transactions store, from before the last restart or retired, and not archived */
+    if (Loc_StoreError == STORE_NOT_FOUND &&
+        archiveGet(&shard->transactionsArchive, transactionSequenceNumber, transData, previousSequenceNumber) == ARCHIVE_NOT_FOUND)
+    {
+        /* Check 1.1: Transaction not in the log either */
+        if (logRead(&shard->transactionsLog, transactionSequenceNumber, &Loc_Record) == LOG_NOT_FOUND)
+        {
+            /* Update error state, Transaction Not Found! */
+            Loc_ErrorState = TRANSACTION_NOT_FOUND;
+        }
+        else
+        {
+            *transData              = Loc_Record.transaction;
+            *previousSequenceNumber = Loc_Record.previousSequenceNumber;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: openShard
+ Input: Pointer to Server Shard, Pointer to accounts file name, Pointer to log file name, Pointer to archive file name,
+        uint32_t First sequence number, uint32_t Sequence limit
+ Output: EN_serverError_t Error or No Error
+ Description: Static Function to open the accounts file, the log and the archive of a shard, replay the log tail
+              since the last checkpoint and start the checkpointer of the shard. A new accounts file gets the
+              default accounts owned by the shard.
+*/
+static EN_serverError_t openShard(ST_serverShard_t *shard, uint8_t *accountsFile, uint8_t *logFile, uint8_t *archiveFile,
+                                  uint32_t firstSequenceNumber, uint32_t sequenceLimit)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    uint32_t Loc_CheckpointSequence = 0;
+    ST_accountsDB_t Loc_Defaults[sizeof(Glb_DefaultAccountsDB) / sizeof(ST_accountsDB_t)];
+    uint32_t Loc_DefaultCount = 0;
+
+    /* Loop: Until all default accounts owned by the shard are picked */
+    for (uint32_t Loc_Index = 0; Loc_Index < sizeof(Glb_DefaultAccountsDB) / sizeof(ST_accountsDB_t); Loc_Index++)
+    {
+        /* Check: Default account is owned by the shard */
+        if (panShard(Glb_DefaultAccountsDB[Loc_Index].primaryAccountNumber) == shard)
+        {
+            Loc_Defaults[Loc_DefaultCount++] = Glb_DefaultAccountsDB[Loc_Index];
+        }
+    }
+
+    /* Loop: Until all account locks are initialized */
+    for (uint32_t Loc_Lock = 0; Loc_Lock < SERVER_ACCOUNT_LOCKS; Loc_Lock++)
+    {
+        pthread_mutex_init(&shard->accountLocks[Loc_Lock].lock, NULL);
+    }
+
+    pthread_mutex_init(&shard->transactionsLock, NULL);
+    pthread_mutex_init(&shard->checkpointLock, NULL);
+    pthread_cond_init(&shard->checkpointCondition, NULL);
+    shard->sequenceLimit = sequenceLimit;
+
+    /* Check 1: Retry cache, Accounts file, Velocity table, Log or Archive can't be opened */
+    if (retryInit(&shard->retryCache) != RETRY_OK ||
+        databaseOpen(&shard->accountsDatabase, accountsFile, Loc_Defaults, Loc_DefaultCount) != DATABASE_OK ||
+        velocityInit(&shard->velocityTable, shard->accountsDatabase.header->capacity) != VELOCITY_OK ||
+        logOpen(&shard->transactionsLog, logFile, firstSequenceNumber) != LOG_OK ||
+        archiveOpen(&shard->transactionsArchive, archiveFile, firstSequenceNumber) != ARCHIVE_OK)
+    {
+        /* Update error state, Init Failed! */
+        Loc_ErrorState = INIT_FAILED;
+    }
+    /* Check 2: Accounts file and Log are open */
+    else
+    {
+        /* Replay from the checkpoint, or from the start of the log if the log was started after it */
+        Loc_CheckpointSequence = shard->accountsDatabase.header->checkpointSequenceNumber;
+        Loc_CheckpointSequence = (Loc_CheckpointSequence < shard->transactionsLog.firstSequenceNumber) ? shard->transactionsLog.firstSequenceNumber : Loc_CheckpointSequence;
+
+        /* Check 2.1: Log ends before the checkpoint, log file was lost, archive is not of this log or goes past the
+                      checkpoint, or Store can't be opened */
+        if (Loc_CheckpointSequence > shard->transactionsLog.nextSequenceNumber ||
+            shard->transactionsArchive.firstSequenceNumber != shard->transactionsLog.firstSequenceNumber ||
+            shard->transactionsArchive.nextSequenceNumber > Loc_CheckpointSequence ||
+            storeInit(&shard->transactionsStore, Loc_CheckpointSequence, SERVER_RETAINED_SEGMENTS) != STORE_OK)
+        {
+            /* Update error state, Init Failed! */
+            Loc_ErrorState = INIT_FAILED;
+        }
+        /* Check 2.2: Store is open */
+        else
+        {
+            recoverServer(shard, Loc_CheckpointSequence);
+
+            shard->checkpointRunFlag     = FLAG_UP;
+            shard->checkpointRequestFlag = FLAG_DOWN;
+
+            /* Check 2.2.1: Checkpointer can't be started */
+            if (pthread_create(&shard->checkpointThread, NULL, checkpointThread, shard) != 0)
+            {
+                shard->checkpointRunFlag = FLAG_DOWN;
+
+                /* Update error state, Init Failed! */
+                Loc_ErrorState = INIT_FAILED;
+            }
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: closeShard
+ Input: Pointer to Server Shard
+ Output: void
+ Description: Static Function to stop the checkpointer of a shard, checkpoint its accounts file and release its
+              files, store, retry cache and velocity table.
+*/
+static void closeShard(ST_serverShard_t *shard)
+{
+    pthread_mutex_lock(&shard->checkpointLock);
+    shard->checkpointRunFlag = FLAG_DOWN;
+    pthread_cond_signal(&shard->checkpointCondition);
+    pthread_mutex_unlock(&shard->checkpointLock);
+    pthread_join(shard->checkpointThread, NULL);
+
+    checkpointServer(shard, 0);
+    logClose(&shard->transactionsLog);
+    archiveClose(&shard->transactionsArchive);
+    databaseClose(&shard->accountsDatabase);
+    storeFree(&shard->transactionsStore);
+    retryFree(&shard->retryCache);
+    velocityFree(&shard->velocityTable);
+}
+
+/*
+ Name: isBelowVelocityLimits
+ Input: Pointer to Server Shard, uint32_t Account record, Pointer to Terminal Data, uint32_t Seconds
+ Output: EN_serverError_t Error or No Error
+ Description: Static Function to check a transaction that would be approved against the velocity limits of its
+              account, the caller holds the lock of the account. If the limits are set and the transaction takes the
+              approved transactions or amount of the account in its last minute, hour or day over a limit, or the
+              windows of the account can't be allocated, will return EXCEED_VELOCITY_LIMIT, else will return SERVER_OK.
+*/
+static EN_serverError_t isBelowVelocityLimits(ST_serverShard_t *shard, uint32_t record, ST_terminalData_t *termData, uint32_t now)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    ST_velocityAccount_t *Loc_Account;
+
+    /* Check: Velocity limits are set */
+    if (Glb_VelocityFlag == FLAG_UP)
+    {
+        Loc_Account = velocityAccount(&shard->velocityTable, record);
+
+        /* Check: Windows can't be allocated, or a limit is exceeded */
+        if (Loc_Account == NULL || velocityCheck(Loc_Account, &Glb_VelocityLimits, now, termData->transAmount) == VELOCITY_EXCEEDED)
+        {
+            /* Update error state, Exceed Velocity Limit! */
+            Loc_ErrorState = EXCEED_VELOCITY_LIMIT;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: addVelocity
+ Input: Pointer to Server Shard, uint32_t Account record, Pointer to Terminal Data, uint32_t Seconds
+ Output: void
+ Description: Static Function to add an approved transaction to the windows of its account while the velocity
+              limits are set, the caller holds the lock of the account.
+*/
+static void addVelocity(ST_serverShard_t *shard, uint32_t record, ST_terminalData_t *termData, uint32_t now)
+{
+    ST_velocityAccount_t *Loc_Account;
+
+    /* Check: Velocity limits are set */
+    if (Glb_VelocityFlag == FLAG_UP)
+    {
+        Loc_Account = velocityAccount(&shard->velocityTable, record);
+
+        /* Check: Windows of the account are allocated */
+        if (Loc_Account != NULL)
+        {
+            velocityAdd(Loc_Account, now, termData->transAmount);
+        }
+    }
+}
+
+/*
+ Name: recieveShardTransaction
+ Input: Pointer to Server Shard, Pointer to Transaction structure
+ Output: EN_transState_t Transaction State
+ Description: Static Function to authorize one transaction of a shard on the calling thread, the account is locked
+              from the checks until the new balance is applied, and the approved transaction is in its windows.
+*/
+static EN_transState_t recieveShardTransaction(ST_serverShard_t *shard, ST_transaction_t *transData)
+{
+    /* Define local variable to set the transaction state, Approved */
+    EN_transState_t Loc_TransState = APPROVED;
+    /* Declare local variable to get the balance and state of the current account, the PAN is not copied */
+    ST_accountsDB_t Loc_CurrentAccount;
+    /* Declare local variable to get the record of the account in the accounts database */
+    uint32_t Loc_Record;
+    /* Declare local variables to time the stages, stageStart gives 0 while stage histograms are off */
+    uint64_t Loc_Start = stageStart();
+    EN_serverError_t Loc_ErrorState = findAccount(shard, transData->cardHolderData.primaryAccountNumber, &Loc_Record);
+    /* Define local variable to get the time of the velocity windows, only read while the limits are set */
+    uint32_t Loc_Now = (Glb_VelocityFlag == FLAG_UP) ? velocityNow() : 0;
+
+    stageEnd(STAGE_VALID_ACCOUNT, Loc_Start);
+
+    /* Check 1: Account is not found */
+    if (Loc_ErrorState == ACCOUNT_NOT_FOUND)
+    {
+        /* Save the current Transaction state in the current transaction structure */
+        transData->transState = FRAUD_CARD;
+
+        /* Update transaction state, Fraud Card! */
+        Loc_TransState = FRAUD_CARD;
+    }
+    /* Check 2: Account is found */
+    else
+    {
+        /* Hold the account from the checks until the new balance is applied */
+        pthread_mutex_lock(accountLock(shard, Loc_Record));
+
+        /* Copy Account hot columns, one balance and one state cache line */
+        Loc_CurrentAccount.balance = shard->accountsDatabase.balances[Loc_Record];
+        Loc_CurrentAccount.state   = shard->accountsDatabase.states[Loc_Record];
+
+        Loc_Start      = stageStart();
+        Loc_ErrorState = isBlockedAccount(&Loc_CurrentAccount);
+        stageEnd(STAGE_BLOCKED_ACCOUNT, Loc_Start);
+
+        /* Check the amount of a running account only */
+        if (Loc_ErrorState != BLOCKED_ACCOUNT)
+        {
+            Loc_Start      = stageStart();
+            Loc_ErrorState = isAmountAvailable(&transData->terminalData, &Loc_CurrentAccount);
+            stageEnd(STAGE_AMOUNT_AVAILABLE, Loc_Start);
+        }
+
+        /* Check the velocity limits of a transaction that would be approved only */
+        if (Loc_ErrorState == SERVER_OK)
+        {
+            Loc_ErrorState = isBelowVelocityLimits(shard, Loc_Record, &transData->terminalData, Loc_Now);
+        }
+
+        /* Check 2.1: Account is blocked */
+        if (Loc_ErrorState == BLOCKED_ACCOUNT)
+        {
+            /* Save the current Transaction state in the current transaction structure */
+            transData->transState = DECLINED_STOLEN_CARD;
+            
+            /* Update transaction state, Stolen Card! */
+            Loc_TransState = DECLINED_STOLEN_CARD;          
+        }
+        /* Check 2.2: Amount is not available */
+        else if (Loc_ErrorState == LOW_BALANCE)
+        {
+            /* Save the current Transaction state in the current transaction structure */
+            transData->transState = DECLINED_INSUFFECIENT_FUND;
+
+            /* Update transaction state, Stolen Card! */
+            Loc_TransState = DECLINED_INSUFFECIENT_FUND;            
+        }
+        /* Check 2.3: Velocity limit is exceeded */
+        else if (Loc_ErrorState == EXCEED_VELOCITY_LIMIT)
+        {
+            /* Save the current Transaction state in the current transaction structure */
+            transData->transState = DECLINED_VELOCITY_LIMIT;
+
+            /* Update transaction state, Velocity Limit! */
+            Loc_TransState = DECLINED_VELOCITY_LIMIT;
+        }
+        /* Check 2.4: Account is running, Amount is available and below the velocity limits */
+        else
+        {
+            /* Save the current Transaction state in the current transaction structure */
+            transData->transState = APPROVED;
+
+            /* Balance after the transaction */
+            Loc_CurrentAccount.balance -= transData->terminalData.transAmount;
+        }
+
+        Loc_Start      = stageStart();
+        Loc_ErrorState = logTransaction(shard, transData, Loc_Record, Loc_CurrentAccount.balance);
+        stageEnd(STAGE_SAVE_TRANSACTION, Loc_Start);
+
+        /* Check 2.5: Saving failed */
+        if (Loc_ErrorState == SAVING_FAILED)
+        {
+            /* Save the current Transaction state in the current transaction structure */
+            transData->transState = INTERNAL_SERVER_ERROR;
+
+            /* Update transaction state, Server Error! */
+            Loc_TransState = INTERNAL_SERVER_ERROR;
+        }
+        /* Check 2.6: Saving succeed, transaction is durable in the log */
+        else
+        {
+            /* Check 2.6.1: Transaction is approved, update Account balance with new balance, logTransaction marked it,
+                            and add it to the windows of the account */
+            if (Loc_TransState == APPROVED)
+            {
+                shard->accountsDatabase.balances[Loc_Record] = Loc_CurrentAccount.balance;
+                addVelocity(shard, Loc_Record, &transData->terminalData, Loc_Now);
+            }
+        }
+
+        pthread_mutex_unlock(accountLock(shard, Loc_Record));
+
+        /* Check 2.7: Transaction is saved, checkpoint in the background once enough transactions are saved */
+        if (Loc_TransState != INTERNAL_SERVER_ERROR)
+        {
+            requestCheckpoint(shard, transData->transactionSequenceNumber + 1);
+        }
+    }
+
+    return Loc_TransState;
+}
+
+/*
+ Name: recieveRetriedTransaction
+ Input: Pointer to Server Shard, Pointer to Transaction structure
+ Output: EN_transState_t Transaction State
+ Description: Static Function to authorize one transaction of a shard unless its request is in the retry cache. A
+              retry of a done request gets the state and sequence number of the first submission without running
+              the checks again, a retry of a request in progress waits for it.
+*/
+static EN_transState_t recieveRetriedTransaction(ST_serverShard_t *shard, ST_transaction_t *transData)
+{
+    /* Declare local variable to get the transaction state */
+    EN_transState_t Loc_TransState;
+    EN_retryError_t Loc_RetryState = retryBegin(&shard->retryCache, transData, retryNow());
+
+    /* Loop: Until the first submission of the request is done */
+    while (Loc_RetryState == RETRY_PENDING)
+    {
+        sched_yield();
+        Loc_RetryState = retryBegin(&shard->retryCache, transData, retryNow());
+    }
+
+    /* Check 1: Request is done, answer with its result */
+    if (Loc_RetryState == RETRY_DONE)
+    {
+        Loc_TransState = transData->transState;
+    }
+    /* Check 2: Authorize the transaction, and record its result for retries */
+    else
+    {
+        Loc_TransState = recieveShardTransaction(shard, transData);
+        retryEnd(&shard->retryCache, transData);
+    }
+
+    return Loc_TransState;
+}
+
+/*
+ Name: batchCompare
+ Input: Pointer to first Batch Item, Pointer to second Batch Item
+ Output: int Order of the items
+ Description: Static Function to order batch items by account lock stripe, then account record, then position in
+              the batch, so stripes are locked in ascending order and transactions of an account keep their order.
+*/
+static int batchCompare(const void *first, const void *second)
+{
+    const ST_batchItem_t *Loc_First  = first;
+    const ST_batchItem_t *Loc_Second = second;
+    uint32_t Loc_FirstStripe  = Loc_First->record & (SERVER_ACCOUNT_LOCKS - 1);
+    uint32_t Loc_SecondStripe = Loc_Second->record & (SERVER_ACCOUNT_LOCKS - 1);
+
+    /* Check 1: Different stripes */
+    if (Loc_FirstStripe != Loc_SecondStripe)
+    {
+        return (Loc_FirstStripe < Loc_SecondStripe) ? -1 : 1;
+    }
+    /* Check 2: Different accounts of the same stripe */
+    else if (Loc_First->record != Loc_Second->record)
+    {
+        return (Loc_First->record < Loc_Second->record) ? -1 : 1;
+    }
+
+    return (Loc_First->position < Loc_Second->position) ? -1 : (Loc_First->position > Loc_Second->position);
+}
+
+/*
+ Name: lookupChunk
+ Input: Pointer to Server Shard, Pointer to Transactions, uint32_t Number of transactions, Pointer to Transaction States,
+        Pointer to Batch Items, Pointer to uint32_t Deferred retries
+ Output: uint32_t Number of transactions with an account
+ Description: Static Function to look up the requests of a chunk in the retry cache and the accounts of the others,
+              retries of done requests are answered and unknown PANs are FRAUD_CARD. The transactions with an
+              account are listed in the items, ordered by batchCompare, retries of requests in progress are listed
+              from the end of the items.
+*/
+static uint32_t lookupChunk(ST_serverShard_t *shard, ST_transaction_t *transData, uint32_t count, EN_transState_t *transStates,
+                            ST_batchItem_t *items, uint32_t *deferred)
+{
+    uint32_t Loc_Found = 0, Loc_Record;
+    /* Declare local variables to time the stages, stageStart gives 0 while stage histograms are off */
+    uint64_t Loc_Start;
+    EN_serverError_t Loc_ErrorState;
+    /* Define local variables to look up the retry cache */
+    uint64_t Loc_Now = retryNow();
+    EN_retryError_t Loc_RetryState;
+
+    *deferred = 0;
+
+    /* Loop: Until all requests are looked up in the retry cache and all accounts are looked up, start loading records early */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+    {
+        Loc_RetryState = retryBegin(&shard->retryCache, &transData[Loc_Index], Loc_Now);
+
+        /* Check 1: Request is done, answer with its result */
+        if (Loc_RetryState == RETRY_DONE)
+        {
+            transStates[Loc_Index] = transData[Loc_Index].transState;
+        }
+        /* Check 2: Request is in progress, answer the retry after the chunk */
+        else if (Loc_RetryState == RETRY_PENDING)
+        {
+            (*deferred)++;
+            items[count - *deferred].position = Loc_Index;
+        }
+        /* Check 3: Look up the account */
+        else
+        {
+            Loc_Start      = stageStart();
+            Loc_ErrorState = findAccount(shard, transData[Loc_Index].cardHolderData.primaryAccountNumber, &Loc_Record);
+            stageEnd(STAGE_VALID_ACCOUNT, Loc_Start);
+
+            /* Check 3.1: Account is not found */
+            if (Loc_ErrorState == ACCOUNT_NOT_FOUND)
+            {
+                transData[Loc_Index].transState = FRAUD_CARD;
+                transStates[Loc_Index]          = FRAUD_CARD;
+            }
+            else
+            {
+                __builtin_prefetch(&shard->accountsDatabase.balances[Loc_Record], 1);
+                __builtin_prefetch(&shard->accountsDatabase.states[Loc_Record], 0);
+
+                items[Loc_Found].record   = Loc_Record;
+                items[Loc_Found].position = Loc_Index;
+                Loc_Found++;
+            }
+        }
+    }
+
+    qsort(items, Loc_Found, sizeof(ST_batchItem_t), batchCompare);
+
+    return Loc_Found;
+}
+
+/*
+ Name: checkChunk
+ Input: Pointer to Server Shard, Pointer to Transactions, Pointer to Batch Items, Pointer to Log Records,
+        uint32_t Number of items, EN_flagState_t Pipeline flag
+ Output: void
+ Description: Static Function to check the transactions of the items of a chunk and fill their log records.
+              Every stripe lock is taken once in ascending order and every account record is read once, balances
+              run through the transactions of the account in order. An approved transaction is added to the
+              windows of its account when checked, so the next ones of the account are checked against it, it
+              stays in them if it is not saved.
+              Without the pipeline flag the stripe locks are held until applyChunk. With it every stripe is
+              released once checked, an account with transactions in flight starts from its projected balance,
+              and the projected balance and in flight count of every account are updated.
+*/
+static void checkChunk(ST_serverShard_t *shard, ST_transaction_t *transData, ST_batchItem_t *items, ST_logRecord_t *records,
+                       uint32_t found, EN_flagState_t pipelineFlag)
+{
+    ST_accountsDB_t Loc_CurrentAccount;
+    ST_transaction_t *Loc_Transaction;
+    uint32_t Loc_Record, Loc_Stripe;
+    /* Declare local variables to time the stages, stageStart gives 0 while stage histograms are off */
+    uint64_t Loc_Start;
+    EN_serverError_t Loc_ErrorState;
+    /* Define local variable to get the time of the velocity windows, only read while the limits are set */
+    uint32_t Loc_Now = (Glb_VelocityFlag == FLAG_UP) ? velocityNow() : 0;
+
+    /* Loop: Until all found transactions are checked */
+    for (uint32_t Loc_Item = 0; Loc_Item < found; Loc_Item++)
+    {
+        Loc_Record      = items[Loc_Item].record;
+        Loc_Stripe      = Loc_Record & (SERVER_ACCOUNT_LOCKS - 1);
+        Loc_Transaction = &transData[items[Loc_Item].position];
+
+        /* Check 1: First transaction of the stripe, hold it until the new balances are applied */
+        if (Loc_Item == 0 || Loc_Stripe != (items[Loc_Item - 1].record & (SERVER_ACCOUNT_LOCKS - 1)))
+        {
+            pthread_mutex_lock(&shard->accountLocks[Loc_Stripe].lock);
+        }
+
+        /* Check 2: First transaction of the account, copy Account hot columns, or the projected balance */
+        if (Loc_Item == 0 || Loc_Record != items[Loc_Item - 1].record)
+        {
+            Loc_CurrentAccount.balance = (pipelineFlag == FLAG_UP && shard->pipelineCounts[Loc_Record] > 0) ?
+                                         shard->pipelineBalances[Loc_Record] : shard->accountsDatabase.balances[Loc_Record];
+            Loc_CurrentAccount.state   = shard->accountsDatabase.states[Loc_Record];
+        }
+
+        Loc_Start      = stageStart();
+        Loc_ErrorState = isBlockedAccount(&Loc_CurrentAccount);
+        stageEnd(STAGE_BLOCKED_ACCOUNT, Loc_Start);
+
+        /* Check the amount of a running account only */
+        if (Loc_ErrorState != BLOCKED_ACCOUNT)
+        {
+            Loc_Start      = stageStart();
+            Loc_ErrorState = isAmountAvailable(&Loc_Transaction->terminalData, &Loc_CurrentAccount);
+            stageEnd(STAGE_AMOUNT_AVAILABLE, Loc_Start);
+        }
+
+        /* Check the velocity limits of a transaction that would be approved only */
+        if (Loc_ErrorState == SERVER_OK)
+        {
+            Loc_ErrorState = isBelowVelocityLimits(shard, Loc_Record, &Loc_Transaction->terminalData, Loc_Now);
+        }
+
+        /* Check 3: Account is blocked */
+        if (Loc_ErrorState == BLOCKED_ACCOUNT)
+        {
+            Loc_Transaction->transState = DECLINED_STOLEN_CARD;
+        }
+        /* Check 4: Amount is not available */
+        else if (Loc_ErrorState == LOW_BALANCE)
+        {
+            Loc_Transaction->transState = DECLINED_INSUFFECIENT_FUND;
+        }
+        /* Check 5: Velocity limit is exceeded */
+        else if (Loc_ErrorState == EXCEED_VELOCITY_LIMIT)
+        {
+            Loc_Transaction->transState = DECLINED_VELOCITY_LIMIT;
+        }
+        /* Check 6: Account is running, Amount is available and below the velocity limits */
+        else
+        {
+            Loc_Transaction->transState  = APPROVED;
+            Loc_CurrentAccount.balance  -= Loc_Transaction->terminalData.transAmount;
+            addVelocity(shard, Loc_Record, &Loc_Transaction->terminalData, Loc_Now);
+        }
+
+        memset(&records[Loc_Item], 0, sizeof(ST_logRecord_t));
+        records[Loc_Item].record  = Loc_Record;
+        records[Loc_Item].balance = Loc_CurrentAccount.balance;
+
+        /* Check 7: Pipeline, the transaction is in flight until applied */
+        if (pipelineFlag == FLAG_UP)
+        {
+            shard->pipelineBalances[Loc_Record] = Loc_CurrentAccount.balance;
+            shard->pipelineCounts[Loc_Record]++;
+
+            /* Check 7.1: Last transaction of the stripe */
+            if (Loc_Item + 1 == found || Loc_Stripe != (items[Loc_Item + 1].record & (SERVER_ACCOUNT_LOCKS - 1)))
+            {
+                pthread_mutex_unlock(&shard->accountLocks[Loc_Stripe].lock);
+            }
+        }
+    }
+}
+
+/*
+ Name: persistChunk
+ Input: Pointer to Server Shard, Pointer to Transactions, Pointer to Batch Items, Pointer to Log Records,
+        uint32_t Number of items
+ Output: uint32_t Number of transactions saved
+ Description: Static Function to append the checked transactions of a chunk to the transactions store and the log
+              with one log append and one log commit. Transactions are saved in item order, a prefix of them is
+              saved if the store fails or the sequence range of the shard is used up, none if the log fails.
+              Transactions the log fails to append or sync are dropped from the transactions store again. The saved
+              transactions become the last transactions of their accounts under the transactions lock once they
+              are durable, the chain heads are only read under it.
+*/
+static uint32_t persistChunk(ST_serverShard_t *shard, ST_transaction_t *transData, ST_batchItem_t *items, ST_logRecord_t *records,
+                             uint32_t found)
+{
+    ST_transaction_t *Loc_Transaction;
+    uint32_t Loc_Saved = 0, Loc_Record;
+    uint64_t Loc_LogOffset = 0;
+    EN_storeError_t Loc_StoreError = STORE_OK;
+    EN_logError_t Loc_CommitError;
+    /* Time saving the chunk as one sample, the appends and the shared sync */
+    uint64_t Loc_Start = stageStart();
+
+    pthread_mutex_lock(&shard->transactionsLock);
+
+    /* Loop: Until all checked transactions are in the transactions store, or the sequence range of the shard is used up */
+    while (Loc_Saved < found && Loc_StoreError == STORE_OK && shard->transactionsStore.nextSequenceNumber < shard->sequenceLimit)
+    {
+        Loc_Record      = items[Loc_Saved].record;
+        Loc_Transaction = &transData[items[Loc_Saved].position];
+
+        /* Chain after the previous transaction of the account, in this batch or before it */
+        records[Loc_Saved].previousSequenceNumber = (Loc_Saved > 0 && Loc_Record == items[Loc_Saved - 1].record) ?
+                                                    records[Loc_Saved - 1].transaction.transactionSequenceNumber :
+                                                    shard->accountsDatabase.lastSequences[Loc_Record];
+
+        Loc_StoreError = storeAppend(&shard->transactionsStore, Loc_Transaction, records[Loc_Saved].previousSequenceNumber);
+
+        /* Check: Transaction is in the transactions store */
+        if (Loc_StoreError == STORE_OK)
+        {
+            records[Loc_Saved].transaction = *Loc_Transaction;
+            Loc_Saved++;
+        }
+    }
+
+    /* Check 1: Transactions can't be appended to the log, drop them from the transactions store */
+    if (Loc_Saved > 0 && logAppend(&shard->transactionsLog, records, Loc_Saved, &Loc_LogOffset) != LOG_OK)
+    {
+        storeTruncate(&shard->transactionsStore, records[0].transaction.transactionSequenceNumber);
+        Loc_Saved = 0;
+    }
+
+    pthread_mutex_unlock(&shard->transactionsLock);
+
+    /* Check 2: Transactions are in the log */
+    if (Loc_Saved > 0)
+    {
+        Loc_CommitError = logCommit(&shard->transactionsLog, Loc_LogOffset);
+
+        pthread_mutex_lock(&shard->transactionsLock);
+
+        /* Check 2.1: Log can't be synced, drop the transactions and the ones after them from the transactions store */
+        if (Loc_CommitError != LOG_OK)
+        {
+            storeTruncate(&shard->transactionsStore, records[0].transaction.transactionSequenceNumber);
+            Loc_Saved = 0;
+        }
+
+        /* Loop: Until the durable transactions are the last transactions of their accounts, in order */
+        for (uint32_t Loc_Item = 0; Loc_Item < Loc_Saved; Loc_Item++)
+        {
+            shard->accountsDatabase.lastSequences[items[Loc_Item].record] = records[Loc_Item].transaction.transactionSequenceNumber;
+        }
+
+        pthread_mutex_unlock(&shard->transactionsLock);
+    }
+
+    stageEnd(STAGE_SAVE_TRANSACTION, Loc_Start);
+
+    return Loc_Saved;
+}
+
+/*
+ Name: applyChunk
+ Input: Pointer to Server Shard, Pointer to Transactions, Pointer to Transaction States, Pointer to Batch Items,
+        Pointer to Log Records, uint32_t Number of items, uint32_t Number of items saved, EN_flagState_t Pipeline flag
+ Output: void
+ Description: Static Function to apply the new balances of the saved transactions of a chunk, the others are
+              INTERNAL_SERVER_ERROR, and give every transaction its state.
+              Without the pipeline flag the stripe locks of checkChunk are released here. With it every stripe is
+              locked again, the transactions leave the in flight count and the debits of approved transactions
+              not saved are given back to the projected balance.
+*/
+static void applyChunk(ST_serverShard_t *shard, ST_transaction_t *transData, EN_transState_t *transStates, ST_batchItem_t *items,
+                       ST_logRecord_t *records, uint32_t found, uint32_t saved, EN_flagState_t pipelineFlag)
+{
+    ST_transaction_t *Loc_Transaction;
+    uint32_t Loc_Record, Loc_Stripe;
+
+    /* Loop: Until all found transactions are applied or failed */
+    for (uint32_t Loc_Item = 0; Loc_Item < found; Loc_Item++)
+    {
+        Loc_Record      = items[Loc_Item].record;
+        Loc_Stripe      = Loc_Record & (SERVER_ACCOUNT_LOCKS - 1);
+        Loc_Transaction = &transData[items[Loc_Item].position];
+
+        /* Check 1: Pipeline, first transaction of the stripe */
+        if (pipelineFlag == FLAG_UP && (Loc_Item == 0 || Loc_Stripe != (items[Loc_Item - 1].record & (SERVER_ACCOUNT_LOCKS - 1))))
+        {
+            pthread_mutex_lock(&shard->accountLocks[Loc_Stripe].lock);
+        }
+
+        /* Check 2: Transaction is durable in the log */
+        if (Loc_Item < saved)
+        {
+            databaseMarkAccount(&shard->accountsDatabase, Loc_Record);
+
+            /* Check 2.1: Transaction is approved, update Account balance with new balance */
+            if (Loc_Transaction->transState == APPROVED)
+            {
+                shard->accountsDatabase.balances[Loc_Record] = records[Loc_Item].balance;
+            }
+        }
+        /* Check 3: Saving failed, an approved debit in flight is given back */
+        else
+        {
+            /* Check 3.1: Pipeline, approved transaction */
+            if (pipelineFlag == FLAG_UP && Loc_Transaction->transState == APPROVED)
+            {
+                shard->pipelineBalances[Loc_Record] += Loc_Transaction->terminalData.transAmount;
+            }
+
+            Loc_Transaction->transState = INTERNAL_SERVER_ERROR;
+        }
+
+        transStates[items[Loc_Item].position] = Loc_Transaction->transState;
+
+        /* Check 4: Pipeline, the transaction is not in flight anymore */
+        if (pipelineFlag == FLAG_UP)
+        {
+            shard->pipelineCounts[Loc_Record]--;
+        }
+
+        /* Check 5: Last transaction of the stripe */
+        if (Loc_Item + 1 == found || Loc_Stripe != (items[Loc_Item + 1].record & (SERVER_ACCOUNT_LOCKS - 1)))
+        {
+            pthread_mutex_unlock(&shard->accountLocks[Loc_Stripe].lock);
+        }
+    }
+}
+
+/*
+ Name: recieveTransactionChunk
+ Input: Pointer to Server Shard, Pointer to Transactions, uint32_t Number of transactions, Pointer to Transaction States,
+        Pointer to Batch Items, Pointer to Log Records
+ Output: void
+ Description: Static Function to authorize up to SERVER_BATCH_TRANSACTIONS transactions with one log append and one
+              log commit, the stripe locks of the accounts are held from the checks until the new balances are
+              applied. Retries of done requests are answered from the retry cache, retries of requests in progress,
+              in this chunk or elsewhere, are authorized one by one once the chunk is done.
+*/
+static void recieveTransactionChunk(ST_serverShard_t *shard, ST_transaction_t *transData, uint32_t count, EN_transState_t *transStates,
+                                    ST_batchItem_t *items, ST_logRecord_t *records)
+{
+    uint32_t Loc_Deferred;
+    uint32_t Loc_Found = lookupChunk(shard, transData, count, transStates, items, &Loc_Deferred);
+    uint32_t Loc_Saved;
+
+    checkChunk(shard, transData, items, records, Loc_Found, FLAG_DOWN);
+    Loc_Saved = persistChunk(shard, transData, items, records, Loc_Found);
+    applyChunk(shard, transData, transStates, items, records, Loc_Found, Loc_Saved, FLAG_DOWN);
+
+    /* Check: Transactions are saved, checkpoint in the background once enough transactions are saved */
+    if (Loc_Saved > 0)
+    {
+        requestCheckpoint(shard, shard->transactionsStore.nextSequenceNumber);
+    }
+
+    /* Loop: Until the results of all requests held in the retry cache by the chunk are recorded */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+    {
+        retryEnd(&shard->retryCache, &transData[Loc_Index]);
+    }
+
+    /* Loop: Until all deferred retries are answered, their first submissions are done or in progress elsewhere */
+    for (uint32_t Loc_Item = count - Loc_Deferred; Loc_Item < count; Loc_Item++)
+    {
+        transStates[items[Loc_Item].position] = recieveRetriedTransaction(shard, &transData[items[Loc_Item].position]);
+    }
+}
+
+/*
+ Name: failTransactions
+ Input: Pointer to Transactions, uint32_t Number of transactions, Pointer to Transaction States
+ Output: void
+ Description: Static Function to give every transaction of a batch the INTERNAL_SERVER_ERROR state.
+*/
+static void failTransactions(ST_transaction_t *transData, uint32_t count, EN_transState_t *transStates)
+{
+    /* Loop: Until all transactions are failed */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+    {
+        transData[Loc_Index].transState = INTERNAL_SERVER_ERROR;
+        transStates[Loc_Index]          = INTERNAL_SERVER_ERROR;
+    }
+}
+
+/*
+ Name: completeEntries
+ Input: Pointer to Queue Entries, Pointer to Transactions, Pointer to Transaction States, uint32_t Number of entries
+ Output: void
+ Description: Static Function to copy every authorized transaction and its state back to its entry and complete
+              the entries, once per run of entries sharing a completion slot.
+*/
+static void completeEntries(ST_queueEntry_t *entries, ST_transaction_t *transData, EN_transState_t *transStates, uint32_t count)
+{
+    uint32_t Loc_Done = 0;
+
+    /* Loop: Until all results are copied back and their entries completed */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+    {
+        *entries[Loc_Index].transData  = transData[Loc_Index];
+        *entries[Loc_Index].transState = transStates[Loc_Index];
+        Loc_Done++;
+
+        /* Check: Last entry of a run sharing a completion slot, the slot may be gone once completed */
+        if (Loc_Index + 1 == count || entries[Loc_Index + 1].completion != entries[Loc_Index].completion)
+        {
+            queueComplete(entries[Loc_Index].completion, Loc_Done);
+            Loc_Done = 0;
+        }
+    }
+}
+
+/*
+ Name: shardFlush
+ Input: Pointer to Server Shard, uint32_t Number of entries popped into the worker batch
+ Output: void
+ Description: Static Function to authorize the worker batch of a shard with one log append and one log sync, then
+              complete its entries.
+*/
+static void shardFlush(ST_serverShard_t *shard, uint32_t count)
+{
+    /* Loop: Until the transactions of all entries are in the worker batch */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+    {
+        shard->batchTransactions[Loc_Index] = *shard->batchEntries[Loc_Index].transData;
+    }
+
+    recieveTransactionChunk(shard, shard->batchTransactions, count, shard->batchStates, shard->batchItems, shard->batchRecords);
+    completeEntries(shard->batchEntries, shard->batchTransactions, shard->batchStates, count);
+}
+
+/*
+ Name: shardWorker
+ Input: Pointer to Server Shard
+ Output: NULL
+ Description: Static Function run by the worker of a shard, pinned to one core, the only consumer of the queue of
+              the shard. It pops up to SERVER_BATCH_TRANSACTIONS entries at once and authorizes them together, so
+              entries pushed while the log syncs share the next sync, and sleeps while the queue is empty. The
+              worker is the only thread changing the accounts of the shard, its locks and account lines stay in
+              the cache of its core. It stops once closeServer puts its run flag down and the queue is empty.
+*/
+static void *shardWorker(void *argument)
+{
+    ST_serverShard_t *Loc_Shard = argument;
+    uint32_t Loc_Count;
+    long Loc_Cores = sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_set_t Loc_CoreSet;
+
+    /* Pin the worker, shards share cores round robin when there are more shards than cores */
+    CPU_ZERO(&Loc_CoreSet);
+    CPU_SET(Loc_Shard->index % ((Loc_Cores > 0) ? Loc_Cores : 1), &Loc_CoreSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &Loc_CoreSet);
+
+    Loc_Count = queuePop(&Loc_Shard->queue, Loc_Shard->batchEntries, SERVER_BATCH_TRANSACTIONS);
+
+    /* Loop: Until the server is closed and no entry is left */
+    while (Loc_Count > 0 || __atomic_load_n(&Loc_Shard->workerRunFlag, __ATOMIC_SEQ_CST) == FLAG_UP)
+    {
+        /* Check 1: No entry, sleep until one is pushed */
+        if (Loc_Count == 0)
+        {
+            queueSleep(&Loc_Shard->queue, &Loc_Shard->workerRunFlag);
+        }
+        /* Check 2: Authorize the popped entries */
+        else
+        {
+            shardFlush(Loc_Shard, Loc_Count);
+        }
+
+        Loc_Count = queuePop(&Loc_Shard->queue, Loc_Shard->batchEntries, SERVER_BATCH_TRANSACTIONS);
+    }
+
+    return NULL;
+}
+
+/*
+ Name: shardSubmit
+ Input: Pointer to Server Shard, Pointer to Transaction, Pointer to Transaction State, Pointer to Queue Completion
+ Output: void
+ Description: Static Function to push a transaction to the queue of the worker of a shard, yielding while the queue
+              is full.
+*/
+static void shardSubmit(ST_serverShard_t *shard, ST_transaction_t *transData, EN_transState_t *transState,
+                        ST_queueCompletion_t *completion)
+{
+    ST_queueEntry_t Loc_Entry;
+
+    Loc_Entry.transData  = transData;
+    Loc_Entry.transState = transState;
+    Loc_Entry.completion = completion;
+
+    /* Loop: Until the worker made room for the entry */
+    while (queuePush(&shard->queue, &Loc_Entry) == QUEUE_FULL)
+    {
+        sched_yield();
+    }
+}
+
+/*
+ Name: shardBatch
+ Input: Pointer to Transactions, uint32_t Number of transactions, Pointer to Transaction States
+ Output: void
+ Description: Static Function to push every transaction of a batch to the queue of the shard of its PAN, in batch
+              order, and wait on one completion slot for all of them, the shards authorize their parts at the same
+              time. Transactions are not copied, an entry points at the transaction and its state.
+*/
+static void shardBatch(ST_transaction_t *transData, uint32_t count, EN_transState_t *transStates)
+{
+    ST_queueCompletion_t Loc_Completion;
+
+    queueStartCompletion(&Loc_Completion, count);
+
+    /* Loop: Until every transaction is pushed to its shard */
+    for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index++)
+    {
+        shardSubmit(panShard(transData[Loc_Index].cardHolderData.primaryAccountNumber), &transData[Loc_Index],
+                    &transStates[Loc_Index], &Loc_Completion);
+    }
+
+    queueWaitCompletion(&Loc_Completion);
+}
+
+/*
+ Name: stopWorkers
+ Input: uint32_t Number of workers started
+ Output: void
+ Description: Static Function to stop the first workers once their queues are empty, and free their queues and
+              batches.
+*/
+static void stopWorkers(uint32_t count)
+{
+    /* Loop: Until all started workers are stopped */
+    for (uint32_t Loc_Shard = 0; Loc_Shard < count; Loc_Shard++)
+    {
+        __atomic_store_n(&Glb_Shards[Loc_Shard].workerRunFlag, FLAG_DOWN, __ATOMIC_SEQ_CST);
+        queueWake(&Glb_Shards[Loc_Shard].queue);
+        pthread_join(Glb_Shards[Loc_Shard].workerThread, NULL);
+    }
+
+    /* Loop: Until the queues and batches of all shards are freed */
+    for (uint32_t Loc_Shard = 0; Loc_Shard < Glb_ShardCount; Loc_Shard++)
+    {
+        queueFree(&Glb_Shards[Loc_Shard].queue);
+        free(Glb_Shards[Loc_Shard].batchEntries);
+        free(Glb_Shards[Loc_Shard].batchTransactions);
+        free(Glb_Shards[Loc_Shard].batchStates);
+        free(Glb_Shards[Loc_Shard].batchItems);
+        free(Glb_Shards[Loc_Shard].batchRecords);
+    }
+}
+
+/*
+ Name: pipelinePut
+ Input: Pointer to Pipeline Ring, Pointer to Pipeline Batch or NULL to stop the stage
+ Output: void
+ Description: Static Function to hand a batch to the stage reading a ring. A ring holds every batch and the stop
+              marker, putting never waits, the free ring is the only bound on the batches in flight.
+*/
+static void pipelinePut(ST_pipelineRing_t *ring, ST_pipelineBatch_t *batch)
+{
+    pthread_mutex_lock(&ring->lock);
+    ring->batches[(ring->head + ring->count) % (SERVER_PIPELINE_DEPTH + 1)] = batch;
+    ring->count++;
+    pthread_cond_signal(&ring->condition);
+    pthread_mutex_unlock(&ring->lock);
+}
+
+/*
+ Name: pipelineTake
+ Input: Pointer to Pipeline Ring
+ Output: Pointer to Pipeline Batch, or NULL to stop the stage
+ Description: Static Function to take the oldest batch of a ring, waiting until one is put.
+*/
+static ST_pipelineBatch_t *pipelineTake(ST_pipelineRing_t *ring)
+{
+    ST_pipelineBatch_t *Loc_Batch;
+
+    pthread_mutex_lock(&ring->lock);
+
+    /* Loop: Until a batch is put */
+    while (ring->count == 0)
+    {
+        pthread_cond_wait(&ring->condition, &ring->lock);
+    }
+
+    Loc_Batch  = ring->batches[ring->head];
+    ring->head = (ring->head + 1) % (SERVER_PIPELINE_DEPTH + 1);
+    ring->count--;
+    pthread_mutex_unlock(&ring->lock);
+
+    return Loc_Batch;
+}
+
+/*
+ Name: pipelineLookup
+ Input: Pointer to Server Shard
+ Output: NULL
+ Description: Static Function run by the lookup stage, the only consumer of the queue of the shard. It takes a free
+              batch, waiting while all batches are in flight, so a slow later stage stops the lookups and then
+              fills the queue. It pops up to SERVER_BATCH_TRANSACTIONS entries into the batch, looks up their
+              retries and accounts and hands the batch to the check stage. It stops the stages after it once
+              closeServer puts its run flag down and the queue is empty.
+*/
+static void *pipelineLookup(void *argument)
+{
+    ST_serverShard_t *Loc_Shard = argument;
+    ST_pipelineBatch_t *Loc_Batch = pipelineTake(&Glb_PipelineRings[PIPELINE_LOOKUP]);
+
+    Loc_Batch->count = queuePop(&Loc_Shard->queue, Loc_Batch->entries, SERVER_BATCH_TRANSACTIONS);
+
+    /* Loop: Until the server is closed and no entry is left */
+    while (Loc_Batch->count > 0 || __atomic_load_n(&Loc_Shard->workerRunFlag, __ATOMIC_SEQ_CST) == FLAG_UP)
+    {
+        /* Check 1: No entry, sleep until one is pushed */
+        if (Loc_Batch->count == 0)
+        {
+            queueSleep(&Loc_Shard->queue, &Loc_Shard->workerRunFlag);
+        }
+        /* Check 2: Look up the popped entries, and take the next free batch */
+        else
+        {
+            /* Loop: Until the transactions of all entries are in the batch */
+            for (uint32_t Loc_Index = 0; Loc_Index < Loc_Batch->count; Loc_Index++)
+            {
+                Loc_Batch->transactions[Loc_Index] = *Loc_Batch->entries[Loc_Index].transData;
+            }
+
+            Loc_Batch->found = lookupChunk(Loc_Shard, Loc_Batch->transactions, Loc_Batch->count, Loc_Batch->states,
+                                           Loc_Batch->items, &Loc_Batch->deferred);
+
+            pipelinePut(&Glb_PipelineRings[PIPELINE_CHECK], Loc_Batch);
+            Loc_Batch = pipelineTake(&Glb_PipelineRings[PIPELINE_LOOKUP]);
+        }
+
+        Loc_Batch->count = queuePop(&Loc_Shard->queue, Loc_Batch->entries, SERVER_BATCH_TRANSACTIONS);
+    }
+
+    pipelinePut(&Glb_PipelineRings[PIPELINE_CHECK], NULL);
+
+    return NULL;
+}
+
+/*
+ Name: pipelineCheck
+ Input: Pointer to Server Shard
+ Output: NULL
+ Description: Static Function run by the check stage, it checks the batches in order against the projected
+              balances of the accounts, so transactions of an account in flight in later stages are counted. Once
+              a batch is not fully saved, the batches checked after it may count its debits, it waits until all
+              checked batches are applied and their debits given back before checking again.
+*/
+static void *pipelineCheck(void *argument)
+{
+    ST_serverShard_t *Loc_Shard = argument;
+    ST_pipelineBatch_t *Loc_Batch = pipelineTake(&Glb_PipelineRings[PIPELINE_CHECK]);
+
+    /* Loop: Until the stage is stopped */
+    while (Loc_Batch != NULL)
+    {
+        /* Check: A batch failed, wait until no checked batch is in flight */
+        if (__atomic_load_n(&Glb_PipelineFailedFlag, __ATOMIC_SEQ_CST) == FLAG_UP)
+        {
+            /* Loop: Until all checked batches are applied */
+            while (__atomic_load_n(&Glb_PipelineApplied, __ATOMIC_ACQUIRE) != Glb_PipelineChecked)
+            {
+                sched_yield();
+            }
+
+            __atomic_store_n(&Glb_PipelineFailedFlag, FLAG_DOWN, __ATOMIC_SEQ_CST);
+        }
+
+        Glb_PipelineChecked++;
+        checkChunk(Loc_Shard, Loc_Batch->transactions, Loc_Batch->items, Loc_Batch->records, Loc_Batch->found, FLAG_UP);
+
+        pipelinePut(&Glb_PipelineRings[PIPELINE_PERSIST], Loc_Batch);
+        Loc_Batch = pipelineTake(&Glb_PipelineRings[PIPELINE_CHECK]);
+    }
+
+    pipelinePut(&Glb_PipelineRings[PIPELINE_PERSIST], NULL);
+
+    return NULL;
+}
+
+/*
+ Name: pipelinePersist
+ Input: Pointer to Server Shard
+ Output: NULL
+ Description: Static Function run by the persist stage, it saves the batches in order with one log append and one
+              log sync each. Once a batch is not fully saved, the batches already checked may count its debits in
+              their balances, they are not saved either until the check stage waited for them to be applied.
+*/
+static void *pipelinePersist(void *argument)
+{
+    ST_serverShard_t *Loc_Shard = argument;
+    ST_pipelineBatch_t *Loc_Batch = pipelineTake(&Glb_PipelineRings[PIPELINE_PERSIST]);
+
+    /* Loop: Until the stage is stopped */
+    while (Loc_Batch != NULL)
+    {
+        /* Check 1: Batch was checked after a failed batch, before its debits were given back */
+        if (__atomic_load_n(&Glb_PipelineFailedFlag, __ATOMIC_SEQ_CST) == FLAG_UP)
+        {
+            Loc_Batch->saved = 0;
+        }
+        /* Check 2: Save the batch */
+        else
+        {
+            Loc_Batch->saved = persistChunk(Loc_Shard, Loc_Batch->transactions, Loc_Batch->items, Loc_Batch->records, Loc_Batch->found);
+        }
+
+        /* Check 3: Batch is not fully saved, fail the batches checked before its debits are given back */
+        if (Loc_Batch->saved < Loc_Batch->found)
+        {
+            __atomic_store_n(&Glb_PipelineFailedFlag, FLAG_UP, __ATOMIC_SEQ_CST);
+        }
+
+        Loc_Batch->nextSequenceNumber = (Loc_Batch->saved > 0) ?
+                                        Loc_Batch->records[Loc_Batch->saved - 1].transaction.transactionSequenceNumber + 1 : 0;
+
+        pipelinePut(&Glb_PipelineRings[PIPELINE_APPLY], Loc_Batch);
+        Loc_Batch = pipelineTake(&Glb_PipelineRings[PIPELINE_PERSIST]);
+    }
+
+    pipelinePut(&Glb_PipelineRings[PIPELINE_APPLY], NULL);
+
+    return NULL;
+}
+
+/*
+ Name: pipelineApply
+ Input: Pointer to Server Shard
+ Output: NULL
+ Description: Static Function run by the apply stage, it applies the balances of the saved transactions of the
+              batches in order, moves the checkpoint cut after them, records the results for retries, answers
+              the retries of requests that were in progress and completes the entries. A retry whose first
+              submission failed is INTERNAL_SERVER_ERROR, the stage can't wait on its own batches. The batch is
+              then free for the lookup stage.
+*/
+static void *pipelineApply(void *argument)
+{
+    ST_serverShard_t *Loc_Shard = argument;
+    ST_pipelineBatch_t *Loc_Batch = pipelineTake(&Glb_PipelineRings[PIPELINE_APPLY]);
+    ST_transaction_t *Loc_Transaction;
+    uint64_t Loc_Now;
+
+    /* Loop: Until the stage is stopped */
+    while (Loc_Batch != NULL)
+    {
+        applyChunk(Loc_Shard, Loc_Batch->transactions, Loc_Batch->states, Loc_Batch->items, Loc_Batch->records,
+                   Loc_Batch->found, Loc_Batch->saved, FLAG_UP);
+        __atomic_add_fetch(&Glb_PipelineApplied, 1, __ATOMIC_RELEASE);
+
+        /* Check 1: Transactions are applied, move the checkpoint cut, checkpoint once enough transactions are applied */
+        if (Loc_Batch->nextSequenceNumber != 0)
+        {
+            __atomic_store_n(&Loc_Shard->appliedSequenceNumber, Loc_Batch->nextSequenceNumber, __ATOMIC_RELEASE);
+            requestCheckpoint(Loc_Shard, Loc_Batch->nextSequenceNumber);
+        }
+
+        /* Loop: Until the results of all requests held in the retry cache by the batch are recorded */
+        for (uint32_t Loc_Index = 0; Loc_Index < Loc_Batch->count; Loc_Index++)
+        {
+            retryEnd(&Loc_Shard->retryCache, &Loc_Batch->transactions[Loc_Index]);
+        }
+
+        Loc_Now = retryNow();
+
+        /* Loop: Until all deferred retries are answered, their first submissions are done by now */
+        for (uint32_t Loc_Item = Loc_Batch->count - Loc_Batch->deferred; Loc_Item < Loc_Batch->count; Loc_Item++)
+        {
+            Loc_Transaction = &Loc_Batch->transactions[Loc_Batch->items[Loc_Item].position];
+
+            /* Check 2: First submission failed, fail the retry too */
+            if (retryBegin(&Loc_Shard->retryCache, Loc_Transaction, Loc_Now) != RETRY_DONE)
+            {
+                Loc_Transaction->transState = INTERNAL_SERVER_ERROR;
+                retryEnd(&Loc_Shard->retryCache, Loc_Transaction);
+            }
+
+            Loc_Batch->states[Loc_Batch->items[Loc_Item].position] = Loc_Transaction->transState;
+        }
+
+        completeEntries(Loc_Batch->entries, Loc_Batch->transactions, Loc_Batch->states, Loc_Batch->count);
+
+        pipelinePut(&Glb_PipelineRings[PIPELINE_LOOKUP], Loc_Batch);
+        Loc_Batch = pipelineTake(&Glb_PipelineRings[PIPELINE_APPLY]);
+    }
+
+    return NULL;
+}
+
+/*
+ Name: stopPipeline
+ Input: uint32_t Number of stages started, from the apply stage back
+ Output: void
+ Description: Static Function to stop the started stages once the queue is empty and all batches are applied, then
+              free the queue, the batches and the projected balances.
+*/
+static void stopPipeline(uint32_t started)
+{
+    ST_serverShard_t *Loc_Shard = &Glb_Shards[0];
+
+    /* Check 1: Lookup stage is started, it stops the others once the queue is empty */
+    if (started == PIPELINE_STAGES)
+    {
+        __atomic_store_n(&Loc_Shard->workerRunFlag, FLAG_DOWN, __ATOMIC_SEQ_CST);
+        queueWake(&Loc_Shard->queue);
+    }
+    /* Check 2: Stop the first stage started */
+    else if (started > 0)
+    {
+        pipelinePut(&Glb_PipelineRings[PIPELINE_STAGES - started], NULL);
+    }
+
+    /* Loop: Until all started stages are stopped */
+    for (uint32_t Loc_Stage = PIPELINE_STAGES - started; Loc_Stage < PIPELINE_STAGES; Loc_Stage++)
+    {
+        pthread_join(Glb_PipelineThreads[Loc_Stage], NULL);
+    }
+
+    /* Loop: Until all batches are freed */
+    for (uint32_t Loc_Index = 0; Loc_Index < SERVER_PIPELINE_DEPTH; Loc_Index++)
+    {
+        free(Glb_PipelineBatches[Loc_Index].entries);
+        free(Glb_PipelineBatches[Loc_Index].transactions);
+        free(Glb_PipelineBatches[Loc_Index].states);
+        free(Glb_PipelineBatches[Loc_Index].items);
+        free(Glb_PipelineBatches[Loc_Index].records);
+    }
+
+    /* Loop: Until all rings are destroyed */
+    for (uint32_t Loc_Stage = 0; Loc_Stage < PIPELINE_STAGES; Loc_Stage++)
+    {
+        pthread_mutex_destroy(&Glb_PipelineRings[Loc_Stage].lock);
+        pthread_cond_destroy(&Glb_PipelineRings[Loc_Stage].condition);
+    }
+
+    queueFree(&Loc_Shard->queue);
+    free(Loc_Shard->pipelineBalances);
+    free(Loc_Shard->pipelineCounts);
+    Loc_Shard->pipelineBalances = NULL;
+    Loc_Shard->pipelineCounts   = NULL;
+
+    /* The final checkpoint is cut at the next sequence number of the store again */
+    pthread_mutex_lock(&Loc_Shard->transactionsLock);
+    Loc_Shard->pipelineFlag = FLAG_DOWN;
+    pthread_mutex_unlock(&Loc_Shard->transactionsLock);
+}
+
+/*
+ Name: standbyCopyFile
+ Input: Pointer to source file path, Pointer to destination file path
+ Output: EN_flagState_t Copied flag
+ Description: Static Function to copy a file of the primary server while it writes it, in order from its start, then
+              sync the copy. Blocks of zeros are not written, holes of the source stay holes in the copy.
+*/
+static EN_flagState_t standbyCopyFile(uint8_t *source, uint8_t *destination)
+{
+    /* Define local variable to set the flag state, Flag Down */
+    EN_flagState_t Loc_CopiedFlag = FLAG_DOWN;
+    sint32_t Loc_Source = open(source, O_RDONLY);
+    sint32_t Loc_Destination = open(destination, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    uint64_t *Loc_Buffer = malloc(SERVER_STANDBY_COPY_SIZE);
+    uint64_t Loc_Offset = 0;
+    sint64_t Loc_Read = 1;
+    uint32_t Loc_Word;
+
+    /* Check: Files are open and buffer is allocated */
+    if (Loc_Source >= 0 && Loc_Destination >= 0 && Loc_Buffer != NULL)
+    {
+        Loc_CopiedFlag = FLAG_UP;
+
+        /* Loop: Until the end of the source, or a block can't be copied */
+        while (Loc_CopiedFlag == FLAG_UP && (Loc_Read = pread(Loc_Source, Loc_Buffer, SERVER_STANDBY_COPY_SIZE, Loc_Offset)) > 0)
+        {
+            Loc_Word = 0;
+
+            /* Loop: Until a word which is not zero, or the end of the whole words read */
+            while (Loc_Word < Loc_Read / sizeof(uint64_t) && Loc_Buffer[Loc_Word] == 0)
+            {
+                Loc_Word++;
+            }
+
+            /* Check: Block is not all zeros, and can't be written */
+            if ((Loc_Word < Loc_Read / sizeof(uint64_t) || Loc_Read % sizeof(uint64_t) != 0) &&
+                pwrite(Loc_Destination, Loc_Buffer, Loc_Read, Loc_Offset) != Loc_Read)
+            {
+                Loc_CopiedFlag = FLAG_DOWN;
+            }
+
+            Loc_Offset += Loc_Read;
+        }
+
+        /* Check: Source can't be read, or copy can't be sized and synced */
+        if (Loc_Read < 0 || ftruncate(Loc_Destination, Loc_Offset) != 0 || fsync(Loc_Destination) != 0)
+        {
+            Loc_CopiedFlag = FLAG_DOWN;
+        }
+    }
+
+    /* Check: Source is open */
+    if (Loc_Source >= 0)
+    {
+        close(Loc_Source);
+    }
+
+    /* Check: Destination is open */
+    if (Loc_Destination >= 0)
+    {
+        close(Loc_Destination);
+    }
+
+    free(Loc_Buffer);
+
+    return Loc_CopiedFlag;
+}
+
+/*
+ Name: standbyCopyShard
+ Input: Pointer to primary directory, Pointer to accounts file name, Pointer to log file name, Pointer to archive
+        file name
+ Output: EN_serverError_t Error or No Error
+ Description: Static Function to make the base copy of a shard of the primary server, unless the standby has its
+              accounts file already and goes on from the end of its own log. The archive is copied first, then the
+              accounts file, from its header with the checkpoint to the balances at least as new, then the log,
+              with every record from the end of the archive, so recovery replays the copied log from the
+              checkpoint. The primary may archive and release more of its log while the files are copied, the copy
+              is then made again, up to SERVER_STANDBY_COPY_ATTEMPTS times. The accounts file gets its name once
+              the copy is complete.
+*/
+static EN_serverError_t standbyCopyShard(uint8_t *primaryDirectory, uint8_t *accountsFile, uint8_t *logFile, uint8_t *archiveFile)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    uint8_t Loc_Source[SERVER_STANDBY_PATH_SIZE], Loc_Copy[SERVER_STANDBY_PATH_SIZE];
+    ST_archive_t Loc_Archive;
+    ST_log_t Loc_Log;
+    ST_logRecord_t Loc_Record;
+    uint32_t Loc_Attempt = 0;
+    /* Define local variable to set the flag state, Flag Down */
+    EN_flagState_t Loc_CopiedFlag = FLAG_DOWN;
+
+    snprintf(Loc_Copy, sizeof(Loc_Copy), "%s.copy", accountsFile);
+
+    /* Loop: Until the standby has the accounts file, or the attempts are used up */
+    while (access(accountsFile, F_OK) != 0 && Loc_Attempt < SERVER_STANDBY_COPY_ATTEMPTS)
+    {
+        Loc_Attempt++;
+        Loc_CopiedFlag = FLAG_DOWN;
+        unlink(logFile);
+
+        /* Check 1: Archive can't be copied or opened */
+        if ((snprintf(Loc_Source, sizeof(Loc_Source), "%s/%s", primaryDirectory, archiveFile),
+             standbyCopyFile(Loc_Source, archiveFile)) == FLAG_DOWN ||
+            archiveOpen(&Loc_Archive, archiveFile, SERVER_FIRST_SEQUENCE_NUMBER) != ARCHIVE_OK)
+        {
+            /* Update error state, Init Failed! */
+            Loc_ErrorState = INIT_FAILED;
+        }
+        /* Check 2: Accounts file and log can be copied, and the log has every record from the end of the archive */
+        else
+        {
+            archiveClose(&Loc_Archive);
+
+            /* Check 2.1: Copies are made and the log can be opened */
+            if ((snprintf(Loc_Source, sizeof(Loc_Source), "%s/%s", primaryDirectory, accountsFile),
+                 standbyCopyFile(Loc_Source, Loc_Copy)) == FLAG_UP &&
+                (snprintf(Loc_Source, sizeof(Loc_Source), "%s/%s", primaryDirectory, logFile),
+                 standbyCopyFile(Loc_Source, logFile)) == FLAG_UP &&
+                logOpen(&Loc_Log, logFile, SERVER_FIRST_SEQUENCE_NUMBER) == LOG_OK)
+            {
+                Loc_CopiedFlag = (Loc_Archive.nextSequenceNumber == Loc_Log.nextSequenceNumber ||
+                                  logRead(&Loc_Log, Loc_Archive.nextSequenceNumber, &Loc_Record) == LOG_OK) ? FLAG_UP : FLAG_DOWN;
+                logClose(&Loc_Log);
+            }
+
+            /* Check 2.2: Copy is complete, the standby has the accounts file */
+            if (Loc_CopiedFlag == FLAG_UP && rename(Loc_Copy, accountsFile) == 0)
+            {
+                Loc_ErrorState = SERVER_OK;
+            }
+            else
+            {
+                unlink(Loc_Copy);
+
+                /* Update error state, Init Failed! */
+                Loc_ErrorState = INIT_FAILED;
+            }
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: standbyAddAccounts
+ Input: Pointer to Server Shard
+ Output: EN_flagState_t Added flag
+ Description: Static Function to add to the standby shard the accounts the primary added after the base copy, read
+              from the accounts file of the primary. The primary writes an account to its accounts file before a
+              transaction on it is logged, and adds accounts in record order, so they get the same records in the
+              standby. The accounts file of the standby is written before a record on them is applied. If an
+              account can't be read or added will return FLAG_DOWN, else FLAG_UP.
+*/
+static EN_flagState_t standbyAddAccounts(ST_serverShard_t *shard)
+{
+    /* Define local variable to set the added flag, Added */
+    EN_flagState_t Loc_AddedFlag = FLAG_UP;
+    ST_accountsDB_t Loc_Accounts[SERVER_STANDBY_ACCOUNTS];
+    uint32_t Loc_Count = SERVER_STANDBY_ACCOUNTS, Loc_Added = 0, Loc_Record;
+
+    /* Loop: Until the accounts file of the primary has no more accounts, or an account can't be read or added */
+    while (Loc_AddedFlag == FLAG_UP && Loc_Count == SERVER_STANDBY_ACCOUNTS)
+    {
+        /* Check: Accounts can't be read from the accounts file of the primary */
+        if (databaseReadAccounts(shard->primaryAccountsFile, shard->accountsDatabase.header->count, SERVER_STANDBY_ACCOUNTS,
+                                 Loc_Accounts, &Loc_Count) != DATABASE_OK)
+        {
+            Loc_AddedFlag = FLAG_DOWN;
+        }
+
+        /* Loop: Until all read accounts are added at their records in the primary, or one can't be */
+        for (uint32_t Loc_Index = 0; Loc_AddedFlag == FLAG_UP && Loc_Index < Loc_Count; Loc_Index++)
+        {
+            Loc_AddedFlag = (databaseAddAccount(&shard->accountsDatabase, &Loc_Accounts[Loc_Index], &Loc_Record) == DATABASE_OK) ? FLAG_UP : FLAG_DOWN;
+            Loc_Added++;
+        }
+    }
+
+    /* Check: Added accounts can't be written to the accounts file */
+    if (Loc_AddedFlag == FLAG_UP && Loc_Added != 0 && databaseSync(&shard->accountsDatabase) != DATABASE_OK)
+    {
+        Loc_AddedFlag = FLAG_DOWN;
+    }
+
+    return Loc_AddedFlag;
+}
+
+/*
+ Name: standbyShip
+ Input: Pointer to Server Shard
+ Output: uint32_t Number of transactions shipped
+ Description: Static Function to ship the next records of the log of the primary, up to SERVER_BATCH_TRANSACTIONS,
+              into the standby shard. They are appended at the same sequence numbers to the log of the shard and
+              synced, then applied as recovery does, with the balance after each transaction, and become the last
+              transaction of their account. Their requests are put in the retry cache, a retry after the standby
+              takes over is not debited again, and approved transactions are added to the windows of their
+              accounts at the time they are shipped. A record on an account added to the primary after the base copy
+              first adds the accounts added since from the accounts file of the primary, as a caught up shard does,
+              so the accounts of the standby follow the primary's. A record whose account can't be added, or the
+              primary released, is never read again, the shard stops shipping and fails. The primary writes one group of at most LOG_BUFFER_RECORDS records at a time, only a
+              record that can't be read further back than that from the end of its log is released.
+*/
+static uint32_t standbyShip(ST_serverShard_t *shard)
+{
+    ST_logRecord_t *Loc_Records = shard->standbyRecords;
+    uint32_t Loc_Next = shard->transactionsLog.nextSequenceNumber;
+    uint32_t Loc_End = logPoll(&shard->primaryLog);
+    uint32_t Loc_Count = 0;
+    uint64_t Loc_LogOffset = 0;
+    uint64_t Loc_Now = retryNow();
+    uint32_t Loc_VelocityNow = (Glb_VelocityFlag == FLAG_UP) ? velocityNow() : 0;
+    uint32_t Loc_Record;
+
+    /* Loop: Until the batch is full, or the next record is not written yet, or can't be applied */
+    while (shard->standbyFailedFlag == FLAG_DOWN && Loc_Count < SERVER_BATCH_TRANSACTIONS && Loc_Next + Loc_Count < Loc_End &&
+           logRead(&shard->primaryLog, Loc_Next + Loc_Count, &Loc_Records[Loc_Count]) == LOG_OK)
+    {
+        /* Check: Account is not in the accounts file of the standby, and can't be added from the primary */
+        if (Loc_Records[Loc_Count].record != LOG_NO_ACCOUNT && Loc_Records[Loc_Count].record >= shard->accountsDatabase.header->count &&
+            (standbyAddAccounts(shard) == FLAG_DOWN || Loc_Records[Loc_Count].record >= shard->accountsDatabase.header->count))
+        {
+            shard->standbyFailedFlag = FLAG_UP;
+        }
+        else
+        {
+            Loc_Count++;
+        }
+    }
+
+    /* Check: Next record can't be read, and is more than a log buffer before the end, so it is not in a group
+              being written, the primary archived and released it, or it is damaged */
+    if (shard->standbyFailedFlag == FLAG_DOWN && Loc_Count < SERVER_BATCH_TRANSACTIONS && Loc_Next + Loc_Count + LOG_BUFFER_RECORDS < Loc_End)
+    {
+        shard->standbyFailedFlag = FLAG_UP;
+    }
+
+    /* Check: Shard is caught up, add the accounts the primary added since */
+    if (shard->standbyFailedFlag == FLAG_DOWN && Loc_Count == 0 && standbyAddAccounts(shard) == FLAG_DOWN)
+    {
+        shard->standbyFailedFlag = FLAG_UP;
+    }
+
+    /* Check: Records can't be made durable in the log of the shard, nothing is applied */
+    if (Loc_Count != 0 && (logAppend(&shard->transactionsLog, Loc_Records, Loc_Count, &Loc_LogOffset) != LOG_OK ||
+                           logCommit(&shard->transactionsLog, Loc_LogOffset) != LOG_OK))
+    {
+        shard->standbyFailedFlag = FLAG_UP;
+        Loc_Count = 0;
+    }
+
+    /* Loop: Until all shipped transactions are applied */
+    for (uint32_t Loc_Index = 0; Loc_Index < Loc_Count; Loc_Index++)
+    {
+        Loc_Record = Loc_Records[Loc_Index].record;
+
+        /* Check: Transaction belongs to an account, hold its lock until its balance is applied */
+        if (Loc_Record != LOG_NO_ACCOUNT)
+        {
+            pthread_mutex_lock(accountLock(shard, Loc_Record));
+            shard->accountsDatabase.balances[Loc_Record] = Loc_Records[Loc_Index].balance;
+        }
+
+        pthread_mutex_lock(&shard->transactionsLock);
+        storeAppend(&shard->transactionsStore, &Loc_Records[Loc_Index].transaction, Loc_Records[Loc_Index].previousSequenceNumber);
+
+        /* Check: Transaction belongs to an account, it is the last transaction of its account */
+        if (Loc_Record != LOG_NO_ACCOUNT)
+        {
+            shard->accountsDatabase.lastSequences[Loc_Record] = Loc_Next + Loc_Index;
+        }
+
+        pthread_mutex_unlock(&shard->transactionsLock);
+
+        /* Check: Transaction belongs to an account */
+        if (Loc_Record != LOG_NO_ACCOUNT)
+        {
+            databaseMarkAccount(&shard->accountsDatabase, Loc_Record);
+
+            /* Check: Transaction is approved, add it to the windows of the account */
+            if (Loc_Records[Loc_Index].transaction.transState == APPROVED)
+            {
+                addVelocity(shard, Loc_Record, &Loc_Records[Loc_Index].transaction.terminalData, Loc_VelocityNow);
+            }
+
+            pthread_mutex_unlock(accountLock(shard, Loc_Record));
+        }
+
+        /* Check: Request is new to the retry cache, record its result */
+        if (retryBegin(&shard->retryCache, &Loc_Records[Loc_Index].transaction, Loc_Now) == RETRY_NEW)
+        {
+            retryEnd(&shard->retryCache, &Loc_Records[Loc_Index].transaction);
+        }
+    }
+
+    requestCheckpoint(shard, Loc_Next + Loc_Count);
+
+    return Loc_Count;
+}
+
+/*
+ Name: standbyThread
+ Input: Pointer to Server Shard
+ Output: NULL
+ Description: Static Function run by the standby thread of a shard. It ships the records of the primary as soon as
+              they are written, and polls the log of the primary every SERVER_STANDBY_POLL_US once it is caught
+              up, until the standby takes over or is closed.
+*/
+static void *standbyThread(void *argument)
+{
+    ST_serverShard_t *Loc_Shard = argument;
+
+    /* Loop: Until the standby threads are stopped */
+    while (__atomic_load_n(&Glb_StandbyRunFlag, __ATOMIC_ACQUIRE) == FLAG_UP)
+    {
+        /* Check: Standby is caught up, or failed */
+        if (standbyShip(Loc_Shard) == 0)
+        {
+            usleep(SERVER_STANDBY_POLL_US);
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ Name: stopStandby
+ Input: uint32_t Number of standby threads started, EN_flagState_t Catch up flag
+ Output: void
+ Description: Static Function to stop the first standby threads, then ship the records left in the logs of the
+              primary if asked to, and close the logs of the primary.
+*/
+static void stopStandby(uint32_t started, EN_flagState_t catchUpFlag)
+{
+    __atomic_store_n(&Glb_StandbyRunFlag, FLAG_DOWN, __ATOMIC_RELEASE);
+
+    /* Loop: Until all started standby threads are stopped */
+    for (uint32_t Loc_Shard = 0; Loc_Shard < started; Loc_Shard++)
+    {
+        pthread_join(Glb_Shards[Loc_Shard].standbyThread, NULL);
+    }
+
+    /* Loop: Until the logs of the primary of all shards are closed */
+    for (uint32_t Loc_Shard = 0; Loc_Shard < Glb_ShardCount; Loc_Shard++)
+    {
+        /* Check: Shard follows the log of the primary */
+        if (Glb_Shards[Loc_Shard].standbyRecords != NULL)
+        {
+            /* Loop: Until no record is left to ship, if asked to catch up */
+            while (catchUpFlag == FLAG_UP && standbyShip(&Glb_Shards[Loc_Shard]) != 0)
+            {
+            }
+
+            logClose(&Glb_Shards[Loc_Shard].primaryLog);
+            free(Glb_Shards[Loc_Shard].standbyRecords);
+            Glb_Shards[Loc_Shard].standbyRecords = NULL;
+        }
+    }
+}
+
+/*
+ Name: initServer
+ Input: void
+ Output: EN_serverError_t Error or No Error
+ Description: 1. This function must be called once before any transaction is processed, it opens the server
+                 unsharded, transactions are authorized on the threads calling the server.
+              2. It maps the accounts database file with its PAN index, creating the file with the default accounts
+                 if it does not exist, and opens the transactions log and archive.
+              3. It replays the log from the last checkpoint of the accounts file into the accounts and the
+                 transactions store, only the log tail since the checkpoint is read.
+              4. It starts the checkpointer thread, which writes the changed accounts pages in the background,
+                 then compresses the log before the checkpoint into the archive, block by block, and releases it
+                 from the log. getTransaction reads archived transactions from their block.
+              5. If the file, the log, the archive or the store can't be opened, the log ends before the checkpoint,
+                 or the checkpointer can't be started, will return INIT_FAILED, else will return SERVER_OK.
+*/
+EN_serverError_t initServer(void)
+{
+    /* Define local variable to set the error state, Init Failed */
+    EN_serverError_t Loc_ErrorState = INIT_FAILED;
+
+    Glb_Shards     = aligned_alloc(SERVER_CACHE_LINE_SIZE, sizeof(ST_serverShard_t));
+    Glb_ShardCount = 1;
+
+    /* Check: Server can be allocated */
+    if (Glb_Shards != NULL)
+    {
+        memset(Glb_Shards, 0, sizeof(ST_serverShard_t));
+
+        Loc_ErrorState = openShard(&Glb_Shards[0], SERVER_ACCOUNTS_FILE, SERVER_LOG_FILE, SERVER_ARCHIVE_FILE, SERVER_FIRST_SEQUENCE_NUMBER, 0xFFFFFFFF);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: initServerShards
+ Input: uint32_t Number of shards
+ Output: EN_serverError_t Error or No Error
+ Description: 1. This function opens the server sharded instead of initServer, the PAN space is split by a hash
+                 of the PAN across shards, each with its own accounts file, log, transactions store and range of
+                 SERVER_SHARD_SEQUENCES sequence numbers, in the files SERVER_SHARD_ACCOUNTS_FILE and
+                 SERVER_SHARD_LOG_FILE and SERVER_SHARD_ARCHIVE_FILE numbered by shard. A directory must always be opened with the same number
+                 of shards.
+              2. Every shard has a worker thread pinned to a core, the only one authorizing the transactions of the
+                 shard. recieveTransactionData and recieveTransactionBatch push the transactions to the lock-free
+                 queues of the workers of their shards and wait on a completion slot, transactions share the log
+                 syncs of their shard.
+              3. The other functions run on the calling thread, on the shard of the PAN, the sequence number or the
+                 record.
+              4. If the number of shards is 0 or above SERVER_MAX_SHARDS, a shard can't be opened or a worker can't
+                 be started, will return INIT_FAILED and leave the server closed, else will return SERVER_OK.
+*/
+EN_serverError_t initServerShards(uint32_t shardCount)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    uint8_t Loc_AccountsFile[64], Loc_LogFile[64], Loc_ArchiveFile[64];
+    uint32_t Loc_Opened = 0, Loc_Started = 0;
+    ST_serverShard_t *Loc_Shard;
+
+    Glb_Shards     = (shardCount == 0 || shardCount > SERVER_MAX_SHARDS) ? NULL :
+                     aligned_alloc(SERVER_CACHE_LINE_SIZE, shardCount * sizeof(ST_serverShard_t));
+    Glb_ShardCount = shardCount;
+
+    /* Check 1: Number of shards is wrong, or no memory for them */
+    if (Glb_Shards == NULL)
+    {
+        /* Update error state, Init Failed! */
+        Loc_ErrorState = INIT_FAILED;
+    }
+    /* Check 2: Open the shards */
+    else
+    {
+        memset(Glb_Shards, 0, shardCount * sizeof(ST_serverShard_t));
+
+        /* Loop: Until all shards are open, or one can't be */
+        while (Loc_Opened < shardCount && Loc_ErrorState == SERVER_OK)
+        {
+            Loc_Shard = &Glb_Shards[Loc_Opened];
+            snprintf(Loc_AccountsFile, sizeof(Loc_AccountsFile), SERVER_SHARD_ACCOUNTS_FILE, Loc_Opened);
+            snprintf(Loc_LogFile, sizeof(Loc_LogFile), SERVER_SHARD_LOG_FILE, Loc_Opened);
+            snprintf(Loc_ArchiveFile, sizeof(Loc_ArchiveFile), SERVER_SHARD_ARCHIVE_FILE, Loc_Opened);
+
+            Loc_Shard->index             = Loc_Opened;
+            Loc_Shard->workerRunFlag     = FLAG_UP;
+            Loc_Shard->batchEntries      = malloc(SERVER_BATCH_TRANSACTIONS * sizeof(ST_queueEntry_t));
+            Loc_Shard->batchTransactions = malloc(SERVER_BATCH_TRANSACTIONS * sizeof(ST_transaction_t));
+            Loc_Shard->batchStates       = malloc(SERVER_BATCH_TRANSACTIONS * sizeof(EN_transState_t));
+            Loc_Shard->batchItems        = malloc(SERVER_BATCH_TRANSACTIONS * sizeof(ST_batchItem_t));
+            Loc_Shard->batchRecords      = malloc(SERVER_BATCH_TRANSACTIONS * sizeof(ST_logRecord_t));
+
+            /* Check 2.1: No memory for the queue or the worker batch, or Shard can't be opened */
+            if (queueInit(&Loc_Shard->queue) != QUEUE_OK || Loc_Shard->batchEntries == NULL ||
+                Loc_Shard->batchTransactions == NULL || Loc_Shard->batchStates == NULL ||
+                Loc_Shard->batchItems == NULL || Loc_Shard->batchRecords == NULL ||
+                openShard(Loc_Shard, Loc_AccountsFile, Loc_LogFile, Loc_ArchiveFile, SERVER_FIRST_SEQUENCE_NUMBER + Loc_Opened * SERVER_SHARD_SEQUENCES,
+                          SERVER_FIRST_SEQUENCE_NUMBER + (Loc_Opened + 1) * SERVER_SHARD_SEQUENCES) != SERVER_OK)
+            {
+                /* Update error state, Init Failed! */
+                Loc_ErrorState = INIT_FAILED;
+            }
+            else
+            {
+                Loc_Opened++;
+            }
+        }
+
+        /* Loop: Until all workers are started, or one can't be */
+        while (Loc_ErrorState == SERVER_OK && Loc_Started < shardCount)
+        {
+            /* Check 2.2: Worker can't be started */
+            if (pthread_create(&Glb_Shards[Loc_Started].workerThread, NULL, shardWorker, &Glb_Shards[Loc_Started]) != 0)
+            {
+                /* Update error state, Init Failed! */
+                Loc_ErrorState = INIT_FAILED;
+            }
+            else
+            {
+                Loc_Started++;
+            }
+        }
+
+        /* Check 2.3: Server can't be opened, close what was opened */
+        if (Loc_ErrorState == INIT_FAILED)
+        {
+            stopWorkers(Loc_Started);
+
+            /* Loop: Until all opened shards are closed */
+            for (uint32_t Loc_Index = 0; Loc_Index < Loc_Opened; Loc_Index++)
+            {
+                closeShard(&Glb_Shards[Loc_Index]);
+            }
+
+            free(Glb_Shards);
+            Glb_Shards = NULL;
+        }
+        else
+        {
+            Glb_WorkersFlag = FLAG_UP;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: initServerPipeline
+ Input: void
+ Output: EN_serverError_t Error or No Error
+ Description: 1. This function opens the server unsharded like initServer, with the same files, and authorizes the
+                 transactions in a pipeline of four stages, each on its own thread: PAN lookup, state and balance
+                 checks, log persistence and balance apply. Up to SERVER_PIPELINE_DEPTH batches are in flight, one
+                 batch is checked while the batch before it waits on its log sync.
+              2. recieveTransactionData and recieveTransactionBatch push the transactions to the lock-free queue
+                 of the lookup stage and wait on a completion slot. Once all batches are in flight the lookup stage
+                 waits for a free batch and the queue fills, callers wait for room in it.
+              3. A balance is only applied once its transaction is durable in the log. The checks of an account
+                 with transactions in flight start from its projected balance, so the results are the same as
+                 authorizing the batches one after the other, and the checkpoint is cut after the last applied
+                 transaction.
+              4. If the server can't be opened, or memory for the batches can't be allocated or a stage can't be
+                 started, will return INIT_FAILED and leave the server closed, else will return SERVER_OK.
+*/
+EN_serverError_t initServerPipeline(void)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = initServer();
+    ST_serverShard_t *Loc_Shard = Glb_Shards;
+    ST_pipelineBatch_t *Loc_Batch;
+    uint32_t Loc_Capacity, Loc_Started = 0;
+    /* Define local variable to get the function of every stage */
+    void *(*Loc_Stages[PIPELINE_STAGES])(void *) = {pipelineLookup, pipelineCheck, pipelinePersist, pipelineApply};
+
+    /* Check 1: Server is open */
+    if (Loc_ErrorState == SERVER_OK)
+    {
+        Loc_Capacity = Loc_Shard->accountsDatabase.header->capacity;
+
+        Loc_Shard->workerRunFlag         = FLAG_UP;
+        Loc_Shard->appliedSequenceNumber = Loc_Shard->transactionsStore.nextSequenceNumber;
+        Loc_Shard->pipelineFlag          = FLAG_UP;
+        Loc_Shard->pipelineBalances      = malloc(Loc_Capacity * sizeof(sint64_t));
+        Loc_Shard->pipelineCounts        = calloc(Loc_Capacity, sizeof(uint32_t));
+        Glb_PipelineFailedFlag           = FLAG_DOWN;
+        Glb_PipelineChecked              = 0;
+        Glb_PipelineApplied              = 0;
+
+        /* Loop: Until all rings are initialized */
+        for (uint32_t Loc_Stage = 0; Loc_Stage < PIPELINE_STAGES; Loc_Stage++)
+        {
+            Glb_PipelineRings[Loc_Stage].head  = 0;
+            Glb_PipelineRings[Loc_Stage].count = 0;
+            pthread_mutex_init(&Glb_PipelineRings[Loc_Stage].lock, NULL);
+            pthread_cond_init(&Glb_PipelineRings[Loc_Stage].condition, NULL);
+        }
+
+        /* Check 1.1: No memory for the queue or the projected balances */
+        if (queueInit(&Loc_Shard->queue) != QUEUE_OK || Loc_Shard->pipelineBalances == NULL || Loc_Shard->pipelineCounts == NULL)
+        {
+            /* Update error state, Init Failed! */
+            Loc_ErrorState = INIT_FAILED;
+        }
+
+        /* Loop: Until all batches are allocated and free */
+        for (uint32_t Loc_Index = 0; Loc_Index < SERVER_PIPELINE_DEPTH; Loc_Index++)
+        {
+            Loc_Batch               = &Glb_PipelineBatches[Loc_Index];
+            Loc_Batch->entries      = malloc(SERVER_BATCH_TRANSACTIONS * sizeof(ST_queueEntry_t));
+            Loc_Batch->transactions = malloc(SERVER_BATCH_TRANSACTIONS * sizeof(ST_transaction_t));
+            Loc_Batch->states       = malloc(SERVER_BATCH_TRANSACTIONS * sizeof(EN_transState_t));
+            Loc_Batch->items        = malloc(SERVER_BATCH_TRANSACTIONS * sizeof(ST_batchItem_t));
+            Loc_Batch->records      = malloc(SERVER_BATCH_TRANSACTIONS * sizeof(ST_logRecord_t));
+
+            /* Check 1.2: No memory for the batch */
+            if (Loc_Batch->entries == NULL || Loc_Batch->transactions == NULL || Loc_Batch->states == NULL ||
+                Loc_Batch->items == NULL || Loc_Batch->records == NULL)
+            {
+                /* Update error state, Init Failed! */
+                Loc_ErrorState = INIT_FAILED;
+            }
+
+            pipelinePut(&Glb_PipelineRings[PIPELINE_LOOKUP], Loc_Batch);
+        }
+
+        /* Loop: Until all stages are started from the apply stage back, or one can't be */
+        while (Loc_ErrorState == SERVER_OK && Loc_Started < PIPELINE_STAGES)
+        {
+            /* Check 1.3: Stage can't be started */
+            if (pthread_create(&Glb_PipelineThreads[PIPELINE_STAGES - 1 - Loc_Started], NULL,
+                               Loc_Stages[PIPELINE_STAGES - 1 - Loc_Started], Loc_Shard) != 0)
+            {
+                /* Update error state, Init Failed! */
+                Loc_ErrorState = INIT_FAILED;
+            }
+            else
+            {
+                Loc_Started++;
+            }
+        }
+
+        /* Check 1.4: Pipeline can't be started, close the server */
+        if (Loc_ErrorState == INIT_FAILED)
+        {
+            stopPipeline(Loc_Started);
+            closeServer();
+        }
+        else
+        {
+            Glb_PipelineFlag = FLAG_UP;
+            Glb_WorkersFlag  = FLAG_UP;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: initServerStandby
+ Input: Pointer to directory of the primary server, uint32_t Number of shards, 0 for an unsharded primary
+ Output: EN_serverError_t Error or No Error
+ Description: 1. This function opens the server in the working directory as a hot standby of a primary server
+                 running in another directory of the same machine, unsharded, or sharded with the same number of
+                 shards.
+              2. If the working directory has no accounts file yet, it first makes a base copy of the accounts
+                 file, the log and the archive of every shard of the primary while the primary runs, then it opens
+                 the server on its own files as initServer or initServerShards do, recovery replays the copied log.
+              3. A standby thread per shard follows the log file of the primary, the records are found as soon as
+                 the primary writes them, synced into the log of the standby at the same sequence numbers and
+                 applied to its accounts and transactions store, the standby checkpoints and archives its own log.
+              4. The standby answers every reading function, it refuses transactions, saved transactions and new
+                 accounts until takeOverServer. getStandbyLag gives the records of the primary not shipped yet.
+              5. Accounts added to the primary are not in its log, a shard reads them from the accounts file of the
+                 primary once it is caught up, or before a record on one of them. A standby stopped while the
+                 primary goes on must be restarted before the primary archives the records it missed.
+              6. If a base copy can't be made, the server can't be opened, or a log of the primary can't be
+                 followed or is not the log of the same shard, will return INIT_FAILED and leave the server
+                 closed, else will return SERVER_OK.
+*/
+EN_serverError_t initServerStandby(uint8_t *primaryDirectory, uint32_t shardCount)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = (shardCount > SERVER_MAX_SHARDS) ? INIT_FAILED : SERVER_OK;
+    uint8_t Loc_AccountsFile[64], Loc_LogFile[64], Loc_ArchiveFile[64];
+    uint8_t Loc_PrimaryLog[SERVER_STANDBY_PATH_SIZE];
+    uint32_t Loc_Copied = 0, Loc_Started = 0;
+    ST_serverShard_t *Loc_Shard;
+
+    /* Loop: Until the base copies of all shards are made, or one can't be */
+    while (Loc_ErrorState == SERVER_OK && Loc_Copied < ((shardCount == 0) ? 1 : shardCount))
+    {
+        snprintf(Loc_AccountsFile, sizeof(Loc_AccountsFile), (shardCount == 0) ? SERVER_ACCOUNTS_FILE : SERVER_SHARD_ACCOUNTS_FILE, Loc_Copied);
+        snprintf(Loc_LogFile, sizeof(Loc_LogFile), (shardCount == 0) ? SERVER_LOG_FILE : SERVER_SHARD_LOG_FILE, Loc_Copied);
+        snprintf(Loc_ArchiveFile, sizeof(Loc_ArchiveFile), (shardCount == 0) ? SERVER_ARCHIVE_FILE : SERVER_SHARD_ARCHIVE_FILE, Loc_Copied);
+
+        Loc_ErrorState = standbyCopyShard(primaryDirectory, Loc_AccountsFile, Loc_LogFile, Loc_ArchiveFile);
+        Loc_Copied++;
+    }
+
+    /* Check 1: Base copies are made, open the server on them */
+    if (Loc_ErrorState == SERVER_OK)
+    {
+        Loc_ErrorState = (shardCount == 0) ? initServer() : initServerShards(shardCount);
+    }
+
+    /* Check 2: Server is open, follow the logs of the primary */
+    if (Loc_ErrorState == SERVER_OK)
+    {
+        Glb_StandbyFlag    = FLAG_UP;
+        Glb_StandbyRunFlag = FLAG_UP;
+
+        /* Loop: Until all shards follow the log of the primary with their standby thread, or one can't */
+        while (Loc_ErrorState == SERVER_OK && Loc_Started < Glb_ShardCount)
+        {
+            Loc_Shard = &Glb_Shards[Loc_Started];
+            snprintf(Loc_LogFile, sizeof(Loc_LogFile), (shardCount == 0) ? SERVER_LOG_FILE : SERVER_SHARD_LOG_FILE, Loc_Started);
+            snprintf(Loc_PrimaryLog, sizeof(Loc_PrimaryLog), "%s/%s", primaryDirectory, Loc_LogFile);
+            snprintf(Loc_AccountsFile, sizeof(Loc_AccountsFile), (shardCount == 0) ? SERVER_ACCOUNTS_FILE : SERVER_SHARD_ACCOUNTS_FILE, Loc_Started);
+            snprintf(Loc_Shard->primaryAccountsFile, sizeof(Loc_Shard->primaryAccountsFile), "%s/%s", primaryDirectory, Loc_AccountsFile);
+
+            Loc_Shard->standbyFailedFlag = FLAG_DOWN;
+            Loc_Shard->standbyRecords    = malloc(SERVER_BATCH_TRANSACTIONS * sizeof(ST_logRecord_t));
+
+            /* Check 2.1: No memory for the records, or Log of the primary can't be followed */
+            if (Loc_Shard->standbyRecords == NULL || logFollow(&Loc_Shard->primaryLog, Loc_PrimaryLog) != LOG_OK)
+            {
+                free(Loc_Shard->standbyRecords);
+                Loc_Shard->standbyRecords = NULL;
+
+                /* Update error state, Init Failed! */
+                Loc_ErrorState = INIT_FAILED;
+            }
+            /* Check 2.2: Log of the primary is of another shard, or behind the standby, or Standby thread can't
+                          be started */
+            else if (Loc_Shard->primaryLog.firstSequenceNumber != Loc_Shard->transactionsLog.firstSequenceNumber ||
+                     Loc_Shard->primaryLog.nextSequenceNumber < Loc_Shard->transactionsLog.nextSequenceNumber ||
+                     pthread_create(&Loc_Shard->standbyThread, NULL, standbyThread, Loc_Shard) != 0)
+            {
+                /* Update error state, Init Failed! */
+                Loc_ErrorState = INIT_FAILED;
+            }
+            else
+            {
+                Loc_Started++;
+            }
+        }
+
+        /* Check 2.3: Standby can't be started, close the server */
+        if (Loc_ErrorState == INIT_FAILED)
+        {
+            stopStandby(Loc_Started, FLAG_DOWN);
+            Glb_StandbyFlag = FLAG_DOWN;
+            closeServer();
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: getStandbyLag
+ Input: Pointer to uint64_t Bytes, Pointer to uint32_t Number of transactions
+ Output: EN_serverError_t Error or No Error
+ Description: 1. This function gives the replication lag of a standby, the transactions written to the logs of the
+                 primary and not shipped to the standby yet, and the bytes of the logs of the primary from the
+                 first record not shipped to the end of the file, a record being written included, of all shards.
+              2. A server which is not a standby has no lag.
+              3. If a shard of the standby stopped shipping will return SAVING_FAILED, else return SERVER_OK.
+*/
+EN_serverError_t getStandbyLag(uint64_t *bytes, uint32_t *transactions)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    uint32_t Loc_Shipped;
+    ST_log_t *Loc_PrimaryLog;
+
+    *transactions = 0;
+    *bytes        = 0;
+
+    /* Check: Server is a standby */
+    if (__atomic_load_n(&Glb_StandbyFlag, __ATOMIC_ACQUIRE) == FLAG_UP)
+    {
+        /* Loop: Until the lag of all shards is added */
+        for (uint32_t Loc_Shard = 0; Loc_Shard < Glb_ShardCount; Loc_Shard++)
+        {
+            /* Shipped first, the log of the primary is never behind it */
+            Loc_PrimaryLog = &Glb_Shards[Loc_Shard].primaryLog;
+            Loc_Shipped    = __atomic_load_n(&Glb_Shards[Loc_Shard].transactionsLog.nextSequenceNumber, __ATOMIC_ACQUIRE);
+            *transactions += logPoll(Loc_PrimaryLog) - Loc_Shipped;
+            *bytes        += __atomic_load_n(&Loc_PrimaryLog->polledSize, __ATOMIC_RELAXED) - logOffset(Loc_PrimaryLog, Loc_Shipped);
+
+            /* Check: Shard stopped shipping */
+            if (__atomic_load_n(&Glb_Shards[Loc_Shard].standbyFailedFlag, __ATOMIC_RELAXED) == FLAG_UP)
+            {
+                /* Update error state, Saving Failed! */
+                Loc_ErrorState = SAVING_FAILED;
+            }
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: takeOverServer
+ Input: void
+ Output: EN_serverError_t Error or No Error
+ Description: 1. This function turns a standby into the primary once the primary is stopped. The standby threads
+                 are stopped, the records the primary wrote and the standby did not ship yet are shipped, then the
+                 logs of the primary are closed and the server authorizes transactions from the next sequence
+                 number of every shard. The catch-up only ships the lag, it is as short as the lag.
+              2. It does nothing on a server which is not a standby.
+              3. If a shard stopped shipping before the end of the log of the primary will return SAVING_FAILED,
+                 the server takes over anyway, else return SERVER_OK.
+*/
+EN_serverError_t takeOverServer(void)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+
+    /* Check: Server is a standby */
+    if (Glb_StandbyFlag == FLAG_UP)
+    {
+        stopStandby(Glb_ShardCount, FLAG_UP);
+
+        /* Loop: Until all shards are checked */
+        for (uint32_t Loc_Shard = 0; Loc_Shard < Glb_ShardCount; Loc_Shard++)
+        {
+            /* Check: Shard stopped shipping */
+            if (Glb_Shards[Loc_Shard].standbyFailedFlag == FLAG_UP)
+            {
+                /* Update error state, Saving Failed! */
+                Loc_ErrorState = SAVING_FAILED;
+            }
+        }
+
+        __atomic_store_n(&Glb_StandbyFlag, FLAG_DOWN, __ATOMIC_RELEASE);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: closeServer
+ Input: void
+ Output: void
+ Description: This function stops the standby threads, the pipeline or the shard workers, if any, and the checkpointers, checkpoints
+              the accounts databases and releases the server databases and the logs. No transaction may be in
+              progress.
+*/
+void closeServer(void)
+{
+    /* Check 1: Server is a standby */
+    if (Glb_StandbyFlag == FLAG_UP)
+    {
+        stopStandby(Glb_ShardCount, FLAG_DOWN);
+        Glb_StandbyFlag = FLAG_DOWN;
+    }
+
+    /* Check 2: Server is pipelined */
+    if (Glb_PipelineFlag == FLAG_UP)
+    {
+        stopPipeline(PIPELINE_STAGES);
+        Glb_PipelineFlag = FLAG_DOWN;
+        Glb_WorkersFlag  = FLAG_DOWN;
+    }
+    /* Check 3: Server is sharded */
+    else if (Glb_WorkersFlag == FLAG_UP)
+    {
+        stopWorkers(Glb_ShardCount);
+        Glb_WorkersFlag = FLAG_DOWN;
+    }
+
+    /* Loop: Until all shards are closed */
+    for (uint32_t Loc_Shard = 0; Loc_Shard < Glb_ShardCount; Loc_Shard++)
+    {
+        closeShard(&Glb_Shards[Loc_Shard]);
+    }
+
+    free(Glb_Shards);
+    Glb_Shards = NULL;
+}
+
+/* 
+ Name: recieveTransactionData
+ Input: Pointer to Transaction structure
+ Output: EN_transState_t Transaction State
+ Description: 1. This function will take all transaction data and validate its data.
+              2. It checks the account details and amount availability.
+              3. If the account does not exist return FRAUD_CARD, if the amount is not available will return DECLINED_INSUFFECIENT_FUND, 
+                 if the account is blocked will return DECLINED_STOLEN_CARD, if a transaction can't be saved will 
+                 return INTERNAL_SERVER_ERROR and will not save the transaction, else returns APPROVED.
+              4. It will update the database with the new balance, only after the transaction is durable in the log.
+              5. It is thread safe, the account is locked from the checks until the new balance is applied, so
+                 transactions on different accounts run in parallel and share log syncs.
+              6. In a sharded server the transaction is pushed to the queue of the worker of the shard of its PAN
+                 and authorized with the other transactions queued to the shard, in a pipelined server to the
+                 queue of the lookup stage.
+              7. A transaction with a request id is idempotent, a retry from the same terminal with the same
+                 request id within RETRY_EXPIRY_MS gets the state and sequence number of the first submission and
+                 the account is not debited again. A request that ended with INTERNAL_SERVER_ERROR is authorized
+                 again. The retry cache has a fixed size, it is kept in memory and not across restarts.
+              8. A standby refuses transactions with INTERNAL_SERVER_ERROR until it takes over.
+              9. While velocity limits are set, a transaction that would be approved but takes the approved
+                 transactions or amount of its account in the last minute, hour or day over a limit will return
+                 DECLINED_VELOCITY_LIMIT and is saved as declined. Every account counts its approvals in a fixed
+                 ring of buckets per window, so the check costs the same whatever the history of the account. The
+                 windows are kept in memory and not across restarts.
+*/
+EN_transState_t recieveTransactionData(ST_transaction_t *transData)
+{
+    /* Declare local variable to get the transaction state */
+    EN_transState_t Loc_TransState;
+    /* Define local variables to queue the transaction to the worker of its shard */
+    ST_serverShard_t *Loc_Shard = panShard(transData->cardHolderData.primaryAccountNumber);
+    ST_queueCompletion_t Loc_Completion;
+
+    /* Check 1: Server is a standby, it refuses transactions */
+    if (__atomic_load_n(&Glb_StandbyFlag, __ATOMIC_ACQUIRE) == FLAG_UP)
+    {
+        transData->transState = INTERNAL_SERVER_ERROR;
+        Loc_TransState        = INTERNAL_SERVER_ERROR;
+    }
+    /* Check 2: Transaction is authorized by the worker of its shard */
+    else if (Glb_WorkersFlag == FLAG_UP)
+    {
+        queueStartCompletion(&Loc_Completion, 1);
+        shardSubmit(Loc_Shard, transData, &Loc_TransState, &Loc_Completion);
+        queueWaitCompletion(&Loc_Completion);
+    }
+    /* Check 3: Transaction is authorized on the calling thread */
+    else
+    {
+        Loc_TransState = recieveRetriedTransaction(Loc_Shard, transData);
+    }
+
+    return Loc_TransState;
+}
+
+/*
+ Name: recieveTransactionBatch
+ Input: Pointer to Transactions, uint32_t Number of transactions, Pointer to Transaction States
+ Output: void
+ Description: 1. This function authorizes a batch of transactions, with the same checks and results as calling
+                 recieveTransactionData on each of them in order, and returns the state of every transaction.
+              2. Transactions of the same account are checked in batch order against a running balance.
+              3. Every SERVER_BATCH_TRANSACTIONS transactions are saved with one log append and one log sync,
+                 transactions are given their sequence numbers grouped by account, not in batch order.
+              4. In a sharded server the batch is split by shard and the workers authorize their parts at once, in a
+                 pipelined server the batch goes through the stages with the other transactions queued.
+              5. If memory for the batch can't be allocated, or the server is a standby, every transaction is
+                 INTERNAL_SERVER_ERROR.
+*/
+void recieveTransactionBatch(ST_transaction_t *transData, uint32_t count, EN_transState_t *transStates)
+{
+    uint32_t Loc_ChunkSize = (count < SERVER_BATCH_TRANSACTIONS) ? count : SERVER_BATCH_TRANSACTIONS;
+    ST_batchItem_t *Loc_Items;
+    ST_logRecord_t *Loc_Records;
+
+    /* Check 1: Server is a standby, it refuses transactions */
+    if (__atomic_load_n(&Glb_StandbyFlag, __ATOMIC_ACQUIRE) == FLAG_UP)
+    {
+        failTransactions(transData, count, transStates);
+    }
+    /* Check 2: Transactions are authorized by the workers of their shards */
+    else if (Glb_WorkersFlag == FLAG_UP)
+    {
+        shardBatch(transData, count, transStates);
+    }
+    /* Check 3: Transactions are authorized on the calling thread */
+    else
+    {
+        Loc_Items   = malloc(Loc_ChunkSize * sizeof(ST_batchItem_t));
+        Loc_Records = malloc(Loc_ChunkSize * sizeof(ST_logRecord_t));
+
+        /* Check 3.1: No memory for the batch */
+        if (Loc_Items == NULL || Loc_Records == NULL)
+        {
+            failTransactions(transData, count, transStates);
+        }
+        /* Check 3.2: Authorize chunk by chunk */
+        else
+        {
+            /* Loop: Until all chunks are authorized */
+            for (uint32_t Loc_Index = 0; Loc_Index < count; Loc_Index += Loc_ChunkSize)
+            {
+                recieveTransactionChunk(&Glb_Shards[0], &transData[Loc_Index], (count - Loc_Index < Loc_ChunkSize) ? count - Loc_Index : Loc_ChunkSize,
+                                        &transStates[Loc_Index], Loc_Items, Loc_Records);
+            }
+        }
+
+        free(Loc_Items);
+        free(Loc_Records);
+    }
+}
+
+/*
+ Name: isValidAccount
+ Input: Pointer to Card Data structure, 
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function will take card data and validate if the account related to this card exists or not.
+              2. It checks if the PAN exists or not in the server's database (looks up the packed card PAN in the PAN index).
+              3. If the PAN doesn't exist will return ACCOUNT_NOT_FOUND, else will return SERVER_OK and return a reference 
+                 to this account in the DB.
+*/
+EN_serverError_t isValidAccount(ST_cardData_t *cardData, ST_accountsDB_t *accountRefrence)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    /* Define local variable to get the record of the account in the accounts database */
+    uint32_t Loc_Record;
+    ST_serverShard_t *Loc_Shard = panShard(cardData->primaryAccountNumber);
+
+    /* Check 1: Account is not found */
+    if (findAccount(Loc_Shard, cardData->primaryAccountNumber, &Loc_Record) == ACCOUNT_NOT_FOUND)
+    {
+        /* Update error state, Account Not Found! */
+        Loc_ErrorState = ACCOUNT_NOT_FOUND;
+    }
+    /* Check 2: Account is found */
+    else
+    {
+        /* Copy Account details from the accounts database to passed pointer */
+        pthread_mutex_lock(accountLock(Loc_Shard, Loc_Record));
+        databaseGetAccount(&Loc_Shard->accountsDatabase, Loc_Record, accountRefrence);
+        pthread_mutex_unlock(accountLock(Loc_Shard, Loc_Record));
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: isBlockedAccount
+ Input: 
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function will take a reference to an existing account in the database.
+              2. It checks if the account is blocked or not.
+              3. If the account is blocked, will return BLOCKED_ACCOUNT, else will return SERVER_OK.
+*/
+EN_serverError_t isBlockedAccount(ST_accountsDB_t *accountRefrence)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+
+    /* Check: Account is Blocked */
+    if (accountRefrence->state == BLOCKED)
+    {
+        /* Update error state, Blocked Account! */
+        Loc_ErrorState = BLOCKED_ACCOUNT;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: isAmountAvailable
+ Input: Pointer to Terminal Data structure
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function will take terminal data and validate these data.
+              2. It checks if the transaction's amount is available or not.
+              3. Amounts and balances are in cents, so the compare is exact.
+              4. If the transaction amount is greater than the balance in the database will return LOW_BALANCE, 
+                 else will return SERVER_OK
+*/
+EN_serverError_t isAmountAvailable(ST_terminalData_t *termData, ST_accountsDB_t *accountRefrence)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    
+    /* Check: Transaction Amount > Account Balance */
+    if (termData->transAmount > accountRefrence->balance)
+    {
+        /* Update error state, Low Balance! */
+        Loc_ErrorState =  LOW_BALANCE; 
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: saveTransaction
+ Input: Pointer to Transaction structure
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function will store all transaction data in the transactions database.
+              2. It gives a sequence number to a transaction, this number is incremented once a transaction 
+                 is processed into the server, you must check the last sequence number in the server to give 
+                 the new transaction a new sequence number.
+              3. It saves any type of transactions, APPROVED or DECLINED, with the specific reason for declining/transaction state.
+              4. If the transaction can't be saved, for any reason (ex: dropped connection) will return SAVING_FAILED, 
+                 else will return SERVER_OK, you can simulate this by commenting on the lines where your 
+                 code writes the transaction data in the database.
+              5. It checks if the transaction is saved or not using the getTransaction function, which reads back
+                 only the entry just written.
+              6. The transaction is written to the transactions log with the account balance after it, and the
+                 function returns only once the log is synced, so a saved transaction survives a crash.
+              7. A standby refuses saved transactions with SAVING_FAILED until it takes over.
+*/
+EN_serverError_t saveTransaction(ST_transaction_t *transData)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    /* Define local variable to get the record of the account in the accounts database */
+    uint32_t Loc_Record;
+    sint64_t Loc_Balance;
+    ST_serverShard_t *Loc_Shard = panShard(transData->cardHolderData.primaryAccountNumber);
+
+    /* Check 1: Server is a standby, it refuses saved transactions */
+    if (__atomic_load_n(&Glb_StandbyFlag, __ATOMIC_ACQUIRE) == FLAG_UP)
+    {
+        /* Update error state, Saving Failed! */
+        Loc_ErrorState = SAVING_FAILED;
+    }
+    /* Check 2: Transaction belongs to an account, log the balance after the transaction */
+    else if (findAccount(Loc_Shard, transData->cardHolderData.primaryAccountNumber, &Loc_Record) == SERVER_OK)
+    {
+        pthread_mutex_lock(accountLock(Loc_Shard, Loc_Record));
+
+        Loc_Balance = Loc_Shard->accountsDatabase.balances[Loc_Record];
+
+        /* Check 2.1: Transaction is approved */
+        if (transData->transState == APPROVED)
+        {
+            Loc_Balance -= transData->terminalData.transAmount;
+        }
+
+        Loc_ErrorState = logTransaction(Loc_Shard, transData, Loc_Record, Loc_Balance);
+
+        pthread_mutex_unlock(accountLock(Loc_Shard, Loc_Record));
+    }
+    /* Check 3: Transaction does not belong to an account */
+    else
+    {
+        Loc_ErrorState = logTransaction(Loc_Shard, transData, LOG_NO_ACCOUNT, 0);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: getTransaction
+ Input: uint32_t Transaction Number, Pointer to Transaction structure
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function takes the sequence number of a transaction and returns the transaction data 
+                 if found in the transactions DB.
+              2. Sequence numbers are dense, so the segment of a transaction in the transactions store and its
+                 position inside the segment are computed from its sequence number.
+              3. Transactions no longer in the store are read back from the transactions archive, one block of it,
+                 or from the transactions log if they are not archived yet.
+              4. In a sharded server the sequence number also gives the shard, every shard has its own range.
+              5. If the sequence number is not found, then the transaction is not found, 
+                 the function will return TRANSACTION_NOT_FOUND, else return transaction data as well as SERVER_OK
+*/
+EN_serverError_t getTransaction(uint32_t transactionSequenceNumber, ST_transaction_t *transData)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    ST_serverShard_t *Loc_Shard = sequenceShard(transactionSequenceNumber);
+
+    /* Check 1: Sequence number is in no shard range */
+    if (Loc_Shard == NULL)
+    {
+        /* Update error state, Transaction Not Found! */
+        Loc_ErrorState = TRANSACTION_NOT_FOUND;
+    }
+    /* Check 2: Get the transaction from its shard */
+    else
+    {
+        Loc_ErrorState = getShardTransaction(Loc_Shard, transactionSequenceNumber, transData);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: getAccountTransactions
+ Input: Pointer to Card Data structure, Pointer to Transactions, uint32_t Maximum number of transactions,
+        Pointer to uint32_t Number of transactions
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function returns the last transactions of the account of a card, newest first, at most
+                 maxCount of them.
+              2. Every transaction of an account links to the previous one of the same account, the list starts at
+                 the last transaction of the account and follows the links, so it costs one lookup per transaction
+                 returned whatever the number of transactions of other accounts.
+              3. If the PAN doesn't exist will return ACCOUNT_NOT_FOUND, else will return SERVER_OK and the number of
+                 transactions returned.
+*/
+EN_serverError_t getAccountTransactions(ST_cardData_t *cardData, ST_transaction_t *transData, uint32_t maxCount, uint32_t *count)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    /* Define local variable to get the record of the account in the accounts database */
+    uint32_t Loc_Record;
+    uint32_t Loc_Sequence = 0;
+    ST_serverShard_t *Loc_Shard = panShard(cardData->primaryAccountNumber);
+
+    *count = 0;
+
+    /* Check 1: Account is not found */
+    if (findAccount(Loc_Shard, cardData->primaryAccountNumber, &Loc_Record) == ACCOUNT_NOT_FOUND)
+    {
+        /* Update error state, Account Not Found! */
+        Loc_ErrorState = ACCOUNT_NOT_FOUND;
+    }
+    /* Check 2: Account is found, start at its last transaction */
+    else
+    {
+        pthread_mutex_lock(&Loc_Shard->transactionsLock);
+        Loc_Sequence = Loc_Shard->accountsDatabase.lastSequences[Loc_Record];
+        pthread_mutex_unlock(&Loc_Shard->transactionsLock);
+    }
+
+    /* Loop: Until enough transactions, or the first transaction of the account, links never change once written */
+    while (*count < maxCount && Loc_Sequence != 0 &&
+           getChainedTransaction(Loc_Shard, Loc_Sequence, &transData[*count], &Loc_Sequence) == SERVER_OK)
+    {
+        (*count)++;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: getTransactionsByDate
+ Input: Pointer to first date string, Pointer to last date string, uint32_t States wanted, Pointer to Transactions,
+        uint32_t Maximum number of transactions, Pointer to uint32_t Number of transactions
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function returns the transactions from the first date to the last date, both DD/MM/YYYY and
+                 included, whose state is wanted, oldest first, at most maxCount of them.
+              2. States are wanted by setting their STORE_STATE_BIT in transStates, e.g.
+                 STORE_STATE_BIT(DECLINED_INSUFFECIENT_FUND) | STORE_STATE_BIT(DECLINED_STOLEN_CARD).
+              3. The transactions store keeps a zone map per block of transactions, blocks outside the dates or
+                 without a wanted state are skipped, the others are filtered on their packed date column.
+              4. A sharded server returns the transactions shard by shard, oldest first in every shard.
+              5. If a date is wrong will return TRANSACTION_NOT_FOUND, else return SERVER_OK and the number of
+                 transactions returned.
+*/
+EN_serverError_t getTransactionsByDate(uint8_t *fromDate, uint8_t *toDate, uint32_t transStates, ST_transaction_t *transData,
+                                       uint32_t maxCount, uint32_t *count)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    uint32_t Loc_FromDay, Loc_ToDay;
+
+    *count = 0;
+
+    /* Check 1: Dates are wrong */
+    if (packTransactionDate(fromDate, &Loc_FromDay) == WRONG_DATE || packTransactionDate(toDate, &Loc_ToDay) == WRONG_DATE)
+    {
+        /* Update error state, Transaction Not Found! */
+        Loc_ErrorState = TRANSACTION_NOT_FOUND;
+    }
+    /* Check 2: Dates are valid */
+    else
+    {
+        /* Loop: Until all shards are searched */
+        for (uint32_t Loc_Shard = 0; Loc_Shard < Glb_ShardCount; Loc_Shard++)
+        {
+            pthread_mutex_lock(&Glb_Shards[Loc_Shard].transactionsLock);
+            *count += storeFindByDate(&Glb_Shards[Loc_Shard].transactionsStore, Loc_FromDay, Loc_ToDay, transStates,
+                                      &transData[*count], maxCount - *count);
+            pthread_mutex_unlock(&Glb_Shards[Loc_Shard].transactionsLock);
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: getAccount
+ Input: uint32_t Account record, Pointer to Account
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function returns the account stored at a record number of the accounts database,
+                 records are numbered from 0 in the order accounts were added.
+              2. In a sharded server record r is the record r / shards of the shard r % shards.
+              3. If there is no account at the record will return ACCOUNT_NOT_FOUND, else return SERVER_OK.
+*/
+EN_serverError_t getAccount(uint32_t record, ST_accountsDB_t *accountRefrence)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_serverError_t Loc_ErrorState = SERVER_OK;
+    ST_serverShard_t *Loc_Shard = &Glb_Shards[record % Glb_ShardCount];
+    uint32_t Loc_Record = record / Glb_ShardCount;
+
+    /* Check 1: Record is not used */
+    if (Loc_Record >= Loc_Shard->accountsDatabase.header->count)
+    {
+        /* Update error state, Account Not Found! */
+        Loc_ErrorState = ACCOUNT_NOT_FOUND;
+    }
+    /* Check 2: Record is used */
+    else
+    {
+        pthread_mutex_lock(accountLock(Loc_Shard, Loc_Record));
+        databaseGetAccount(&Loc_Shard->accountsDatabase, Loc_Record, accountRefrence);
+        pthread_mutex_unlock(accountLock(Loc_Shard, Loc_Record));
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: addAccounts
+ Input: Pointer to Accounts, uint32_t Number of accounts, Pointer to uint32_t Number of accounts added
+ Output: EN_sreverError_t Error or No Error
+ Description: 1. This function adds new accounts to the accounts database, an account whose PAN already has an
+                 account is skipped.
+              2. The accounts file is written before the function returns, so transactions logged on the new
+                 accounts are always recovered on accounts that exist.
+              3. Accounts are added while no transaction is in progress, lookups read the PAN index without locks.
+              4. If a PAN is not all digits, all records are used or the file can't be written will return
+                 SAVING_FAILED, else return SERVER_OK, accounts before the failing one are added. A standby adds
+                 no account and returns SAVING_FAILED.
+*/
+EN_serverError_t addAccounts(ST_accountsDB_t *accountRefrence, uint32_t count, uint32_t *added)
+{
+    /* Define local variable to set the error state, Saving Failed on a standby, else No Error */
+    EN_serverError_t Loc_ErrorState = (__atomic_load_n(&Glb_StandbyFlag, __ATOMIC_ACQUIRE) == FLAG_UP) ? SAVING_FAILED : SERVER_OK;
+    EN_databaseError_t Loc_DatabaseError;
+    uint32_t Loc_Record;
+    ST_serverShard_t *Loc_Shard;
+    /* Define local variable to set the shards whose accounts file changed */
+    EN_flagState_t Loc_AddedFlags[SERVER_MAX_SHARDS] = {FLAG_DOWN};
+
+    *added = 0;
+
+    /* Loop: Until all accounts are added to their shards, or one can't be */
+    for (uint32_t Loc_Index = 0; Loc_Index < count && Loc_ErrorState == SERVER_OK; Loc_Index++)
+    {
+        Loc_Shard         = panShard(accountRefrence[Loc_Index].primaryAccountNumber);
+        Loc_DatabaseError = databaseAddAccount(&Loc_Shard->accountsDatabase, &accountRefrence[Loc_Index], &Loc_Record);
+
+        /* Check 1: Account is added */
+        if (Loc_DatabaseError == DATABASE_OK)
+        {
+            Loc_AddedFlags[Loc_Shard - Glb_Shards] = FLAG_UP;
+            (*added)++;
+        }
+        /* Check 2: Account can't be added, and doesn't exist already */
+        else if (Loc_DatabaseError != DATABASE_DUPLICATE_ACCOUNT)
+        {
+            /* Update error state, Saving Failed! */
+            Loc_ErrorState = SAVING_FAILED;
+        }
+    }
+
+    /* Loop: Until all changed accounts files are written */
+    for (uint32_t Loc_Shard = 0; Loc_Shard < Glb_ShardCount; Loc_Shard++)
+    {
+        /* Check: Added accounts can't be written to the accounts file */
+        if (Loc_AddedFlags[Loc_Shard] == FLAG_UP && databaseSync(&Glb_Shards[Loc_Shard].accountsDatabase) != DATABASE_OK)
+        {
+            /* Update error state, Saving Failed! */
+            Loc_ErrorState = SAVING_FAILED;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: getTotalBalance
+ Input: void
+ Output: sint64_t Sum of all balances in cents
+ Description: This function scans the balances column of all accounts of all shards, without locks, while
+              transactions run the sum is not a consistent snapshot.
+*/
+sint64_t getTotalBalance(void)
+{
+    sint64_t Loc_Total = 0;
+
+    /* Loop: Until all shards are summed */
+    for (uint32_t Loc_Shard = 0; Loc_Shard < Glb_ShardCount; Loc_Shard++)
+    {
+        Loc_Total += databaseTotalBalance(&Glb_Shards[Loc_Shard].accountsDatabase);
+    }
+
+    return Loc_Total;
+}
+
+/*
+ Name: getBlockedAccounts
+ Input: void
+ Output: uint32_t Number of blocked accounts
+ Description: This function scans the states column of all accounts of all shards.
+*/
+uint32_t getBlockedAccounts(void)
+{
+    uint32_t Loc_Blocked = 0;
+
+    /* Loop: Until all shards are counted */
+    for (uint32_t Loc_Shard = 0; Loc_Shard < Glb_ShardCount; Loc_Shard++)
+    {
+        Loc_Blocked += databaseBlockedAccounts(&Glb_Shards[Loc_Shard].accountsDatabase);
+    }
+
+    return Loc_Blocked;
+}
+
+/*
+ Name: setVelocityLimits
+ Input: Pointer to Velocity Limits
+ Output: void
+ Description: 1. This function sets the most approved transactions and cents of an account in its last minute, hour
+                 and day, a limit of 0 is no limit, and all limits 0 turn the checks off.
+              2. It is called before transactions are authorized, windows start counting once a limit is set.
+*/
+void setVelocityLimits(ST_velocityLimits_t *limits)
+{
+    /* Define local variable to set the velocity flag, No Limit */
+    EN_flagState_t Loc_VelocityFlag = FLAG_DOWN;
+
+    Glb_VelocityLimits = *limits;
+
+    /* Loop: Until all windows are checked for a limit */
+    for (uint32_t Loc_Window = 0; Loc_Window < VELOCITY_WINDOWS; Loc_Window++)
+    {
+        /* Check: Window has a limit */
+        if (limits->maxCount[Loc_Window] != 0 || limits->maxAmount[Loc_Window] != 0)
+        {
+            Loc_VelocityFlag = FLAG_UP;
+        }
+    }
+
+    Glb_VelocityFlag = Loc_VelocityFlag;
+}
+
+/*
+ Name: setStageHistograms
+ Input: EN_flagState_t Enabled flag
+ Output: void
+ Description: 1. This function turns timing of the stages of recieveTransactionData on or off.
+              2. Turning it on clears the stage histograms, a sample costs two clock reads and one atomic add.
+*/
+void setStageHistograms(EN_flagState_t enabledFlag)
+{
+    /* Check: Histograms are turned on */
+    if (enabledFlag == FLAG_UP)
+    {
+        /* Loop: Until all stage histograms are cleared */
+        for (uint32_t Loc_Stage = 0; Loc_Stage < SERVER_STAGES; Loc_Stage++)
+        {
+            histogramReset(&Glb_StageHistograms[Loc_Stage]);
+        }
+
+        /* Measure the clock rate now, not in the middle of a dump */
+        histogramTicksPerNanosecond();
+    }
+
+    __atomic_store_n(&Glb_StageFlag, enabledFlag, __ATOMIC_RELAXED);
+}
+
+/*
+ Name: dumpStageHistograms
+ Input: void
+ Output: void
+ Description: This function prints the samples and the p50, p99, p999 and largest time in nanoseconds of every stage
+              of recieveTransactionData, while transactions keep running.
+*/
+void dumpStageHistograms(void)
+{
+    printf(" %-20s %10s %10s %10s %10s %10s\n", "Stage", "Samples", "p50 ns", "p99 ns", "p999 ns", "Max ns");
+
+    /* Loop: Until all stage histograms are printed */
+    for (uint32_t Loc_Stage = 0; Loc_Stage < SERVER_STAGES; Loc_Stage++)
+    {
+        histogramPrint(&Glb_StageHistograms[Loc_Stage], Glb_StageNames[Loc_Stage]);
+    }
+
+    fflush(stdout);
+}
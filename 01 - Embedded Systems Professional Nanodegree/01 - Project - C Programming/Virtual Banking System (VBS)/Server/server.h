@@ -1,50 +1,115 @@
-#ifndef SERVER_H_
-#define SERVER_H_
-
-/* Library Module */
-#include "../Library/standard_types.h"
-
-typedef enum EN_flagState_t
-{
-	FLAG_DOWN, FLAG_UP
-}EN_flagState_t;
-
-typedef enum EN_transState_t 
-{
-	APPROVED, DECLINED_INSUFFECIENT_FUND, DECLINED_STOLEN_CARD, FRAUD_CARD, INTERNAL_SERVER_ERROR 
-}EN_transState_t; 
-
-typedef struct ST_transaction_t
-{
-	ST_cardData_t cardHolderData; 
-	ST_terminalData_t terminalData; 
-	EN_transState_t transState; 
-	uint32_t transactionSequenceNumber; 
-}ST_transaction_t;
-
-typedef enum EN_serverError_t 
-{
-	SERVER_OK, SAVING_FAILED, TRANSACTION_NOT_FOUND, ACCOUNT_NOT_FOUND, LOW_BALANCE, BLOCKED_ACCOUNT
-}EN_serverError_t ; 
-
-typedef enum EN_accountState_t 
-{
-	RUNNING, BLOCKED 
-}EN_accountState_t;
-
-typedef struct ST_accountsDB_t
-{ 
-	float32_t balance;
-	EN_accountState_t state; 
-	uint8_t primaryAccountNumber[20];
-}ST_accountsDB_t;
-
-/* Functions' Prototypes */
-EN_transState_t recieveTransactionData(ST_transaction_t* transData);
-EN_serverError_t isValidAccount(ST_cardData_t* cardData, ST_accountsDB_t* accountRefrence);
-EN_serverError_t isBlockedAccount(ST_accountsDB_t* accountRefrence);
-EN_serverError_t isAmountAvailable(ST_terminalData_t* termData, ST_accountsDB_t* accountRefrence);
-EN_serverError_t saveTransaction(ST_transaction_t* transData);
-EN_serverError_t getTransaction(uint32_t transactionSequenceNumber, ST_transaction_t* transData);
-
+#ifndef SERVER_H_
+#define SERVER_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define SERVER_ACCOUNTS_FILE			"accounts.db"
+#define SERVER_LOG_FILE					"transactions.log"
+#define SERVER_ARCHIVE_FILE				"transactions.archive"
+#define SERVER_CHECKPOINT_INTERVAL		10000	/* Transactions before a checkpoint is requested ... */
+#define SERVER_CHECKPOINT_PERIOD_MS		1000	/* ... or milliseconds between checkpoints of changed pages */
+#define SERVER_RETAINED_SEGMENTS		0		/* Transaction segments kept, 0 keeps all history */
+#define SERVER_FIRST_SEQUENCE_NUMBER	1000
+#define SERVER_ACCOUNT_LOCKS			1024	/* Account lock stripes, a power of two */
+#define SERVER_CACHE_LINE_SIZE			64
+#define SERVER_BATCH_TRANSACTIONS		1024	/* Transactions per log append of a batch, at most LOG_BUFFER_RECORDS */
+#define SERVER_MAX_SHARDS				16
+#define SERVER_SHARD_SEQUENCES			0x0F000000	/* Sequence numbers of a shard, shard i starts at the first plus i times this */
+#define SERVER_SHARD_ACCOUNTS_FILE		"accounts.%u.db"			/* Files of a shard, numbered from 0 */
+#define SERVER_SHARD_LOG_FILE			"transactions.%u.log"
+#define SERVER_SHARD_ARCHIVE_FILE		"transactions.%u.archive"
+#define SERVER_PIPELINE_DEPTH			4		/* Batches in flight between the stages of the pipeline */
+#define SERVER_STANDBY_POLL_US			1000	/* Microseconds between polls of the log of the primary once caught up */
+#define SERVER_STANDBY_COPY_SIZE		1048576	/* Bytes read at once by a base copy */
+#define SERVER_STANDBY_COPY_ATTEMPTS	8		/* Base copies of a shard made before giving up */
+#define SERVER_STANDBY_PATH_SIZE		512		/* Bytes of a path to a file of the primary */
+#define SERVER_STANDBY_ACCOUNTS			64		/* Accounts read at once from the accounts file of the primary */
+
+typedef enum EN_flagState_t
+{
+	FLAG_DOWN, FLAG_UP
+}EN_flagState_t;
+
+typedef enum EN_transState_t 
+{
+	/* Values are kept in the log, the archive and the protocol, new states are added last */
+	APPROVED, DECLINED_INSUFFECIENT_FUND, DECLINED_STOLEN_CARD, FRAUD_CARD, INTERNAL_SERVER_ERROR, DECLINED_VELOCITY_LIMIT 
+}EN_transState_t; 
+
+typedef struct ST_transaction_t
+{
+	ST_cardData_t cardHolderData; 
+	ST_terminalData_t terminalData; 
+	EN_transState_t transState; 
+	uint32_t transactionSequenceNumber; 
+}ST_transaction_t;
+
+typedef enum EN_serverError_t 
+{
+	SERVER_OK, SAVING_FAILED, TRANSACTION_NOT_FOUND, ACCOUNT_NOT_FOUND, LOW_BALANCE, BLOCKED_ACCOUNT, INIT_FAILED,
+	EXCEED_VELOCITY_LIMIT
+}EN_serverError_t ; 
+
+typedef enum EN_serverStage_t
+{
+	STAGE_VALID_ACCOUNT, STAGE_BLOCKED_ACCOUNT, STAGE_AMOUNT_AVAILABLE, STAGE_SAVE_TRANSACTION, STAGE_GET_TRANSACTION,
+	SERVER_STAGES
+}EN_serverStage_t;
+
+typedef enum EN_velocityWindow_t
+{
+	VELOCITY_MINUTE, VELOCITY_HOUR, VELOCITY_DAY, VELOCITY_WINDOWS
+}EN_velocityWindow_t;
+
+typedef struct ST_velocityLimits_t
+{
+	uint32_t maxCount[VELOCITY_WINDOWS];	/* Approved transactions of an account in every window, 0 for no limit */
+	sint64_t maxAmount[VELOCITY_WINDOWS];	/* Cents approved for an account in every window, 0 for no limit */
+}ST_velocityLimits_t;
+
+typedef struct ST_batchItem_t
+{
+	uint32_t record;						/* Account record in accountsDB */
+	uint32_t position;						/* Transaction position in the batch */
+}ST_batchItem_t;
+
+typedef enum EN_accountState_t 
+{
+	RUNNING, BLOCKED 
+}EN_accountState_t;
+
+typedef struct ST_accountsDB_t
+{ 
+	sint64_t balance;					/* Cents */
+	EN_accountState_t state; 
+	uint8_t primaryAccountNumber[20];
+}ST_accountsDB_t;
+
+/* Functions' Prototypes */
+EN_serverError_t initServer(void);
+EN_serverError_t initServerShards(uint32_t shardCount);
+EN_serverError_t initServerPipeline(void);
+EN_serverError_t initServerStandby(uint8_t* primaryDirectory, uint32_t shardCount);
+EN_serverError_t getStandbyLag(uint64_t* bytes, uint32_t* transactions);
+EN_serverError_t takeOverServer(void);
+void closeServer(void);
+EN_transState_t recieveTransactionData(ST_transaction_t* transData);
+void recieveTransactionBatch(ST_transaction_t* transData, uint32_t count, EN_transState_t* transStates);
+EN_serverError_t isValidAccount(ST_cardData_t* cardData, ST_accountsDB_t* accountRefrence);
+EN_serverError_t isBlockedAccount(ST_accountsDB_t* accountRefrence);
+EN_serverError_t isAmountAvailable(ST_terminalData_t* termData, ST_accountsDB_t* accountRefrence);
+EN_serverError_t saveTransaction(ST_transaction_t* transData);
+EN_serverError_t getTransaction(uint32_t transactionSequenceNumber, ST_transaction_t* transData);
+EN_serverError_t getAccountTransactions(ST_cardData_t* cardData, ST_transaction_t* transData, uint32_t maxCount, uint32_t* count);
+EN_serverError_t getTransactionsByDate(uint8_t* fromDate, uint8_t* toDate, uint32_t transStates, ST_transaction_t* transData,
+                                       uint32_t maxCount, uint32_t* count);
+EN_serverError_t getAccount(uint32_t record, ST_accountsDB_t* accountRefrence);
+EN_serverError_t addAccounts(ST_accountsDB_t* accountRefrence, uint32_t count, uint32_t* added);
+sint64_t getTotalBalance(void);
+uint32_t getBlockedAccounts(void);
+void setVelocityLimits(ST_velocityLimits_t* limits);
+void setStageHistograms(EN_flagState_t enabledFlag);
+void dumpStageHistograms(void);
+
 #endif /* SERVER_H_ */
\ No newline at end of file
@@ -0,0 +1,804 @@
+/* Standard Library */
+#include <stdlib.h>
+#include <string.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Store Module */
+#include "store.h"
+
+/*
+ Name: storeDictionaryHash
+ Input: Pointer to Entry, uint32_t Entry size
+ Output: uint32_t Hash of the entry
+ Description: Static Function to hash the bytes of a dictionary entry, FNV-1a.
+*/
+static uint32_t storeDictionaryHash(uint8_t *entry, uint32_t size)
+{
+    uint32_t Loc_Hash = 2166136261U;
+
+    /* Loop: Until all bytes are hashed */
+    for (uint32_t Loc_Index = 0; Loc_Index < size; Loc_Index++)
+    {
+        Loc_Hash = (Loc_Hash ^ entry[Loc_Index]) * 16777619U;
+    }
+
+    return Loc_Hash;
+}
+
+/*
+ Name: storeDictionaryGrow
+ Input: Pointer to Dictionary structure
+ Output: EN_storeError_t Error or No Error
+ Description: Static Function to double the entries of a dictionary, STORE_MIN_DICTIONARY for a new one, and hash
+              every used entry again into a new table of twice as many slots. Codes never change.
+*/
+static EN_storeError_t storeDictionaryGrow(ST_storeDictionary_t *dictionary)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_storeError_t Loc_ErrorState = STORE_OK;
+    uint32_t Loc_Capacity    = (dictionary->capacity == 0) ? STORE_MIN_DICTIONARY : dictionary->capacity * 2;
+    uint8_t *Loc_Entries     = realloc(dictionary->entries, (size_t)Loc_Capacity * dictionary->entrySize);
+    uint32_t *Loc_References = realloc(dictionary->references, Loc_Capacity * sizeof(uint32_t));
+    uint32_t *Loc_FreeCodes  = realloc(dictionary->freeCodes, Loc_Capacity * sizeof(uint32_t));
+    uint32_t *Loc_Slots      = calloc(Loc_Capacity * 2, sizeof(uint32_t));
+    uint32_t Loc_Slot;
+
+    /* Arrays that grew replace the old ones, the others are kept */
+    dictionary->entries    = (Loc_Entries == NULL) ? dictionary->entries : Loc_Entries;
+    dictionary->references = (Loc_References == NULL) ? dictionary->references : Loc_References;
+    dictionary->freeCodes  = (Loc_FreeCodes == NULL) ? dictionary->freeCodes : Loc_FreeCodes;
+
+    /* Check 1: Allocation failed, the old capacity is kept */
+    if (Loc_Entries == NULL || Loc_References == NULL || Loc_FreeCodes == NULL || Loc_Slots == NULL)
+    {
+        free(Loc_Slots);
+
+        /* Update error state, No Memory! */
+        Loc_ErrorState = STORE_NO_MEMORY;
+    }
+    /* Check 2: Allocation succeeded */
+    else
+    {
+        /* Loop: Until all used entries are in the new table */
+        for (uint32_t Loc_Code = 0; Loc_Code < dictionary->count; Loc_Code++)
+        {
+            /* Check: Code is used */
+            if (Loc_References[Loc_Code] != 0)
+            {
+                Loc_Slot = storeDictionaryHash(&Loc_Entries[(size_t)Loc_Code * dictionary->entrySize], dictionary->entrySize) & (Loc_Capacity * 2 - 1);
+
+                /* Loop: Until a free slot */
+                while (Loc_Slots[Loc_Slot] != 0)
+                {
+                    Loc_Slot = (Loc_Slot + 1) & (Loc_Capacity * 2 - 1);
+                }
+
+                Loc_Slots[Loc_Slot] = Loc_Code + 1;
+            }
+        }
+
+        free(dictionary->slots);
+        dictionary->slots    = Loc_Slots;
+        dictionary->capacity = Loc_Capacity;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: storeDictionaryCode
+ Input: Pointer to Dictionary structure, Pointer to Entry, Pointer to uint32_t Code
+ Output: EN_storeError_t Error or No Error
+ Description: Static Function to give the code of an entry for one more record, adding it if it is new, with a free
+              code if there is one, else the next code. Entries are compared as bytes, they must be zeroed before
+              they are filled.
+*/
+static EN_storeError_t storeDictionaryCode(ST_storeDictionary_t *dictionary, uint8_t *entry, uint32_t *code)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_storeError_t Loc_ErrorState = STORE_OK;
+    uint32_t Loc_Slot, Loc_Code;
+
+    /* Check 1: Dictionary is full and can't grow */
+    if (dictionary->freeCount == 0 && dictionary->count == dictionary->capacity && storeDictionaryGrow(dictionary) == STORE_NO_MEMORY)
+    {
+        /* Update error state, No Memory! */
+        Loc_ErrorState = STORE_NO_MEMORY;
+    }
+    /* Check 2: Look the entry up */
+    else
+    {
+        Loc_Slot = storeDictionaryHash(entry, dictionary->entrySize) & (dictionary->capacity * 2 - 1);
+
+        /* Loop: Until the entry, or a free slot */
+        while (dictionary->slots[Loc_Slot] != 0 &&
+               memcmp(&dictionary->entries[(size_t)(dictionary->slots[Loc_Slot] - 1) * dictionary->entrySize], entry, dictionary->entrySize) != 0)
+        {
+            Loc_Slot = (Loc_Slot + 1) & (dictionary->capacity * 2 - 1);
+        }
+
+        /* Check 2.1: Entry is new, add it with a free code, or the next one */
+        if (dictionary->slots[Loc_Slot] == 0)
+        {
+            /* Check 2.1.1: A code is free */
+            if (dictionary->freeCount != 0)
+            {
+                dictionary->freeCount--;
+                Loc_Code = dictionary->freeCodes[dictionary->freeCount];
+            }
+            else
+            {
+                Loc_Code = dictionary->count;
+                dictionary->count++;
+            }
+
+            memcpy(&dictionary->entries[(size_t)Loc_Code * dictionary->entrySize], entry, dictionary->entrySize);
+            dictionary->references[Loc_Code] = 0;
+            dictionary->slots[Loc_Slot]      = Loc_Code + 1;
+        }
+
+        *code = dictionary->slots[Loc_Slot] - 1;
+        dictionary->references[*code]++;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: storeDictionaryRelease
+ Input: Pointer to Dictionary structure, uint32_t Code
+ Output: void
+ Description: Static Function to give back the code of an entry for one record. A code no record uses anymore is
+              taken out of the table, the entries after it in its probe run are moved back so they are still found
+              from their slot, and the code is free for the next new entry.
+*/
+static void storeDictionaryRelease(ST_storeDictionary_t *dictionary, uint32_t code)
+{
+    uint32_t Loc_Mask = dictionary->capacity * 2 - 1;
+    uint32_t Loc_Hole, Loc_Next, Loc_Home;
+
+    dictionary->references[code]--;
+
+    /* Check: Code is not used anymore */
+    if (dictionary->references[code] == 0)
+    {
+        Loc_Hole = storeDictionaryHash(&dictionary->entries[(size_t)code * dictionary->entrySize], dictionary->entrySize) & Loc_Mask;
+
+        /* Loop: Until the slot of the code */
+        while (dictionary->slots[Loc_Hole] != code + 1)
+        {
+            Loc_Hole = (Loc_Hole + 1) & Loc_Mask;
+        }
+
+        dictionary->slots[Loc_Hole] = 0;
+        Loc_Next = (Loc_Hole + 1) & Loc_Mask;
+
+        /* Loop: Until the end of the probe run, an entry whose slot is not between the hole and itself fills the hole */
+        while (dictionary->slots[Loc_Next] != 0)
+        {
+            Loc_Home = storeDictionaryHash(&dictionary->entries[(size_t)(dictionary->slots[Loc_Next] - 1) * dictionary->entrySize],
+                                           dictionary->entrySize) & Loc_Mask;
+
+            /* Check: Entry is found from its slot through the hole */
+            if (((Loc_Next - Loc_Home) & Loc_Mask) >= ((Loc_Next - Loc_Hole) & Loc_Mask))
+            {
+                dictionary->slots[Loc_Hole] = dictionary->slots[Loc_Next];
+                dictionary->slots[Loc_Next] = 0;
+                Loc_Hole = Loc_Next;
+            }
+
+            Loc_Next = (Loc_Next + 1) & Loc_Mask;
+        }
+
+        dictionary->freeCodes[dictionary->freeCount] = code;
+        dictionary->freeCount++;
+    }
+}
+
+/*
+ Name: storeCopyString
+ Input: Pointer to destination, Pointer to source, uint32_t Size of the string fields
+ Output: void
+ Description: Static Function to copy a string field up to its end, the rest of the destination is zeroed.
+*/
+static void storeCopyString(uint8_t *destination, uint8_t *source, uint32_t size)
+{
+    uint32_t Loc_Length = strnlen((char *)source, size);
+
+    memcpy(destination, source, Loc_Length);
+    memset(&destination[Loc_Length], 0, size - Loc_Length);
+}
+
+/*
+ Name: storeEncode
+ Input: Pointer to Store structure, Pointer to Transaction structure, Pointer to Store Record
+ Output: EN_storeError_t Error or No Error
+ Description: Static Function to encode a transaction as a compact record. The PAN is packed into its digits, the
+              name and expiry date are coded in the cards dictionary, the terminal id and max amount in the
+              terminals dictionary. A PAN that can't be packed, or a date its day number doesn't give back, is kept
+              in the dictionary entry so every transaction is decoded as it was appended. The day is kept in the
+              date column by storeAppend. The record holds its entries until its segment is retired.
+*/
+static EN_storeError_t storeEncode(ST_transactionStore_t *store, ST_transaction_t *transData, ST_storeRecord_t *record)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_storeError_t Loc_ErrorState = STORE_OK;
+    ST_storeCard_t Loc_Card;
+    ST_storeTerminal_t Loc_Terminal;
+    ST_panKey_t Loc_PanKey;
+    uint8_t Loc_Date[sizeof(transData->terminalData.transactionDate)];
+    uint32_t Loc_Day;
+
+    memset(&Loc_Card, 0, sizeof(ST_storeCard_t));
+    memset(&Loc_Terminal, 0, sizeof(ST_storeTerminal_t));
+    storeCopyString(Loc_Card.cardHolderName, transData->cardHolderData.cardHolderName, sizeof(Loc_Card.cardHolderName));
+    storeCopyString(Loc_Card.cardExpirationDate, transData->cardHolderData.cardExpirationDate, sizeof(Loc_Card.cardExpirationDate));
+    Loc_Terminal.maxTransAmount = transData->terminalData.maxTransAmount;
+    Loc_Terminal.terminalId     = transData->terminalData.terminalId;
+
+    /* Check 1: PAN can't be packed, keep it in the card entry */
+    if (packCardPAN(transData->cardHolderData.primaryAccountNumber, &Loc_PanKey) != CARD_OK)
+    {
+        storeCopyString(Loc_Card.primaryAccountNumber, transData->cardHolderData.primaryAccountNumber, sizeof(Loc_Card.primaryAccountNumber));
+        Loc_PanKey.number = 0;
+        Loc_PanKey.length = 0;
+    }
+
+    packTransactionDate(transData->terminalData.transactionDate, &Loc_Day);
+    unpackTransactionDate(Loc_Day, Loc_Date);
+
+    /* Check 2: Day number doesn't give the date back, keep it in the terminal entry */
+    if (strncmp((char *)Loc_Date, (char *)transData->terminalData.transactionDate, sizeof(Loc_Date)) != 0)
+    {
+        storeCopyString(Loc_Terminal.transactionDate, transData->terminalData.transactionDate, sizeof(Loc_Terminal.transactionDate));
+    }
+
+    memset(record, 0, sizeof(ST_storeRecord_t));
+    record->panNumber   = Loc_PanKey.number;
+    record->panLength   = Loc_PanKey.length;
+    record->transAmount = transData->terminalData.transAmount;
+    record->requestId   = transData->terminalData.requestId;
+    record->transState  = transData->transState;
+
+    /* Check 3: Card entry can't be added to its dictionary */
+    if (storeDictionaryCode(&store->cards, (uint8_t *)&Loc_Card, &record->cardCode) != STORE_OK)
+    {
+        /* Update error state, No Memory! */
+        Loc_ErrorState = STORE_NO_MEMORY;
+    }
+    /* Check 4: Terminal entry can't be added to its dictionary, the card entry is given back */
+    else if (storeDictionaryCode(&store->terminals, (uint8_t *)&Loc_Terminal, &record->terminalCode) != STORE_OK)
+    {
+        storeDictionaryRelease(&store->cards, record->cardCode);
+
+        /* Update error state, No Memory! */
+        Loc_ErrorState = STORE_NO_MEMORY;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: storeDecode
+ Input: Pointer to Store structure, Pointer to Segment, uint32_t Position in the segment, Pointer to Transaction structure
+ Output: void
+ Description: Static Function to decode the compact record at a position of a segment back to its transaction.
+*/
+static void storeDecode(ST_transactionStore_t *store, ST_transactionSegment_t *segment, uint32_t position, ST_transaction_t *transData)
+{
+    ST_storeRecord_t *Loc_Record     = &segment->records[position];
+    ST_storeCard_t *Loc_Card         = (ST_storeCard_t *)&store->cards.entries[(size_t)Loc_Record->cardCode * sizeof(ST_storeCard_t)];
+    ST_storeTerminal_t *Loc_Terminal = (ST_storeTerminal_t *)&store->terminals.entries[(size_t)Loc_Record->terminalCode * sizeof(ST_storeTerminal_t)];
+    ST_panKey_t Loc_PanKey;
+
+    memset(transData, 0, sizeof(ST_transaction_t));
+    memcpy(transData->cardHolderData.cardHolderName, Loc_Card->cardHolderName, sizeof(Loc_Card->cardHolderName));
+    memcpy(transData->cardHolderData.cardExpirationDate, Loc_Card->cardExpirationDate, sizeof(Loc_Card->cardExpirationDate));
+
+    /* Check 1: PAN is in the card entry */
+    if (Loc_Record->panLength == 0)
+    {
+        memcpy(transData->cardHolderData.primaryAccountNumber, Loc_Card->primaryAccountNumber, sizeof(Loc_Card->primaryAccountNumber));
+    }
+    /* Check 2: PAN is packed */
+    else
+    {
+        Loc_PanKey.number = Loc_Record->panNumber;
+        Loc_PanKey.length = Loc_Record->panLength;
+        unpackCardPAN(&Loc_PanKey, transData->cardHolderData.primaryAccountNumber);
+    }
+
+    /* Check 3: Date is in the terminal entry */
+    if (Loc_Terminal->transactionDate[0] != '\0')
+    {
+        memcpy(transData->terminalData.transactionDate, Loc_Terminal->transactionDate, sizeof(Loc_Terminal->transactionDate));
+    }
+    /* Check 4: Date is its day number */
+    else
+    {
+        unpackTransactionDate(segment->dateKeys[position] >> 8, transData->terminalData.transactionDate);
+    }
+
+    transData->terminalData.transAmount    = Loc_Record->transAmount;
+    transData->terminalData.maxTransAmount = Loc_Terminal->maxTransAmount;
+    transData->terminalData.terminalId     = Loc_Terminal->terminalId;
+    transData->terminalData.requestId      = Loc_Record->requestId;
+    transData->transState                  = (EN_transState_t)Loc_Record->transState;
+    transData->transactionSequenceNumber   = segment->firstSequenceNumber + position;
+}
+
+/*
+ Name: storeGrowDirectory
+ Input: Pointer to Store structure
+ Output: EN_storeError_t Error or No Error
+ Description: Static Function to double the segments directory, segments are placed in the new ring by their
+              segment number, the segments themselves are not copied.
+*/
+static EN_storeError_t storeGrowDirectory(ST_transactionStore_t *store)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_storeError_t Loc_ErrorState = STORE_OK;
+    uint32_t Loc_Capacity = store->directoryCapacity * 2;
+    ST_transactionSegment_t **Loc_Directory = calloc(Loc_Capacity, sizeof(ST_transactionSegment_t *));
+
+    /* Check 1: Allocation failed */
+    if (Loc_Directory == NULL)
+    {
+        /* Update error state, No Memory! */
+        Loc_ErrorState = STORE_NO_MEMORY;
+    }
+    /* Check 2: Allocation succeeded */
+    else
+    {
+        /* Loop: Until all retained segments are placed */
+        for (uint32_t Loc_Segment = store->firstSegment; Loc_Segment < store->firstSegment + store->segmentCount; Loc_Segment++)
+        {
+            Loc_Directory[Loc_Segment & (Loc_Capacity - 1)] = store->directory[Loc_Segment & (store->directoryCapacity - 1)];
+        }
+
+        free(store->directory);
+        store->directory         = Loc_Directory;
+        store->directoryCapacity = Loc_Capacity;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: storeOpenSegment
+ Input: Pointer to Store structure
+ Output: EN_storeError_t Error or No Error
+ Description: Static Function to append a new open segment after the last one, then retire the oldest sealed
+              segment if more segments than the retention limit are kept.
+*/
+static EN_storeError_t storeOpenSegment(ST_transactionStore_t *store)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_storeError_t Loc_ErrorState = STORE_OK;
+    ST_transactionSegment_t *Loc_Segment = NULL;
+
+    /* Check 1: Directory is full and can't grow */
+    if (store->segmentCount == store->directoryCapacity && storeGrowDirectory(store) == STORE_NO_MEMORY)
+    {
+        /* Update error state, No Memory! */
+        Loc_ErrorState = STORE_NO_MEMORY;
+    }
+    /* Check 2: Segment can't be allocated */
+    else if ((Loc_Segment = malloc(sizeof(ST_transactionSegment_t))) == NULL)
+    {
+        /* Update error state, No Memory! */
+        Loc_ErrorState = STORE_NO_MEMORY;
+    }
+    /* Check 3: Segment is allocated */
+    else
+    {
+        Loc_Segment->firstSequenceNumber = store->nextSequenceNumber;
+        Loc_Segment->count               = 0;
+        Loc_Segment->state               = SEGMENT_OPEN;
+
+        store->directory[(store->firstSegment + store->segmentCount) & (store->directoryCapacity - 1)] = Loc_Segment;
+        store->segmentCount++;
+
+        /* Check 3.1: Retention limit is exceeded */
+        if (store->maxSegments != 0 && store->segmentCount > store->maxSegments)
+        {
+            storeRetire(store);
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: storeInit
+ Input: Pointer to Store structure, uint32_t First sequence number, uint32_t Maximum segments kept
+ Output: EN_storeError_t Error or No Error
+ Description: 1. This function initializes an empty transactions store.
+              2. The first transaction appended gets the given sequence number.
+              3. If maxSegments is not 0, the oldest sealed segment is retired whenever more segments are kept.
+              4. Transactions are kept as compact records, the names, expiry dates, terminals and max amounts they
+                 repeat are kept once in the dictionaries of the store, an entry is kept while a transaction of the
+                 retained segments uses it, so the dictionaries are bounded by the retained transactions too.
+              5. If the directory or the dictionaries can't be allocated will return STORE_NO_MEMORY, else return
+                 STORE_OK.
+*/
+EN_storeError_t storeInit(ST_transactionStore_t *store, uint32_t firstSequenceNumber, uint32_t maxSegments)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_storeError_t Loc_ErrorState = STORE_OK;
+
+    store->directory           = calloc(STORE_MIN_DIRECTORY, sizeof(ST_transactionSegment_t *));
+    store->directoryCapacity   = STORE_MIN_DIRECTORY;
+    store->firstSegment        = 0;
+    store->segmentCount        = 0;
+    store->maxSegments         = maxSegments;
+    store->firstSequenceNumber = firstSequenceNumber;
+    store->nextSequenceNumber  = firstSequenceNumber;
+
+    memset(&store->cards, 0, sizeof(ST_storeDictionary_t));
+    memset(&store->terminals, 0, sizeof(ST_storeDictionary_t));
+    store->cards.entrySize     = sizeof(ST_storeCard_t);
+    store->terminals.entrySize = sizeof(ST_storeTerminal_t);
+
+    /* Check: Allocation failed */
+    if (store->directory == NULL || storeDictionaryGrow(&store->cards) != STORE_OK || storeDictionaryGrow(&store->terminals) != STORE_OK)
+    {
+        /* Update error state, No Memory! */
+        Loc_ErrorState = STORE_NO_MEMORY;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: storeAppend
+ Input: Pointer to Store structure, Pointer to Transaction structure, uint32_t Previous sequence number of the account
+ Output: EN_storeError_t Error or No Error
+ Description: 1. This function gives the transaction the next sequence number and appends it to the open segment.
+              2. The sequence number of the previous transaction of the same account is kept next to it, 0 if it is
+                 the first transaction of the account or belongs to no account.
+              3. It is kept as a compact record of fixed width fields, see storeEncode.
+              4. Its day number and state are packed into the date column, and added to the zone map of its zone.
+              5. A segment is sealed once it is full, the next append opens a new segment.
+              6. If a new segment or dictionary entry can't be allocated will return STORE_NO_MEMORY and the
+                 sequence number is not used, else return STORE_OK.
+*/
+EN_storeError_t storeAppend(ST_transactionStore_t *store, ST_transaction_t *transData, uint32_t previousSequenceNumber)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_storeError_t Loc_ErrorState = STORE_OK;
+    ST_transactionSegment_t *Loc_Segment = NULL;
+    ST_storeZone_t *Loc_Zone;
+    ST_storeRecord_t Loc_Record;
+    uint32_t Loc_Day;
+
+    /* Check 1: Store has segments */
+    if (store->segmentCount != 0)
+    {
+        Loc_Segment = store->directory[(store->firstSegment + store->segmentCount - 1) & (store->directoryCapacity - 1)];
+    }
+
+    /* Check 2: Transaction can't be encoded */
+    if (storeEncode(store, transData, &Loc_Record) == STORE_NO_MEMORY)
+    {
+        /* Update error state, No Memory! */
+        Loc_ErrorState = STORE_NO_MEMORY;
+    }
+    /* Check 3: No open segment and a new one can't be opened, the dictionary entries are given back */
+    else if ((Loc_Segment == NULL || Loc_Segment->state == SEGMENT_SEALED) && storeOpenSegment(store) == STORE_NO_MEMORY)
+    {
+        storeDictionaryRelease(&store->cards, Loc_Record.cardCode);
+        storeDictionaryRelease(&store->terminals, Loc_Record.terminalCode);
+
+        /* Update error state, No Memory! */
+        Loc_ErrorState = STORE_NO_MEMORY;
+    }
+    /* Check 4: Open segment is available */
+    else
+    {
+        Loc_Segment = store->directory[(store->firstSegment + store->segmentCount - 1) & (store->directoryCapacity - 1)];
+
+        /* Save the current sequence number in the current transaction structure */
+        transData->transactionSequenceNumber = store->nextSequenceNumber;
+        Loc_Segment->records[Loc_Segment->count] = Loc_Record;
+        Loc_Segment->previousSequenceNumbers[Loc_Segment->count] = previousSequenceNumber;
+
+        /* Wrong dates are day TERMINAL_NO_DAY, before any range */
+        packTransactionDate(transData->terminalData.transactionDate, &Loc_Day);
+        Loc_Segment->dateKeys[Loc_Segment->count] = (Loc_Day << 8) | STORE_STATE_BIT(transData->transState);
+        Loc_Zone = &Loc_Segment->zones[Loc_Segment->count / STORE_ZONE_SIZE];
+
+        /* Check 4.1: First transaction of the zone */
+        if (Loc_Segment->count % STORE_ZONE_SIZE == 0)
+        {
+            Loc_Zone->minDay    = Loc_Day;
+            Loc_Zone->maxDay    = Loc_Day;
+            Loc_Zone->stateBits = 0;
+        }
+
+        Loc_Zone->minDay     = (Loc_Day < Loc_Zone->minDay) ? Loc_Day : Loc_Zone->minDay;
+        Loc_Zone->maxDay     = (Loc_Day > Loc_Zone->maxDay) ? Loc_Day : Loc_Zone->maxDay;
+        Loc_Zone->stateBits |= STORE_STATE_BIT(transData->transState);
+
+        Loc_Segment->count++;
+        store->nextSequenceNumber++;
+
+        /* Check 4.2: Segment is full */
+        if (Loc_Segment->count == STORE_SEGMENT_SIZE)
+        {
+            /* Seal segment, it won't be written again */
+            Loc_Segment->state = SEGMENT_SEALED;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: storeGet
+ Input: Pointer to Store structure, uint32_t Transaction sequence number, Pointer to Transaction structure
+ Output: EN_storeError_t Error or No Error
+ Description: 1. This function finds a transaction by its sequence number.
+              2. Every segment holds STORE_SEGMENT_SIZE consecutive sequence numbers, so the segment and the position
+                 inside it are computed directly, the compact record is decoded.
+              3. If the transaction was never appended or its segment was retired will return STORE_NOT_FOUND,
+                 else return STORE_OK and the transaction data.
+*/
+EN_storeError_t storeGet(ST_transactionStore_t *store, uint32_t transactionSequenceNumber, ST_transaction_t *transData)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_storeError_t Loc_ErrorState = STORE_OK;
+    uint32_t Loc_Offset  = transactionSequenceNumber - store->firstSequenceNumber;
+    uint32_t Loc_Segment = Loc_Offset / STORE_SEGMENT_SIZE;
+
+    /* Check 1: Transaction not appended yet or segment retired */
+    if (transactionSequenceNumber < store->firstSequenceNumber || transactionSequenceNumber >= store->nextSequenceNumber ||
+        Loc_Segment < store->firstSegment)
+    {
+        /* Update error state, Not Found! */
+        Loc_ErrorState = STORE_NOT_FOUND;
+    }
+    /* Check 2: Transaction is stored */
+    else
+    {
+        storeDecode(store, store->directory[Loc_Segment & (store->directoryCapacity - 1)], Loc_Offset % STORE_SEGMENT_SIZE, transData);
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: storeGetPrevious
+ Input: Pointer to Store structure, uint32_t Transaction sequence number, Pointer to uint32_t Previous sequence number
+ Output: EN_storeError_t Error or No Error
+ Description: 1. This function finds the previous transaction of the same account as a transaction, following these
+                 links from the last transaction of an account lists its transactions newest first.
+              2. If the transaction was never appended or its segment was retired will return STORE_NOT_FOUND,
+                 else return STORE_OK and the previous sequence number, 0 if there is none.
+*/
+EN_storeError_t storeGetPrevious(ST_transactionStore_t *store, uint32_t transactionSequenceNumber, uint32_t *previousSequenceNumber)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_storeError_t Loc_ErrorState = STORE_OK;
+    uint32_t Loc_Offset  = transactionSequenceNumber - store->firstSequenceNumber;
+    uint32_t Loc_Segment = Loc_Offset / STORE_SEGMENT_SIZE;
+
+    /* Check 1: Transaction not appended yet or segment retired */
+    if (transactionSequenceNumber < store->firstSequenceNumber || transactionSequenceNumber >= store->nextSequenceNumber ||
+        Loc_Segment < store->firstSegment)
+    {
+        /* Update error state, Not Found! */
+        Loc_ErrorState = STORE_NOT_FOUND;
+    }
+    /* Check 2: Transaction is stored */
+    else
+    {
+        *previousSequenceNumber = store->directory[Loc_Segment & (store->directoryCapacity - 1)]->previousSequenceNumbers[Loc_Offset % STORE_SEGMENT_SIZE];
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: storeFindByDate
+ Input: Pointer to Store structure, uint32_t First day, uint32_t Last day, uint32_t States wanted,
+        Pointer to Transactions, uint32_t Maximum number of transactions
+ Output: uint32_t Number of transactions found
+ Description: 1. This function finds the transactions from the first day to the last day, both included, whose
+                 STORE_STATE_BIT is in stateBits, oldest first, at most maxCount of them.
+              2. A zone whose days are all outside the range, or with none of the wanted states, is skipped from its
+                 zone map without reading its transactions.
+              3. Other zones are filtered on the packed date column first, with no branch per transaction so the
+                 compiler can vectorize it, only matching transactions are decoded. Only the date keys of the
+                 transactions in the zone are read.
+*/
+uint32_t storeFindByDate(ST_transactionStore_t *store, uint32_t fromDay, uint32_t toDay, uint32_t stateBits,
+                         ST_transaction_t *transData, uint32_t maxCount)
+{
+    ST_transactionSegment_t *Loc_Segment;
+    ST_storeZone_t *Loc_Zone;
+    uint32_t Loc_Matches[STORE_ZONE_SIZE];
+    uint32_t Loc_Found = 0, Loc_First, Loc_End, Loc_Item, Loc_Span = toDay - fromDay;
+    uint32_t *Loc_Keys;
+
+    /* Loop: Until all retained segments are searched, or enough transactions are found */
+    for (uint32_t Loc_Index = store->firstSegment; Loc_Index < store->firstSegment + store->segmentCount && Loc_Found < maxCount; Loc_Index++)
+    {
+        Loc_Segment = store->directory[Loc_Index & (store->directoryCapacity - 1)];
+
+        /* Loop: Until all used zones of the segment are searched */
+        for (Loc_First = 0; Loc_First < Loc_Segment->count && Loc_Found < maxCount; Loc_First += STORE_ZONE_SIZE)
+        {
+            Loc_Zone = &Loc_Segment->zones[Loc_First / STORE_ZONE_SIZE];
+            Loc_End  = (Loc_Segment->count - Loc_First < STORE_ZONE_SIZE) ? Loc_Segment->count - Loc_First : STORE_ZONE_SIZE;
+            Loc_Keys = &Loc_Segment->dateKeys[Loc_First];
+
+            /* Check: Zone may hold matching transactions */
+            if (Loc_Zone->maxDay >= fromDay && Loc_Zone->minDay <= toDay && (Loc_Zone->stateBits & stateBits) != 0 && fromDay <= toDay)
+            {
+                /* Loop: Over the full lane groups of the date column of the zone, day in range and state wanted, fixed lanes so the loop is vectorized */
+                for (Loc_Item = 0; Loc_Item + STORE_SCAN_LANES <= Loc_End; Loc_Item += STORE_SCAN_LANES)
+                {
+                    for (uint32_t Loc_Lane = 0; Loc_Lane < STORE_SCAN_LANES; Loc_Lane++)
+                    {
+                        Loc_Matches[Loc_Item + Loc_Lane] = ((Loc_Keys[Loc_Item + Loc_Lane] >> 8) - fromDay <= Loc_Span) &
+                                                           ((Loc_Keys[Loc_Item + Loc_Lane] & stateBits) != 0);
+                    }
+                }
+
+                /* Loop: Over the transactions of a partial zone past its last full lane group, no key past them is read */
+                for (; Loc_Item < Loc_End; Loc_Item++)
+                {
+                    Loc_Matches[Loc_Item] = ((Loc_Keys[Loc_Item] >> 8) - fromDay <= Loc_Span) & ((Loc_Keys[Loc_Item] & stateBits) != 0);
+                }
+
+                /* Loop: Until the matching transactions of the zone are copied */
+                for (Loc_Item = 0; Loc_Item < Loc_End && Loc_Found < maxCount; Loc_Item++)
+                {
+                    /* Check: Transaction matches */
+                    if (Loc_Matches[Loc_Item] != 0)
+                    {
+                        storeDecode(store, Loc_Segment, Loc_First + Loc_Item, &transData[Loc_Found]);
+                        Loc_Found++;
+                    }
+                }
+            }
+        }
+    }
+
+    return Loc_Found;
+}
+
+/*
+ Name: storeTruncate
+ Input: Pointer to Store structure, uint32_t Transaction Number
+ Output: EN_storeError_t Error or No Error
+ Description: 1. This function drops the given transaction and every transaction appended after it, newest first, so
+                 the next transaction appended gets the given sequence number again. It undoes appends that could
+                 not be made durable.
+              2. The dropped transactions give their dictionary entries back, a segment left empty by them is freed
+                 unless it is the one the given number falls in, a sealed segment they leave not full is open again.
+                 The zone maps keep the days and states of the dropped transactions, the date keys filter them out.
+              3. A transaction number at or after the next one drops nothing.
+              4. If the given transaction is in a retired segment will return STORE_NOT_FOUND, else return STORE_OK.
+*/
+EN_storeError_t storeTruncate(ST_transactionStore_t *store, uint32_t transactionSequenceNumber)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_storeError_t Loc_ErrorState = STORE_OK;
+    ST_transactionSegment_t **Loc_Slot;
+
+    /* Check 1: Transaction is before the retained segments */
+    if (transactionSequenceNumber < store->nextSequenceNumber &&
+        (store->segmentCount == 0 ||
+         transactionSequenceNumber < store->directory[store->firstSegment & (store->directoryCapacity - 1)]->firstSequenceNumber))
+    {
+        /* Update error state, Not Found! */
+        Loc_ErrorState = STORE_NOT_FOUND;
+    }
+    /* Check 2: Transaction is retained, or not appended yet */
+    else
+    {
+        /* Loop: Until the given transaction is the next one */
+        while (store->nextSequenceNumber > transactionSequenceNumber)
+        {
+            Loc_Slot = &store->directory[(store->firstSegment + store->segmentCount - 1) & (store->directoryCapacity - 1)];
+
+            /* Check 2.1: Newest segment is empty, drop it */
+            if ((*Loc_Slot)->count == 0)
+            {
+                free(*Loc_Slot);
+                *Loc_Slot = NULL;
+
+                store->segmentCount--;
+            }
+            /* Check 2.2: Drop the newest transaction of the newest segment */
+            else
+            {
+                (*Loc_Slot)->count--;
+                (*Loc_Slot)->state = SEGMENT_OPEN;
+
+                storeDictionaryRelease(&store->cards, (*Loc_Slot)->records[(*Loc_Slot)->count].cardCode);
+                storeDictionaryRelease(&store->terminals, (*Loc_Slot)->records[(*Loc_Slot)->count].terminalCode);
+
+                store->nextSequenceNumber--;
+            }
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: storeRetire
+ Input: Pointer to Store structure
+ Output: EN_storeError_t Error or No Error
+ Description: 1. This function drops the oldest segment as a whole, no transaction is moved.
+              2. Its transactions give their dictionary entries back, entries no other transaction uses are freed.
+              3. If there is no sealed segment to drop will return STORE_EMPTY, else return STORE_OK.
+*/
+EN_storeError_t storeRetire(ST_transactionStore_t *store)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_storeError_t Loc_ErrorState = STORE_OK;
+    ST_transactionSegment_t **Loc_Slot = &store->directory[store->firstSegment & (store->directoryCapacity - 1)];
+
+    /* Check 1: No segments or oldest segment still open */
+    if (store->segmentCount == 0 || (*Loc_Slot)->state != SEGMENT_SEALED)
+    {
+        /* Update error state, Empty! */
+        Loc_ErrorState = STORE_EMPTY;
+    }
+    /* Check 2: Oldest segment is sealed */
+    else
+    {
+        /* Loop: Until all transactions of the segment gave their dictionary entries back */
+        for (uint32_t Loc_Position = 0; Loc_Position < (*Loc_Slot)->count; Loc_Position++)
+        {
+            storeDictionaryRelease(&store->cards, (*Loc_Slot)->records[Loc_Position].cardCode);
+            storeDictionaryRelease(&store->terminals, (*Loc_Slot)->records[Loc_Position].terminalCode);
+        }
+
+        free(*Loc_Slot);
+        *Loc_Slot = NULL;
+
+        store->firstSegment++;
+        store->segmentCount--;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: storeFree
+ Input: Pointer to Store structure
+ Output: void
+ Description: This function releases all segments, the directory and the dictionaries.
+*/
+void storeFree(ST_transactionStore_t *store)
+{
+    /* Loop: Until all retained segments are released */
+    for (uint32_t Loc_Segment = store->firstSegment; Loc_Segment < store->firstSegment + store->segmentCount; Loc_Segment++)
+    {
+        free(store->directory[Loc_Segment & (store->directoryCapacity - 1)]);
+    }
+
+    free(store->directory);
+    free(store->cards.entries);
+    free(store->cards.slots);
+    free(store->cards.references);
+    free(store->cards.freeCodes);
+    free(store->terminals.entries);
+    free(store->terminals.slots);
+    free(store->terminals.references);
+    free(store->terminals.freeCodes);
+    store->directory    = NULL;
+    store->segmentCount = 0;
+    memset(&store->cards, 0, sizeof(ST_storeDictionary_t));
+    memset(&store->terminals, 0, sizeof(ST_storeDictionary_t));
+}
\ No newline at end of file
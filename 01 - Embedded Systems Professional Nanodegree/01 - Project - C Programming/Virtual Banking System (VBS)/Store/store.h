@@ -0,0 +1,104 @@
+#ifndef STORE_H_
+#define STORE_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define STORE_SEGMENT_SIZE			4096		/* Transactions per segment */
+#define STORE_MIN_DIRECTORY			16			/* Must be a power of two */
+#define STORE_ZONE_SIZE				256			/* Transactions per zone map entry, divides STORE_SEGMENT_SIZE */
+#define STORE_SCAN_LANES			16			/* Date keys filtered at once, divides STORE_ZONE_SIZE */
+#define STORE_STATE_BIT(state)		(1 << (state))	/* Bit of a transaction state in a zone map or date key */
+#define STORE_MIN_DICTIONARY		256			/* Dictionary entries at first, a power of two */
+
+typedef enum EN_segmentState_t
+{
+	SEGMENT_OPEN, SEGMENT_SEALED
+}EN_segmentState_t;
+
+typedef struct ST_storeZone_t
+{
+	uint32_t minDay;						/* Earliest transaction day of the zone */
+	uint32_t maxDay;						/* Latest transaction day of the zone */
+	uint32_t stateBits;						/* STORE_STATE_BIT of every transaction state in the zone */
+}ST_storeZone_t;
+
+typedef struct ST_storeCard_t
+{
+	uint8_t cardHolderName[25];
+	uint8_t cardExpirationDate[6];
+	uint8_t primaryAccountNumber[20];		/* Only a PAN that can't be packed, else empty */
+}ST_storeCard_t;
+
+typedef struct ST_storeTerminal_t
+{
+	sint64_t maxTransAmount;
+	uint32_t terminalId;
+	uint8_t transactionDate[11];			/* Only a date its day number doesn't give back, else empty */
+}ST_storeTerminal_t;
+
+typedef struct ST_storeDictionary_t
+{
+	uint8_t *entries;						/* Entries by code, entrySize bytes each */
+	uint32_t *slots;						/* Hash table of code + 1, 0 is a free slot, twice the capacity */
+	uint32_t *references;					/* Records of the retained segments using every code, 0 for a free code */
+	uint32_t *freeCodes;					/* Codes no record uses anymore, given to new entries first */
+	uint32_t entrySize;
+	uint32_t count;							/* Codes given out, free ones included */
+	uint32_t freeCount;
+	uint32_t capacity;
+}ST_storeDictionary_t;
+
+typedef struct ST_storeRecord_t
+{
+	uint64_t panNumber;						/* PAN digits as one number, as in ST_panKey_t */
+	sint64_t transAmount;
+	uint32_t cardCode;						/* Card dictionary entry, name and expiry date */
+	uint32_t terminalCode;					/* Terminal dictionary entry, terminal id and max amount */
+	uint32_t requestId;
+	uint8_t panLength;						/* Number of digits, 0 if the PAN is in the card entry */
+	uint8_t transState;
+	uint16_t reserved;
+}ST_storeRecord_t;
+
+typedef struct ST_transactionSegment_t
+{
+	uint32_t firstSequenceNumber;
+	uint32_t count;
+	EN_segmentState_t state;
+	ST_storeRecord_t records[STORE_SEGMENT_SIZE];	/* Compact transactions, the day is in the date column */
+	uint32_t previousSequenceNumbers[STORE_SEGMENT_SIZE];	/* Previous transaction of the same account, or 0 */
+	uint32_t dateKeys[STORE_SEGMENT_SIZE];	/* Day number << 8 | STORE_STATE_BIT of the state, packed date column */
+	ST_storeZone_t zones[STORE_SEGMENT_SIZE / STORE_ZONE_SIZE];
+}ST_transactionSegment_t;
+
+typedef struct ST_transactionStore_t
+{
+	ST_transactionSegment_t **directory;	/* Ring of segments, oldest at firstSegment */
+	uint32_t directoryCapacity;
+	uint32_t firstSegment;
+	uint32_t segmentCount;
+	uint32_t maxSegments;					/* 0 keeps all segments */
+	uint32_t firstSequenceNumber;
+	uint32_t nextSequenceNumber;
+	ST_storeDictionary_t cards;				/* Cardholder names and expiry dates of the records */
+	ST_storeDictionary_t terminals;			/* Terminals and their max amounts of the records */
+}ST_transactionStore_t;
+
+typedef enum EN_storeError_t
+{
+	STORE_OK, STORE_NOT_FOUND, STORE_NO_MEMORY, STORE_EMPTY
+}EN_storeError_t;
+
+/* Functions' Prototypes */
+EN_storeError_t storeInit(ST_transactionStore_t *store, uint32_t firstSequenceNumber, uint32_t maxSegments);
+EN_storeError_t storeAppend(ST_transactionStore_t *store, ST_transaction_t *transData, uint32_t previousSequenceNumber);
+EN_storeError_t storeGet(ST_transactionStore_t *store, uint32_t transactionSequenceNumber, ST_transaction_t *transData);
+EN_storeError_t storeGetPrevious(ST_transactionStore_t *store, uint32_t transactionSequenceNumber, uint32_t *previousSequenceNumber);
+uint32_t storeFindByDate(ST_transactionStore_t *store, uint32_t fromDay, uint32_t toDay, uint32_t stateBits,
+                         ST_transaction_t *transData, uint32_t maxCount);
+EN_storeError_t storeTruncate(ST_transactionStore_t *store, uint32_t transactionSequenceNumber);
+EN_storeError_t storeRetire(ST_transactionStore_t *store);
+void storeFree(ST_transactionStore_t *store);
+
+#endif /* STORE_H_ */
\ No newline at end of file
@@ -1,228 +1,385 @@
-/* Standard Library */
-#include <stdio.h>
-#include <time.h>
-
-/* Card Module */
-#include "../Card/card.h"
-/* Terminal Module */
-#include "terminal.h"
-
-/*
- Name: getTransactionDate
- Input: Pointer to Terminal Data structure
- Output: EN_terminalError_t Error or No Error
- Description: 1. This function will ask for the transaction data and store it in terminal data.
-			  2. Transaction date is 10 characters string in the format DD/MM/YYYY, e.g 25/06/2022.
-			  3. If the transaction date is NULL, less than 10 characters or wrong format will return WRONG_DATE error,
-				 else return TERMINAL_OK.
-*/
-EN_terminalError_t getTransactionDate(ST_terminalData_t *termData)
-{
-	/* Define local variable to set the error state, No Error */
-	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
-	
-	time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-
-	/* Get Date from system */
-	sprintf(termData->transactionDate, "%02d/%02d/%04d", tm.tm_mday, tm.tm_mon + 1, tm.tm_year + 1900);
-
-	/* Get Transaction Date */
-	printf(" Transaction Date: %s\n", termData->transactionDate);
-
-	/* Check: No transactionDate or transactionDate < 10 or transactionDate > 10 or transactionDate is not in the correct format (DD/MM/YYYY) */
-	if (termData->transactionDate[0] == '\0' || termData->transactionDate[9] == '\0' || termData->transactionDate[10] != '\0' || termData->transactionDate[2] != '/' || termData->transactionDate[5] != '/')
-	{
-		/* Update error state, Wrong Date! */
-		Loc_ErrorState = WRONG_DATE;
-	}
-
-	return Loc_ErrorState;
-}
-
-/*
- Name: isCardExpired
- Input: Card Data structure, Terminal Data structure
- Output: EN_terminalError_t Error or No Error
- Description: 1. This function compares the card expiry date with the transaction date.
-			  2. If the card expiration date is before the transaction date will return EXPIRED_CARD,
-				 else return TERMINAL_OK.
-*/
-EN_terminalError_t isCardExpired(ST_cardData_t *cardData, ST_terminalData_t *termData)
-{
-	/* Define local variable to set the error state, No Error */
-	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
-	/* Define local variable to store month on Card */
-	uint8_t Loc_CardMonth = ((cardData->cardExpirationDate[0] - '0') * 10) + (cardData->cardExpirationDate[1] - '0');
-	/* Define local variable to store year on Card */
-	uint8_t Loc_CardYear  = ((cardData->cardExpirationDate[3] - '0') * 10) + (cardData->cardExpirationDate[4] - '0');
-	/* Define local variable to store month of transaction */
-	uint8_t Loc_TransMonth = ((termData->transactionDate[3] - '0') * 10) + (termData->transactionDate[4] - '0');
-	/* Define local variable to store year of transaction */
-	uint8_t Loc_TransYear  = ((termData->transactionDate[8] - '0') * 10) + (termData->transactionDate[9] - '0');
-
-	/* Check 1: cardYear < transYear */
-	if (Loc_CardYear < Loc_TransYear)
-	{
-		/* Update error state, Expired Card! */
-		Loc_ErrorState = EXPIRED_CARD;
-	}
-	/* Check 2: cardYear >= transYear */
-	else
-	{
-		/* Check 2.1: cardMonth < TransMonth */
-		if (Loc_CardYear == Loc_TransYear && Loc_CardMonth < Loc_TransMonth)
-		{
-			/* Update error state, Expired Card! */
-			Loc_ErrorState = EXPIRED_CARD;
-		}
-	}
-
-	return Loc_ErrorState;
-}
-
-/*
- Name: isValidCardPAN
- Input: Pointer to Card Data structure
- Output: EN_terminalError_t Error or No Error
- Description: 1. This function checks if the PAN is a Luhn number or not.
-			  2. If PAN is not a Luhn number will return INVALID_CARD, else return TERMINAL_OK.
-*/
-EN_terminalError_t isValidCardPAN(ST_cardData_t *cardData)
-{
-	/* Define local variable to set the error state, No Error */
-	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
-	/* Define local variables to check wether Number is Luhn or not  */
-	uint8_t Loc_Counter = 0, Loc_Sum = 0, Loc_Number;
-	uint8_t Loc_Index, Loc_IndexA, Loc_IndexB;
-	uint8_t Loc_reversedPAN[20];
-	
-	/* Loop: Until the end of string */
-	while(cardData->primaryAccountNumber[Loc_Counter] != '\0')
-	{
-		/* Increment Counter */
-		Loc_Counter++;		
-	}
-
-	Loc_IndexA = Loc_Counter - 1;
-
-	/* Loop: Until the PAN is reversed */
-	for(Loc_IndexB = 0; Loc_IndexB < Loc_Counter; Loc_IndexB++, Loc_IndexA--)
-	{
-		Loc_reversedPAN[Loc_IndexB] = cardData->primaryAccountNumber[Loc_IndexA];		
-	}
-
-	/* Loop: Until the end of reversed PAN */
-	for(Loc_Index = 0; Loc_Index < Loc_Counter; Loc_Index++)
-	{
-		Loc_Number = Loc_reversedPAN[Loc_Index] - '0';
-		
-		/* Check 1: Index is divisible by 2 */
-		if(Loc_Index % 2 == 0)
-		{
-			/* Increment Sum */
-			Loc_Sum += Loc_Number;
-		}
-		/* Check 2: Index is not divisible by 2 */
-		else
-		{
-			/* Multiply Number by 2 */
-			Loc_Number *= 2;
-
-			/* Check 2.1: Number > 9 */
-			if(Loc_Number > 9)
-			{
-				/* Add two digits of the Number */			
-				Loc_Number = (Loc_Number / 10) + (Loc_Number % 10);					
-			}
-
-			/* Increment Sum */
-			Loc_Sum += Loc_Number;
-		}
-	}
-
-	/* Check 3: Sum is not divisible by 10 */
-	if(Loc_Sum % 10 != 0)
-	{
-		/* Update error state, Invalid Card! */
-		Loc_ErrorState = INVALID_CARD;
-	}
-
-	return Loc_ErrorState;
-}
-
-/*
- Name: getTransactionAmount
- Input: Pointer to Terminal Data structure
- Output: EN_terminalError_t Error or No Error
- Description: 1. This function asks for the transaction amount and saves it into terminal data.
-			  2. If the transaction amount is less than or equal to 0 will return INVALID_AMOUNT, else
-				 return TERMINAL_OK.
-*/
-EN_terminalError_t getTransactionAmount(ST_terminalData_t *termData)
-{
-	/* Define local variable to set the error state, No Error */
-	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
-
-	/* Get Transaction Amount */
-	printf(" Amount:           ");
-	scanf("%f", &termData->transAmount);
-
-	/* Check: transAmount <= 0 */
-	if (termData->transAmount <= 0)
-	{
-		/* Update error state, Invalid Amount! */
-		Loc_ErrorState = INVALID_AMOUNT;
-	}
-
-	return Loc_ErrorState;
-}
-
-/*
- Name: isBelowMaxAmount
- Input: Pointer to Terminal Data structure
- Output: EN_terminalError_t Error or No Error
- Description: 1. This function compares the transaction amount with the terminal max amount.
-			  2. If the transaction amount is larger than the terminal max amount will return
-				 EXCEED_MAX_AMOUNT, else return TERMINAL_OK.
-*/
-EN_terminalError_t isBelowMaxAmount(ST_terminalData_t *termData)
-{
-	/* Define local variable to set the error state, No Error */
-	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
-
-	/* Check: transAmount > maxTransAmount */
-	if (termData->transAmount > termData->maxTransAmount)
-	{
-		/* Update error state, Exceed Max Amount! */
-		Loc_ErrorState = EXCEED_MAX_AMOUNT;
-	}
-
-	return Loc_ErrorState;
-}
-
-/*
- Name: setMaxAmount
- Input: Pointer to Terminal Data structure
- Output: EN_terminalError_t Error or No Error
- Description: 1. This function sets the maximum allowed amount into terminal data.
-			  2. Transaction max amount is a float number.
-			  3. If transaction max amount less than or equal to 0 will return INVALID_MAX_AMOUNT error,
-				 else return TERMINAL_OK.
-*/
-EN_terminalError_t setMaxAmount(ST_terminalData_t *termData)
-{
-	/* Define local variable to set the error state, No Error */
-	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
-
-	termData->maxTransAmount = TERMINAL_MAX_AMOUNT;
-
-	/* Check: maxTransAmount <= 0 */
-	if (termData->maxTransAmount <= 0)
-	{
-		/* Update error state, Invalid Max Amount! */
-		Loc_ErrorState = INVALID_MAX_AMOUNT;
-	}
-
-	return Loc_ErrorState;
+/* Standard Library */
+#include <stdio.h>
+#include <time.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "terminal.h"
+
+/*
+ Name: getTransactionDate
+ Input: Pointer to Terminal Data structure
+ Output: EN_terminalError_t Error or No Error
+ Description: 1. This function will ask for the transaction data and store it in terminal data.
+			  2. Transaction date is 10 characters string in the format DD/MM/YYYY, e.g 25/06/2022.
+			  3. If the transaction date is NULL, less than 10 characters or wrong format will return WRONG_DATE error,
+				 else return TERMINAL_OK.
+*/
+EN_terminalError_t getTransactionDate(ST_terminalData_t *termData)
+{
+	/* Define local variable to set the error state, No Error */
+	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
+	
+	time_t t = time(NULL);
+    struct tm tm = *localtime(&t);
+
+	/* Get Date from system */
+	sprintf(termData->transactionDate, "%02d/%02d/%04d", tm.tm_mday, tm.tm_mon + 1, tm.tm_year + 1900);
+
+	/* Get Transaction Date */
+	printf(" Transaction Date: %s\n", termData->transactionDate);
+
+	/* Check: No transactionDate or transactionDate < 10 or transactionDate > 10 or transactionDate is not in the correct format (DD/MM/YYYY) */
+	if (termData->transactionDate[0] == '\0' || termData->transactionDate[9] == '\0' || termData->transactionDate[10] != '\0' || termData->transactionDate[2] != '/' || termData->transactionDate[5] != '/')
+	{
+		/* Update error state, Wrong Date! */
+		Loc_ErrorState = WRONG_DATE;
+	}
+
+	return Loc_ErrorState;
+}
+
+/*
+ Name: packTransactionDate
+ Input: Pointer to transaction date string, Pointer to uint32_t Day number
+ Output: EN_terminalError_t Error or No Error
+ Description: 1. This function converts a DD/MM/YYYY transaction date to its day number, counted from 01/03/0000,
+				 so dates are compared and ranged as plain integers.
+			  2. If the date is not in the format DD/MM/YYYY, the day or month is out of range or the year is 0000,
+				 will return WRONG_DATE and TERMINAL_NO_DAY, else return TERMINAL_OK and the day number.
+*/
+EN_terminalError_t packTransactionDate(uint8_t *transactionDate, uint32_t *day)
+{
+	/* Define local variable to set the error state, No Error */
+	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
+	/* Define local variables to store day, month and year of the date, the year starts in March */
+	uint32_t Loc_Day = 0, Loc_Month = 0, Loc_Year = 0, Loc_YearOfEra, Loc_DayOfYear;
+	uint8_t Loc_Index;
+
+	/* Loop: Until the end of the date, all characters but the two slashes are digits */
+	for (Loc_Index = 0; Loc_Index < 10; Loc_Index++)
+	{
+		/* Check 1: Slash position */
+		if (Loc_Index == 2 || Loc_Index == 5)
+		{
+			/* Check 1.1: Not a slash */
+			if (transactionDate[Loc_Index] != '/')
+			{
+				/* Update error state, Wrong Date! */
+				Loc_ErrorState = WRONG_DATE;
+			}
+		}
+		/* Check 2: Not a digit */
+		else if (transactionDate[Loc_Index] < '0' || transactionDate[Loc_Index] > '9')
+		{
+			/* Update error state, Wrong Date! */
+			Loc_ErrorState = WRONG_DATE;
+		}
+		/* Check 3: Digit of the day, month or year */
+		else if (Loc_Index < 2)
+		{
+			Loc_Day = Loc_Day * 10 + (transactionDate[Loc_Index] - '0');
+		}
+		else if (Loc_Index < 5)
+		{
+			Loc_Month = Loc_Month * 10 + (transactionDate[Loc_Index] - '0');
+		}
+		else
+		{
+			Loc_Year = Loc_Year * 10 + (transactionDate[Loc_Index] - '0');
+		}
+
+		/* Check 4: String ended early */
+		if (transactionDate[Loc_Index] == '\0')
+		{
+			/* Update error state, Wrong Date! */
+			Loc_ErrorState = WRONG_DATE;
+			Loc_Index      = 10;
+		}
+	}
+
+	/* Check 5: Characters left, or day, month or year out of range */
+	if (Loc_ErrorState == WRONG_DATE || transactionDate[10] != '\0' || Loc_Day < 1 || Loc_Day > 31 || Loc_Month < 1 || Loc_Month > 12 ||
+		Loc_Year == 0)
+	{
+		/* Update error state, Wrong Date! */
+		Loc_ErrorState = WRONG_DATE;
+		*day = TERMINAL_NO_DAY;
+	}
+	/* Check 6: Date is valid, count days in 400 year eras of 146097 days */
+	else
+	{
+		Loc_Year      = Loc_Year + 400 - (Loc_Month <= 2);
+		Loc_YearOfEra = Loc_Year % 400;
+		Loc_DayOfYear = (153 * (Loc_Month + ((Loc_Month > 2) ? -3 : 9)) + 2) / 5 + Loc_Day - 1;
+
+		*day = (Loc_Year / 400 - 1) * 146097 + Loc_YearOfEra * 365 + Loc_YearOfEra / 4 - Loc_YearOfEra / 100 + Loc_DayOfYear + 1;
+	}
+
+	return Loc_ErrorState;
+}
+
+/*
+ Name: unpackTransactionDate
+ Input: uint32_t Day number, Pointer to transaction date string
+ Output: void
+ Description: This function converts a day number of packTransactionDate back to its DD/MM/YYYY date, the string
+			  must hold 11 characters. TERMINAL_NO_DAY, or a day after 31/12/9999, gives an empty string.
+*/
+void unpackTransactionDate(uint32_t day, uint8_t *transactionDate)
+{
+	/* Define local variables to split the day number into 400 year eras of 146097 days, the year starts in March */
+	uint32_t Loc_Days = day - 1, Loc_DayOfEra, Loc_YearOfEra, Loc_DayOfYear, Loc_MonthIndex;
+	uint32_t Loc_Day, Loc_Month, Loc_Year;
+
+	Loc_DayOfEra   = Loc_Days % 146097;
+	Loc_YearOfEra  = (Loc_DayOfEra - Loc_DayOfEra / 1460 + Loc_DayOfEra / 36524 - Loc_DayOfEra / 146096) / 365;
+	Loc_DayOfYear  = Loc_DayOfEra - (365 * Loc_YearOfEra + Loc_YearOfEra / 4 - Loc_YearOfEra / 100);
+	Loc_MonthIndex = (5 * Loc_DayOfYear + 2) / 153;
+	Loc_Day        = Loc_DayOfYear - (153 * Loc_MonthIndex + 2) / 5 + 1;
+	Loc_Month      = (Loc_MonthIndex < 10) ? Loc_MonthIndex + 3 : Loc_MonthIndex - 9;
+	Loc_Year       = (Loc_Days / 146097) * 400 + Loc_YearOfEra + (Loc_Month <= 2);
+
+	/* Check 1: No day, or the year needs more than four digits */
+	if (day == TERMINAL_NO_DAY || Loc_Year > 9999)
+	{
+		transactionDate[0] = '\0';
+	}
+	/* Check 2: Write the date */
+	else
+	{
+		snprintf(transactionDate, 11, "%02u/%02u/%04u", Loc_Day, Loc_Month, Loc_Year);
+	}
+}
+
+/*
+ Name: isCardExpired
+ Input: Card Data structure, Terminal Data structure
+ Output: EN_terminalError_t Error or No Error
+ Description: 1. This function compares the card expiry date with the transaction date.
+			  2. If the card expiration date is before the transaction date will return EXPIRED_CARD,
+				 else return TERMINAL_OK.
+*/
+EN_terminalError_t isCardExpired(ST_cardData_t *cardData, ST_terminalData_t *termData)
+{
+	/* Define local variable to set the error state, No Error */
+	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
+	/* Define local variable to store month on Card */
+	uint8_t Loc_CardMonth = ((cardData->cardExpirationDate[0] - '0') * 10) + (cardData->cardExpirationDate[1] - '0');
+	/* Define local variable to store year on Card */
+	uint8_t Loc_CardYear  = ((cardData->cardExpirationDate[3] - '0') * 10) + (cardData->cardExpirationDate[4] - '0');
+	/* Define local variable to store month of transaction */
+	uint8_t Loc_TransMonth = ((termData->transactionDate[3] - '0') * 10) + (termData->transactionDate[4] - '0');
+	/* Define local variable to store year of transaction */
+	uint8_t Loc_TransYear  = ((termData->transactionDate[8] - '0') * 10) + (termData->transactionDate[9] - '0');
+
+	/* Check 1: cardYear < transYear */
+	if (Loc_CardYear < Loc_TransYear)
+	{
+		/* Update error state, Expired Card! */
+		Loc_ErrorState = EXPIRED_CARD;
+	}
+	/* Check 2: cardYear >= transYear */
+	else
+	{
+		/* Check 2.1: cardMonth < TransMonth */
+		if (Loc_CardYear == Loc_TransYear && Loc_CardMonth < Loc_TransMonth)
+		{
+			/* Update error state, Expired Card! */
+			Loc_ErrorState = EXPIRED_CARD;
+		}
+	}
+
+	return Loc_ErrorState;
+}
+
+/*
+ Name: isValidCardPAN
+ Input: Pointer to Card Data structure
+ Output: EN_terminalError_t Error or No Error
+ Description: 1. This function checks if the PAN is a Luhn number or not.
+			  2. If PAN is not a Luhn number will return INVALID_CARD, else return TERMINAL_OK.
+*/
+EN_terminalError_t isValidCardPAN(ST_cardData_t *cardData)
+{
+	/* Define local variable to set the error state, No Error */
+	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
+	/* Define local variables to check wether Number is Luhn or not  */
+	uint8_t Loc_Counter = 0, Loc_Sum = 0, Loc_Number;
+	uint8_t Loc_Index, Loc_IndexA, Loc_IndexB;
+	uint8_t Loc_reversedPAN[20];
+	
+	/* Loop: Until the end of string */
+	while(cardData->primaryAccountNumber[Loc_Counter] != '\0')
+	{
+		/* Increment Counter */
+		Loc_Counter++;		
+	}
+
+	Loc_IndexA = Loc_Counter - 1;
+
+	/* Loop: Until the PAN is reversed */
+	for(Loc_IndexB = 0; Loc_IndexB < Loc_Counter; Loc_IndexB++, Loc_IndexA--)
+	{
+		Loc_reversedPAN[Loc_IndexB] = cardData->primaryAccountNumber[Loc_IndexA];		
+	}
+
+	/* Loop: Until the end of reversed PAN */
+	for(Loc_Index = 0; Loc_Index < Loc_Counter; Loc_Index++)
+	{
+		Loc_Number = Loc_reversedPAN[Loc_Index] - '0';
+		
+		/* Check 1: Index is divisible by 2 */
+		if(Loc_Index % 2 == 0)
+		{
+			/* Increment Sum */
+			Loc_Sum += Loc_Number;
+		}
+		/* Check 2: Index is not divisible by 2 */
+		else
+		{
+			/* Multiply Number by 2 */
+			Loc_Number *= 2;
+
+			/* Check 2.1: Number > 9 */
+			if(Loc_Number > 9)
+			{
+				/* Add two digits of the Number */			
+				Loc_Number = (Loc_Number / 10) + (Loc_Number % 10);					
+			}
+
+			/* Increment Sum */
+			Loc_Sum += Loc_Number;
+		}
+	}
+
+	/* Check 3: Sum is not divisible by 10 */
+	if(Loc_Sum % 10 != 0)
+	{
+		/* Update error state, Invalid Card! */
+		Loc_ErrorState = INVALID_CARD;
+	}
+
+	return Loc_ErrorState;
+}
+
+/*
+ Name: parseAmount
+ Input: Pointer to amount string, Pointer to sint64_t Amount
+ Output: EN_terminalError_t Error or No Error
+ Description: Static Function to convert an amount like "1250" or "1250.5" or "1250.75" to cents without going through
+			  a float, so the amount is exact. Anything else, or more than 15 digits before the point, is INVALID_AMOUNT.
+*/
+static EN_terminalError_t parseAmount(uint8_t *text, sint64_t *amount)
+{
+	/* Define local variable to set the error state, No Error */
+	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
+	sint64_t Loc_Units = 0, Loc_Cents = 0, Loc_Scale = TERMINAL_MINOR_UNITS;
+	uint8_t Loc_Digits = 0;
+
+	/* Loop: Until the end of the whole units */
+	for (; *text >= '0' && *text <= '9' && Loc_Digits <= 15; text++, Loc_Digits++)
+	{
+		Loc_Units = Loc_Units * 10 + (*text - '0');
+	}
+
+	/* Check: Fraction follows */
+	if (*text == '.')
+	{
+		/* Loop: Until the end of the cents */
+		for (text++; *text >= '0' && *text <= '9' && Loc_Scale > 1; text++)
+		{
+			Loc_Scale /= 10;
+			Loc_Cents += (*text - '0') * Loc_Scale;
+		}
+	}
+
+	/* Check: No digits, too many digits or characters left */
+	if (Loc_Digits == 0 || Loc_Digits > 15 || *text != '\0')
+	{
+		/* Update error state, Invalid Amount! */
+		Loc_ErrorState = INVALID_AMOUNT;
+	}
+
+	*amount = Loc_Units * TERMINAL_MINOR_UNITS + Loc_Cents;
+
+	return Loc_ErrorState;
+}
+
+/*
+ Name: getTransactionAmount
+ Input: Pointer to Terminal Data structure
+ Output: EN_terminalError_t Error or No Error
+ Description: 1. This function asks for the transaction amount and saves it into terminal data in cents.
+			  2. If the transaction amount is not a number with at most two decimals, or is less than or equal to 0
+				 will return INVALID_AMOUNT, else return TERMINAL_OK.
+*/
+EN_terminalError_t getTransactionAmount(ST_terminalData_t *termData)
+{
+	/* Define local variable to set the error state, No Error */
+	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
+	uint8_t Loc_Amount[24] = {0};
+
+	/* Get Transaction Amount */
+	printf(" Amount:           ");
+	scanf("%23s", Loc_Amount);
+
+	/* Check: Amount is not a number, or transAmount <= 0 */
+	if (parseAmount(Loc_Amount, &termData->transAmount) == INVALID_AMOUNT || termData->transAmount <= 0)
+	{
+		/* Update error state, Invalid Amount! */
+		Loc_ErrorState = INVALID_AMOUNT;
+	}
+
+	return Loc_ErrorState;
+}
+
+/*
+ Name: isBelowMaxAmount
+ Input: Pointer to Terminal Data structure
+ Output: EN_terminalError_t Error or No Error
+ Description: 1. This function compares the transaction amount with the terminal max amount.
+			  2. If the transaction amount is larger than the terminal max amount will return
+				 EXCEED_MAX_AMOUNT, else return TERMINAL_OK.
+*/
+EN_terminalError_t isBelowMaxAmount(ST_terminalData_t *termData)
+{
+	/* Define local variable to set the error state, No Error */
+	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
+
+	/* Check: transAmount > maxTransAmount */
+	if (termData->transAmount > termData->maxTransAmount)
+	{
+		/* Update error state, Exceed Max Amount! */
+		Loc_ErrorState = EXCEED_MAX_AMOUNT;
+	}
+
+	return Loc_ErrorState;
+}
+
+/*
+ Name: setMaxAmount
+ Input: Pointer to Terminal Data structure
+ Output: EN_terminalError_t Error or No Error
+ Description: 1. This function sets the maximum allowed amount into terminal data.
+			  2. Transaction max amount is in cents.
+			  3. If transaction max amount less than or equal to 0 will return INVALID_MAX_AMOUNT error,
+				 else return TERMINAL_OK.
+*/
+EN_terminalError_t setMaxAmount(ST_terminalData_t *termData)
+{
+	/* Define local variable to set the error state, No Error */
+	EN_terminalError_t Loc_ErrorState = TERMINAL_OK;
+
+	termData->maxTransAmount = TERMINAL_MAX_AMOUNT;
+
+	/* Check: maxTransAmount <= 0 */
+	if (termData->maxTransAmount <= 0)
+	{
+		/* Update error state, Invalid Max Amount! */
+		Loc_ErrorState = INVALID_MAX_AMOUNT;
+	}
+
+	return Loc_ErrorState;
 }
\ No newline at end of file
@@ -1,29 +1,36 @@
-#ifndef TERMINAL_H_
-#define TERMINAL_H_
-
-/* Library Module */
-#include "../Library/standard_types.h"
-
-#define TERMINAL_MAX_AMOUNT		5000
-
-typedef struct ST_terminalData_t
-{
-	float32_t transAmount;
-	float32_t maxTransAmount;
-	uint8_t transactionDate[11];
-}ST_terminalData_t;
-
-typedef enum EN_terminalError_t
-{
-	TERMINAL_OK, WRONG_DATE, EXPIRED_CARD, INVALID_CARD, INVALID_AMOUNT, EXCEED_MAX_AMOUNT, INVALID_MAX_AMOUNT
-}EN_terminalError_t;
-
-/* Functions' Prototypes */
-EN_terminalError_t getTransactionDate(ST_terminalData_t *termData);
-EN_terminalError_t isCardExpired(ST_cardData_t *cardData, ST_terminalData_t *termData);
-EN_terminalError_t isValidCardPAN(ST_cardData_t *cardData);
-EN_terminalError_t getTransactionAmount(ST_terminalData_t *termData);
-EN_terminalError_t isBelowMaxAmount(ST_terminalData_t *termData);
-EN_terminalError_t setMaxAmount(ST_terminalData_t *termData);
-
+#ifndef TERMINAL_H_
+#define TERMINAL_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define TERMINAL_MINOR_UNITS	100				/* Cents per currency unit, all amounts are in cents */
+#define TERMINAL_MAX_AMOUNT		(5000 * TERMINAL_MINOR_UNITS)
+#define TERMINAL_NO_DAY			0				/* Day number of a wrong date, every valid date is after it */
+#define TERMINAL_NO_REQUEST		0				/* Request id of a transaction the server must not deduplicate */
+
+typedef struct ST_terminalData_t
+{
+	sint64_t transAmount;
+	sint64_t maxTransAmount;
+	uint8_t transactionDate[11];
+	uint32_t terminalId;
+	uint32_t requestId;							/* Numbered by the terminal, a retry keeps the number of its request */
+}ST_terminalData_t;
+
+typedef enum EN_terminalError_t
+{
+	TERMINAL_OK, WRONG_DATE, EXPIRED_CARD, INVALID_CARD, INVALID_AMOUNT, EXCEED_MAX_AMOUNT, INVALID_MAX_AMOUNT
+}EN_terminalError_t;
+
+/* Functions' Prototypes */
+EN_terminalError_t getTransactionDate(ST_terminalData_t *termData);
+EN_terminalError_t packTransactionDate(uint8_t *transactionDate, uint32_t *day);
+void unpackTransactionDate(uint32_t day, uint8_t *transactionDate);
+EN_terminalError_t isCardExpired(ST_cardData_t *cardData, ST_terminalData_t *termData);
+EN_terminalError_t isValidCardPAN(ST_cardData_t *cardData);
+EN_terminalError_t getTransactionAmount(ST_terminalData_t *termData);
+EN_terminalError_t isBelowMaxAmount(ST_terminalData_t *termData);
+EN_terminalError_t setMaxAmount(ST_terminalData_t *termData);
+
 #endif /* TERMINAL_H_ */
\ No newline at end of file
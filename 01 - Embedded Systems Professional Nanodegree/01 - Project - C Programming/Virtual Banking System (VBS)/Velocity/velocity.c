@@ -0,0 +1,219 @@
+/* Standard Library */
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Card Module */
+#include "../Card/card.h"
+/* Terminal Module */
+#include "../Terminal/terminal.h"
+/* Server Module */
+#include "../Server/server.h"
+/* Velocity Module */
+#include "velocity.h"
+
+/* Seconds of every bucket of a window, its seconds divided by VELOCITY_BUCKETS */
+static const uint32_t Glb_BucketSeconds[VELOCITY_WINDOWS] = {VELOCITY_MINUTE_SECONDS / VELOCITY_BUCKETS,
+                                                             VELOCITY_HOUR_SECONDS / VELOCITY_BUCKETS,
+                                                             VELOCITY_DAY_SECONDS / VELOCITY_BUCKETS};
+
+/*
+ Name: velocityAdvance
+ Input: Pointer to Velocity Ring, uint32_t Bucket number
+ Output: void
+ Description: Static Function to slide a ring forward until its newest bucket is the given one. The buckets that
+              fall out of the window are taken off the totals and cleared, at most VELOCITY_BUCKETS of them, a ring
+              idle for a whole window is cleared at once. A bucket older than the newest one moves nothing.
+*/
+static void velocityAdvance(ST_velocityRing_t *ring, uint32_t bucket)
+{
+    uint32_t Loc_Slot;
+
+    /* Check 1: Every bucket of the ring is out of the window */
+    if (bucket > ring->head && bucket - ring->head >= VELOCITY_BUCKETS)
+    {
+        memset(ring->counts, 0, sizeof(ring->counts));
+        memset(ring->amounts, 0, sizeof(ring->amounts));
+        ring->count  = 0;
+        ring->amount = 0;
+        ring->head   = bucket;
+    }
+    /* Check 2: Some buckets are still in the window */
+    else
+    {
+        /* Loop: Until the given bucket is the newest one, the oldest bucket is reused for the next one */
+        while (ring->head < bucket)
+        {
+            ring->head++;
+            Loc_Slot = ring->head % VELOCITY_BUCKETS;
+
+            ring->count             -= ring->counts[Loc_Slot];
+            ring->amount            -= ring->amounts[Loc_Slot];
+            ring->counts[Loc_Slot]   = 0;
+            ring->amounts[Loc_Slot]  = 0;
+        }
+    }
+}
+
+/*
+ Name: velocityInit
+ Input: Pointer to Velocity Table, uint32_t Account records reserved
+ Output: EN_velocityError_t Error or No Error
+ Description: 1. This function allocates the chunk directory of a velocity table for the reserved account records,
+                 every chunk unused. The rings of an account are allocated with its chunk on the first approval of
+                 one of its accounts, they take the same memory whatever the number of transactions.
+              2. If there is no memory will return VELOCITY_FAILED, else will return VELOCITY_OK.
+*/
+EN_velocityError_t velocityInit(ST_velocityTable_t *table, uint32_t capacity)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_velocityError_t Loc_ErrorState = VELOCITY_OK;
+
+    table->chunkCount = (capacity + VELOCITY_CHUNK_ACCOUNTS - 1) / VELOCITY_CHUNK_ACCOUNTS;
+    table->chunks     = calloc(table->chunkCount, sizeof(ST_velocityAccount_t *));
+
+    /* Check: No memory for the chunk directory */
+    if (table->chunks == NULL)
+    {
+        /* Update error state, Velocity Failed! */
+        Loc_ErrorState = VELOCITY_FAILED;
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: velocityAccount
+ Input: Pointer to Velocity Table, uint32_t Account record
+ Output: Pointer to Velocity Account
+ Description: 1. This function returns the rings of an account record, its chunk is allocated if it is unused.
+              2. It is thread safe, threads holding the locks of different accounts of the same unused chunk may
+                 allocate it at once, the first one installed is kept.
+              3. If there is no memory for the chunk will return NULL.
+*/
+ST_velocityAccount_t *velocityAccount(ST_velocityTable_t *table, uint32_t record)
+{
+    ST_velocityAccount_t **Loc_Slot = &table->chunks[record / VELOCITY_CHUNK_ACCOUNTS];
+    ST_velocityAccount_t *Loc_Chunk = __atomic_load_n(Loc_Slot, __ATOMIC_ACQUIRE);
+    ST_velocityAccount_t *Loc_Installed = NULL;
+
+    /* Check 1: Chunk is unused */
+    if (Loc_Chunk == NULL)
+    {
+        Loc_Chunk = calloc(VELOCITY_CHUNK_ACCOUNTS, sizeof(ST_velocityAccount_t));
+
+        /* Check 1.1: Another thread installed the chunk first, use its chunk */
+        if (Loc_Chunk != NULL &&
+            !__atomic_compare_exchange_n(Loc_Slot, &Loc_Installed, Loc_Chunk, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            free(Loc_Chunk);
+            Loc_Chunk = Loc_Installed;
+        }
+    }
+
+    return (Loc_Chunk == NULL) ? NULL : &Loc_Chunk[record % VELOCITY_CHUNK_ACCOUNTS];
+}
+
+/*
+ Name: velocityNow
+ Input: void
+ Output: uint32_t Seconds
+ Description: This function returns the monotonic time in seconds, the clock of the velocity windows.
+*/
+uint32_t velocityNow(void)
+{
+    struct timespec Loc_Time;
+
+    clock_gettime(CLOCK_MONOTONIC, &Loc_Time);
+
+    return (uint32_t)Loc_Time.tv_sec;
+}
+
+/*
+ Name: velocityCheck
+ Input: Pointer to Velocity Account, Pointer to Velocity Limits, uint32_t Seconds, sint64_t Amount in cents
+ Output: EN_velocityError_t Error or No Error
+ Description: 1. This function slides every window of an account to the given time and checks a transaction of
+                 the given amount against the limits, a limit of 0 is no limit. A window covers its last
+                 VELOCITY_BUCKETS buckets, so it ends at the given time and starts up to one bucket less than its
+                 seconds before. The check costs the same whatever the number of transactions of the account.
+              2. The caller holds the lock of the account.
+              3. If the transaction would take the approved transactions or cents of a window over its limit will
+                 return VELOCITY_EXCEEDED, else will return VELOCITY_OK.
+*/
+EN_velocityError_t velocityCheck(ST_velocityAccount_t *account, ST_velocityLimits_t *limits, uint32_t now, sint64_t amount)
+{
+    /* Define local variable to set the error state, No Error */
+    EN_velocityError_t Loc_ErrorState = VELOCITY_OK;
+    ST_velocityRing_t *Loc_Ring;
+
+    /* Loop: Until all windows are checked */
+    for (uint32_t Loc_Window = 0; Loc_Window < VELOCITY_WINDOWS; Loc_Window++)
+    {
+        Loc_Ring = &account->rings[Loc_Window];
+        velocityAdvance(Loc_Ring, now / Glb_BucketSeconds[Loc_Window]);
+
+        /* Check: Transaction takes the count or the amount of the window over its limit */
+        if ((limits->maxCount[Loc_Window] != 0 && Loc_Ring->count + 1 > limits->maxCount[Loc_Window]) ||
+            (limits->maxAmount[Loc_Window] != 0 && Loc_Ring->amount + amount > limits->maxAmount[Loc_Window]))
+        {
+            /* Update error state, Velocity Exceeded! */
+            Loc_ErrorState = VELOCITY_EXCEEDED;
+        }
+    }
+
+    return Loc_ErrorState;
+}
+
+/*
+ Name: velocityAdd
+ Input: Pointer to Velocity Account, uint32_t Seconds, sint64_t Amount in cents
+ Output: void
+ Description: 1. This function adds an approved transaction of the given amount to the bucket of the given time in
+                 every window of an account. A time already out of a window is not added to it.
+              2. The caller holds the lock of the account.
+*/
+void velocityAdd(ST_velocityAccount_t *account, uint32_t now, sint64_t amount)
+{
+    ST_velocityRing_t *Loc_Ring;
+    uint32_t Loc_Bucket;
+
+    /* Loop: Until the transaction is in all windows */
+    for (uint32_t Loc_Window = 0; Loc_Window < VELOCITY_WINDOWS; Loc_Window++)
+    {
+        Loc_Ring   = &account->rings[Loc_Window];
+        Loc_Bucket = now / Glb_BucketSeconds[Loc_Window];
+        velocityAdvance(Loc_Ring, Loc_Bucket);
+
+        /* Check: Bucket is still in the window, a later time may have slid it */
+        if (Loc_Ring->head - Loc_Bucket < VELOCITY_BUCKETS)
+        {
+            Loc_Ring->counts[Loc_Bucket % VELOCITY_BUCKETS]++;
+            Loc_Ring->amounts[Loc_Bucket % VELOCITY_BUCKETS] += amount;
+            Loc_Ring->count++;
+            Loc_Ring->amount += amount;
+        }
+    }
+}
+
+/*
+ Name: velocityFree
+ Input: Pointer to Velocity Table
+ Output: void
+ Description: This function releases the used chunks and the chunk directory of a velocity table.
+*/
+void velocityFree(ST_velocityTable_t *table)
+{
+    /* Check: Directory is allocated */
+    if (table->chunks != NULL)
+    {
+        /* Loop: Until all chunks are released */
+        for (uint32_t Loc_Chunk = 0; Loc_Chunk < table->chunkCount; Loc_Chunk++)
+        {
+            free(table->chunks[Loc_Chunk]);
+        }
+    }
+
+    free(table->chunks);
+    table->chunks = NULL;
+}
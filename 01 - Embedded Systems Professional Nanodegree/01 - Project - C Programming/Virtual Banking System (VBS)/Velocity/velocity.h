@@ -0,0 +1,46 @@
+#ifndef VELOCITY_H_
+#define VELOCITY_H_
+
+/* Library Module */
+#include "../Library/standard_types.h"
+
+#define VELOCITY_BUCKETS			12			/* Buckets of the ring of a window, the window slides by one bucket */
+#define VELOCITY_MINUTE_SECONDS		60			/* Seconds of every window, a multiple of VELOCITY_BUCKETS */
+#define VELOCITY_HOUR_SECONDS		3600
+#define VELOCITY_DAY_SECONDS		86400
+#define VELOCITY_CHUNK_ACCOUNTS		4096		/* Accounts of a chunk of a table, allocated on the first approval of one of them */
+
+typedef enum EN_velocityError_t
+{
+	VELOCITY_OK, VELOCITY_EXCEEDED, VELOCITY_FAILED
+}EN_velocityError_t;
+
+typedef struct ST_velocityRing_t
+{
+	uint32_t head;							/* Number of the newest bucket, seconds divided by the bucket width */
+	uint32_t count;							/* Approved transactions of all buckets */
+	sint64_t amount;						/* Cents approved in all buckets */
+	uint32_t counts[VELOCITY_BUCKETS];		/* Approved transactions of every bucket, at its number modulo VELOCITY_BUCKETS */
+	sint64_t amounts[VELOCITY_BUCKETS];		/* Cents approved in every bucket */
+}ST_velocityRing_t;
+
+typedef struct ST_velocityAccount_t
+{
+	ST_velocityRing_t rings[VELOCITY_WINDOWS];
+}ST_velocityAccount_t;
+
+typedef struct ST_velocityTable_t
+{
+	ST_velocityAccount_t **chunks;			/* Chunk of every VELOCITY_CHUNK_ACCOUNTS account records, NULL until used */
+	uint32_t chunkCount;
+}ST_velocityTable_t;
+
+/* Functions' Prototypes */
+EN_velocityError_t velocityInit(ST_velocityTable_t *table, uint32_t capacity);
+ST_velocityAccount_t *velocityAccount(ST_velocityTable_t *table, uint32_t record);
+uint32_t velocityNow(void);
+EN_velocityError_t velocityCheck(ST_velocityAccount_t *account, ST_velocityLimits_t *limits, uint32_t now, sint64_t amount);
+void velocityAdd(ST_velocityAccount_t *account, uint32_t now, sint64_t amount);
+void velocityFree(ST_velocityTable_t *table);
+
+#endif /* VELOCITY_H_ */
@@ -1,18 +1,18 @@
-#include <stdio.h>
-#include "Application/app.h"
-
-#include "Card/card.h"
-#include "Terminal/terminal.h"
-
-int main(void)
-{
-    appStart();
-
-    // ST_cardData_t card = {" ", "4728459258966333", " "};
-    
-    // isValidCardPAN(&card) == TERMINAL_OK ? printf("Luhn Number\n") : printf("Not Luhn Number\n");
-
-
-
-    return 0;
+#include <stdio.h>
+#include "Application/app.h"
+
+#include "Card/card.h"
+#include "Terminal/terminal.h"
+
+int main(void)
+{
+    appStart();
+
+    // ST_cardData_t card = {" ", "4728459258966333", " "};
+    
+    // isValidCardPAN(&card) == TERMINAL_OK ? printf("Luhn Number\n") : printf("Not Luhn Number\n");
+
+
+
+    return 0;
 }
\ No newline at end of file